@@ -15,6 +15,7 @@
 #include <boost/preprocessor/seq/transform.hpp>
 
 #include <cstdint>
+#include <iostream>
 #include <string>
 #include <vector>
 
@@ -24,6 +25,14 @@ namespace opossum {
 
 namespace hana = boost::hana;
 
+// NULL is only represented in AllTypeVariant. Segments of data tables do not store it, but ReferenceSegments return
+// it for NULL_ROW_ID, e.g., for the rows of an outer join without a join partner.
+// For AllTypeVariant to be comparable and printable, NULL is equal to itself and smaller than all other values.
+struct NullValue {};
+inline bool operator==(const NullValue&, const NullValue&) { return true; }
+inline bool operator<(const NullValue&, const NullValue&) { return false; }
+inline std::ostream& operator<<(std::ostream& stream, const NullValue&) { return stream << "NULL"; }
+
 namespace detail {
 
 #define EXPAND_TO_HANA_TYPE(s, data, elem) boost::hana::type_c<elem>
@@ -57,8 +66,11 @@ struct to_pair {
 // Converts the tuples into pairs
 static constexpr auto data_types = hana::transform(data_types_as_tuples, to_pair{});  // NOLINT
 
+// The types an AllTypeVariant can hold: NullValue first, so that a default-constructed variant is NULL
+static constexpr auto variant_types = hana::prepend(types, hana::type_c<NullValue>);
+
 // Converts tuple to mpl vector
-using TypesAsMplVector = decltype(hana::to<hana::ext::boost::mpl::vector_tag>(types));
+using TypesAsMplVector = decltype(hana::to<hana::ext::boost::mpl::vector_tag>(variant_types));
 
 // Creates boost::variant from mpl vector
 using AllTypeVariant = typename boost::make_variant_over<detail::TypesAsMplVector>::type;
@@ -70,6 +82,10 @@ static constexpr auto data_types = detail::data_types;
 
 using AllTypeVariant = detail::AllTypeVariant;
 
+static const auto NULL_VALUE = AllTypeVariant{NullValue{}};
+
+inline bool variant_is_null(const AllTypeVariant& value) { return value.which() == 0; }
+
 /**
  * @defgroup Macros for explicitly instantiating template classes
  *
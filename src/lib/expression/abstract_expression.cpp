@@ -0,0 +1,21 @@
+#include "abstract_expression.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace opossum {
+
+AbstractExpression::AbstractExpression(const std::vector<std::shared_ptr<AbstractExpression>>& arguments)
+    : _arguments{arguments} {}
+
+const std::vector<std::shared_ptr<AbstractExpression>>& AbstractExpression::arguments() const { return _arguments; }
+
+bool AbstractExpression::_is_infix() const { return false; }
+
+std::string AbstractExpression::_argument_description(const AbstractExpression& argument, const Table& table) {
+  if (argument._is_infix()) return "(" + argument.description(table) + ")";
+  return argument.description(table);
+}
+
+}  // namespace opossum
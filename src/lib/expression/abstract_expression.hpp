@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace opossum {
+
+class Table;
+
+// AbstractExpression is the abstract super class of the nodes of an expression tree, which computes a value for each
+// row of a table, e.g., a * (1 - b). Expressions refer to columns by their ColumnID, so they are bound to a table only
+// when they are evaluated by the ExpressionEvaluator.
+class AbstractExpression {
+ public:
+  explicit AbstractExpression(const std::vector<std::shared_ptr<AbstractExpression>>& arguments);
+  virtual ~AbstractExpression() = default;
+
+  // the data type of the values that the expression computes for the rows of the table, e.g., "int"
+  virtual std::string data_type(const Table& table) const = 0;
+
+  // a readable form of the expression, which Projection uses as column name, e.g., "a * (1 - b)"
+  virtual std::string description(const Table& table) const = 0;
+
+  const std::vector<std::shared_ptr<AbstractExpression>>& arguments() const;
+
+ protected:
+  // whether the description puts an operator between the arguments, e.g., "a + b"
+  virtual bool _is_infix() const;
+
+  // the description of an argument, in parentheses if it is infix
+  static std::string _argument_description(const AbstractExpression& argument, const Table& table);
+
+  const std::vector<std::shared_ptr<AbstractExpression>> _arguments;
+};
+
+}  // namespace opossum
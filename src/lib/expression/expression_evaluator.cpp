@@ -0,0 +1,330 @@
+#include "expression_evaluator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "expressions.hpp"
+#include "resolve_type.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+template <typename T>
+const T& value_at(const ExpressionResult<T>& result, const size_t row) {
+  return result.values[result.is_literal() ? 0 : row];
+}
+
+template <typename T>
+bool is_null_at(const ExpressionResult<T>& result, const size_t row) {
+  return !result.is_null.empty() && result.is_null[result.is_literal() ? 0 : row];
+}
+
+// the number of rows of a result computed from both arguments, 1 if both are literals
+template <typename Left, typename Right>
+size_t result_size(const ExpressionResult<Left>& left, const ExpressionResult<Right>& right) {
+  return left.is_literal() ? right.values.size() : left.values.size();
+}
+
+// a row of the result is NULL if it is NULL in either argument
+template <typename Left, typename Right>
+std::vector<uint8_t> merge_nulls(const ExpressionResult<Left>& left, const ExpressionResult<Right>& right,
+                                 const size_t size) {
+  if (left.is_null.empty() && right.is_null.empty()) return {};
+  auto is_null = std::vector<uint8_t>(size, 0);
+  const auto add_nulls = [&](const std::vector<uint8_t>& argument_is_null) {
+    if (argument_is_null.empty()) return;
+    if (argument_is_null.size() == 1 && size != 1) {
+      if (argument_is_null.front()) std::fill(is_null.begin(), is_null.end(), 1);
+      return;
+    }
+    for (auto row = size_t{0}; row < size; ++row) is_null[row] |= argument_is_null[row];
+  };
+  add_nulls(left.is_null);
+  add_nulls(right.is_null);
+  return is_null;
+}
+
+// applies functor(left value, right value) to all rows. There is one loop per combination of literals, so that the
+// loops only access the values and can be vectorized.
+template <typename Result, typename Left, typename Right, typename Functor>
+ExpressionResult<Result> apply_binary(const ExpressionResult<Left>& left, const ExpressionResult<Right>& right,
+                                      const Functor& functor) {
+  const auto size = result_size(left, right);
+  auto result = ExpressionResult<Result>{};
+  result.values.resize(size);
+  auto* const output = result.values.data();
+  const auto* const left_values = left.values.data();
+  const auto* const right_values = right.values.data();
+  if (left.is_literal() && !right.is_literal()) {
+    const auto& left_value = left_values[0];
+    for (auto row = size_t{0}; row < size; ++row) output[row] = functor(left_value, right_values[row]);
+  } else if (right.is_literal() && !left.is_literal()) {
+    const auto& right_value = right_values[0];
+    for (auto row = size_t{0}; row < size; ++row) output[row] = functor(left_values[row], right_value);
+  } else {
+    for (auto row = size_t{0}; row < size; ++row) output[row] = functor(left_values[row], right_values[row]);
+  }
+  result.is_null = merge_nulls(left, right, size);
+  return result;
+}
+
+template <typename T, typename Source>
+T convert_value(const Source& value) {
+  if constexpr (std::is_arithmetic_v<T> == std::is_arithmetic_v<Source>) {
+    return static_cast<T>(value);
+  } else {
+    return type_cast<T>(AllTypeVariant{value});
+  }
+}
+
+}  // namespace
+
+ExpressionEvaluator::ExpressionEvaluator(const Table& table, const ChunkID chunk_id)
+    : _table{table}, _chunk{table.get_chunk(chunk_id)} {}
+
+std::shared_ptr<BaseSegment> ExpressionEvaluator::evaluate_to_segment(const AbstractExpression& expression,
+                                                                      std::vector<uint8_t>& is_null) const {
+  auto segment = std::shared_ptr<BaseSegment>{};
+  resolve_data_type(expression.data_type(_table), [&](auto type) {
+    using ColumnType = typename decltype(type)::type;
+    auto result = evaluate<ColumnType>(expression);
+    const auto chunk_size = static_cast<size_t>(_chunk.size());
+    if (result.is_literal() && chunk_size != 1) {
+      result.values.resize(chunk_size, result.values.front());
+      if (!result.is_null.empty()) result.is_null.resize(chunk_size, result.is_null.front());
+    }
+    if (std::find(result.is_null.cbegin(), result.is_null.cend(), uint8_t{1}) == result.is_null.cend()) {
+      result.is_null.clear();
+    }
+    is_null = std::move(result.is_null);
+    segment = std::make_shared<ValueSegment<ColumnType>>(std::move(result.values));
+  });
+  return segment;
+}
+
+template <typename T>
+ExpressionResult<T> ExpressionEvaluator::evaluate(const AbstractExpression& expression) const {
+  if (const auto column_expression = dynamic_cast<const ColumnExpression*>(&expression)) {
+    const auto& segment = *_chunk.get_segment(column_expression->column_id());
+    auto result = ExpressionResult<T>{};
+    result.values.resize(_chunk.size());
+    materialize_values(segment, ChunkOffsetRange{0, _chunk.size()}, result.values.data());
+    if (const auto* const positions = nullable_positions(segment)) {
+      for (auto chunk_offset = size_t{0}; chunk_offset < positions->size(); ++chunk_offset) {
+        if ((*positions)[chunk_offset] == NULL_ROW_ID) {
+          result.is_null.resize(positions->size(), 0);
+          result.is_null[chunk_offset] = 1;
+        }
+      }
+    }
+    return result;
+  }
+
+  if (const auto value_expression = dynamic_cast<const ValueExpression*>(&expression)) {
+    const auto& value = value_expression->value();
+    if (variant_is_null(value)) return ExpressionResult<T>{{T{}}, {1}};
+    return ExpressionResult<T>{{type_cast<T>(value)}, {}};
+  }
+
+  if (dynamic_cast<const ArithmeticExpression*>(&expression)) return _evaluate_arithmetic<T>(expression);
+  if (dynamic_cast<const CaseExpression*>(&expression)) return _evaluate_case<T>(expression);
+  if (dynamic_cast<const CastExpression*>(&expression)) return _evaluate_as<T>(*expression.arguments().front());
+
+  if constexpr (std::is_same_v<T, int32_t>) {
+    if (dynamic_cast<const ComparisonExpression*>(&expression)) return _evaluate_comparison(expression);
+    if (dynamic_cast<const LogicalExpression*>(&expression)) return _evaluate_logical(expression);
+  }
+  Fail("Unsupported expression");
+  return {};
+}
+
+template <typename T>
+ExpressionResult<T> ExpressionEvaluator::_evaluate_arithmetic(const AbstractExpression& expression) const {
+  if constexpr (std::is_arithmetic_v<T>) {
+    // both arguments are widened to the type of the result first
+    const auto left = _evaluate_as<T>(*expression.arguments()[0]);
+    const auto right = _evaluate_as<T>(*expression.arguments()[1]);
+
+    switch (static_cast<const ArithmeticExpression&>(expression).arithmetic_operator()) {
+      case ArithmeticOperator::Addition:
+        return apply_binary<T>(left, right, std::plus<T>{});
+      case ArithmeticOperator::Subtraction:
+        return apply_binary<T>(left, right, std::minus<T>{});
+      case ArithmeticOperator::Multiplication:
+        return apply_binary<T>(left, right, std::multiplies<T>{});
+      case ArithmeticOperator::Division:
+      case ArithmeticOperator::Modulo:
+        break;
+    }
+
+    const auto is_division = static_cast<const ArithmeticExpression&>(expression).arithmetic_operator() ==
+                             ArithmeticOperator::Division;
+    auto result = apply_binary<T>(left, right, [&](const T& left_value, const T& right_value) {
+      if (right_value == T{0}) return T{0};
+      if (is_division) return static_cast<T>(left_value / right_value);
+      if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(std::fmod(left_value, right_value));
+      } else {
+        return static_cast<T>(left_value % right_value);
+      }
+    });
+
+    // division by zero yields NULL
+    for (auto row = size_t{0}; row < result.values.size(); ++row) {
+      if (value_at(right, row) != T{0}) continue;
+      result.is_null.resize(result.values.size(), 0);
+      result.is_null[row] = 1;
+    }
+    return result;
+  }
+  Fail("Arithmetic expressions need numeric arguments");
+  return {};
+}
+
+ExpressionResult<int32_t> ExpressionEvaluator::_evaluate_comparison(const AbstractExpression& expression) const {
+  const auto& left_expression = *expression.arguments()[0];
+  const auto& right_expression = *expression.arguments()[1];
+  auto result = ExpressionResult<int32_t>{};
+  resolve_data_type(left_expression.data_type(_table), [&](auto left_type) {
+    using LeftType = typename decltype(left_type)::type;
+    resolve_data_type(right_expression.data_type(_table), [&](auto right_type) {
+      using RightType = typename decltype(right_type)::type;
+      if constexpr (std::is_arithmetic_v<LeftType> == std::is_arithmetic_v<RightType>) {
+        // numeric arguments are compared in their common type
+        using CommonType = std::common_type_t<LeftType, RightType>;
+        const auto left = _evaluate_as<CommonType>(left_expression);
+        const auto right = _evaluate_as<CommonType>(right_expression);
+
+        const auto compare = [&](const auto& comparator) {
+          result = apply_binary<int32_t>(left, right, [&](const CommonType& left_value, const CommonType& right_value) {
+            return static_cast<int32_t>(comparator(left_value, right_value));
+          });
+        };
+        switch (static_cast<const ComparisonExpression&>(expression).scan_type()) {
+          case ScanType::OpEquals:
+            compare(std::equal_to<CommonType>{});
+            break;
+          case ScanType::OpNotEquals:
+            compare(std::not_equal_to<CommonType>{});
+            break;
+          case ScanType::OpLessThan:
+            compare(std::less<CommonType>{});
+            break;
+          case ScanType::OpLessThanEquals:
+            compare(std::less_equal<CommonType>{});
+            break;
+          case ScanType::OpGreaterThan:
+            compare(std::greater<CommonType>{});
+            break;
+          case ScanType::OpGreaterThanEquals:
+            compare(std::greater_equal<CommonType>{});
+            break;
+          default:
+            Fail("Unsupported comparison");
+        }
+      } else {
+        Fail("Strings can only be compared with strings");
+      }
+    });
+  });
+  return result;
+}
+
+ExpressionResult<int32_t> ExpressionEvaluator::_evaluate_logical(const AbstractExpression& expression) const {
+  const auto left = evaluate<int32_t>(*expression.arguments()[0]);
+  const auto right = evaluate<int32_t>(*expression.arguments()[1]);
+  const auto is_and = static_cast<const LogicalExpression&>(expression).logical_operator() == LogicalOperator::And;
+
+  if (left.is_null.empty() && right.is_null.empty()) {
+    if (is_and) {
+      return apply_binary<int32_t>(left, right, [](const int32_t left_value, const int32_t right_value) {
+        return static_cast<int32_t>(left_value != 0 && right_value != 0);
+      });
+    }
+    return apply_binary<int32_t>(left, right, [](const int32_t left_value, const int32_t right_value) {
+      return static_cast<int32_t>(left_value != 0 || right_value != 0);
+    });
+  }
+
+  // with NULLs, AND is false if either argument is false, and OR is true if either argument is true. Otherwise, the
+  // result is NULL if either argument is NULL.
+  const auto size = result_size(left, right);
+  auto result = ExpressionResult<int32_t>{std::vector<int32_t>(size), std::vector<uint8_t>(size, 0)};
+  const auto decisive_value = is_and ? 0 : 1;
+  for (auto row = size_t{0}; row < size; ++row) {
+    const auto left_is_null = is_null_at(left, row);
+    const auto right_is_null = is_null_at(right, row);
+    const auto left_value = static_cast<int32_t>(value_at(left, row) != 0);
+    const auto right_value = static_cast<int32_t>(value_at(right, row) != 0);
+    if ((!left_is_null && left_value == decisive_value) || (!right_is_null && right_value == decisive_value)) {
+      result.values[row] = decisive_value;
+    } else if (left_is_null || right_is_null) {
+      result.is_null[row] = 1;
+    } else {
+      result.values[row] = 1 - decisive_value;
+    }
+  }
+  return result;
+}
+
+template <typename T>
+ExpressionResult<T> ExpressionEvaluator::_evaluate_case(const AbstractExpression& expression) const {
+  const auto& case_expression = static_cast<const CaseExpression&>(expression);
+  const auto condition = evaluate<int32_t>(*expression.arguments()[0]);
+  const auto then = _evaluate_as<T>(*expression.arguments()[1]);
+  const auto otherwise = case_expression.has_otherwise() ? _evaluate_as<T>(*expression.arguments()[2])
+                                                         : ExpressionResult<T>{{T{}}, {1}};
+
+  const auto size = std::max({condition.values.size(), then.values.size(), otherwise.values.size()});
+  auto result = ExpressionResult<T>{};
+  result.values.resize(size);
+  const auto may_be_null = !then.is_null.empty() || !otherwise.is_null.empty();
+  if (may_be_null) result.is_null.resize(size);
+  for (auto row = size_t{0}; row < size; ++row) {
+    // a NULL condition counts as false
+    const auto& branch = !is_null_at(condition, row) && value_at(condition, row) != 0 ? then : otherwise;
+    result.values[row] = value_at(branch, row);
+    if (may_be_null) result.is_null[row] = is_null_at(branch, row);
+  }
+  return result;
+}
+
+template <typename T>
+ExpressionResult<T> ExpressionEvaluator::_evaluate_as(const AbstractExpression& expression) const {
+  auto result = ExpressionResult<T>{};
+  resolve_data_type(expression.data_type(_table), [&](auto type) {
+    using SourceType = typename decltype(type)::type;
+    if constexpr (std::is_same_v<T, SourceType>) {
+      result = evaluate<T>(expression);
+    } else {
+      const auto source = evaluate<SourceType>(expression);
+      result.values.resize(source.values.size());
+      for (auto row = size_t{0}; row < source.values.size(); ++row) {
+        // NULLs keep the default value, their values in the source may not be convertible
+        if (!is_null_at(source, row)) result.values[row] = convert_value<T>(source.values[row]);
+      }
+      result.is_null = source.is_null;
+    }
+  });
+  return result;
+}
+
+#define EXPLICITLY_INSTANTIATE_EVALUATE(r, data, type) \
+  template ExpressionResult<type> ExpressionEvaluator::evaluate<type>(const AbstractExpression&) const;
+
+BOOST_PP_SEQ_FOR_EACH(EXPLICITLY_INSTANTIATE_EVALUATE, _, data_types_macro)
+
+}  // namespace opossum
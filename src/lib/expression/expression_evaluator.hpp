@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "abstract_expression.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseSegment;
+class Chunk;
+
+// the values of an expression for the rows of a chunk, or a single value for all of them (e.g., of a literal)
+template <typename T>
+struct ExpressionResult {
+  bool is_literal() const { return values.size() == 1; }
+
+  std::vector<T> values;
+  // 1 for the rows whose value is NULL, empty if no value is NULL
+  std::vector<uint8_t> is_null;
+};
+
+// Evaluates expressions for all rows of a chunk. The evaluation works column-at-a-time: every node of the expression
+// tree is computed for the whole chunk in a typed vector before its parent node is computed, so that the loops over
+// the rows do not dispatch on types or nodes and can be vectorized by the compiler. The values of columns are read in
+// bulk with materialize_values(), and literals are not expanded to the size of the chunk.
+class ExpressionEvaluator {
+ public:
+  ExpressionEvaluator(const Table& table, const ChunkID chunk_id);
+
+  // returns a ValueSegment with the values of the expression for all rows of the chunk. The rows for which is_null is
+  // set to 1 are NULL, their values in the segment are undefined. If no row is NULL, is_null is empty.
+  std::shared_ptr<BaseSegment> evaluate_to_segment(const AbstractExpression& expression,
+                                                   std::vector<uint8_t>& is_null) const;
+
+  template <typename T>
+  ExpressionResult<T> evaluate(const AbstractExpression& expression) const;
+
+ protected:
+  template <typename T>
+  ExpressionResult<T> _evaluate_arithmetic(const AbstractExpression& expression) const;
+
+  ExpressionResult<int32_t> _evaluate_comparison(const AbstractExpression& expression) const;
+
+  ExpressionResult<int32_t> _evaluate_logical(const AbstractExpression& expression) const;
+
+  template <typename T>
+  ExpressionResult<T> _evaluate_case(const AbstractExpression& expression) const;
+
+  // evaluates the expression in its own data type and converts the result to T
+  template <typename T>
+  ExpressionResult<T> _evaluate_as(const AbstractExpression& expression) const;
+
+  const Table& _table;
+  const Chunk& _chunk;
+};
+
+}  // namespace opossum
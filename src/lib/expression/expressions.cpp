@@ -0,0 +1,203 @@
+#include "expressions.hpp"
+
+#include <boost/hana/for_each.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/table.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// the numeric data types in the order in which arguments are widened
+const auto NUMERIC_DATA_TYPES = std::vector<std::string>{"int", "long", "float", "double"};
+
+std::string widened_numeric_type(const std::string& left, const std::string& right) {
+  const auto left_position = std::find(NUMERIC_DATA_TYPES.cbegin(), NUMERIC_DATA_TYPES.cend(), left);
+  const auto right_position = std::find(NUMERIC_DATA_TYPES.cbegin(), NUMERIC_DATA_TYPES.cend(), right);
+  Assert(left_position != NUMERIC_DATA_TYPES.cend() && right_position != NUMERIC_DATA_TYPES.cend(),
+         "Arguments have to be numeric");
+  return *std::max(left_position, right_position);
+}
+
+bool is_string_or_numeric_pair(const std::string& left, const std::string& right) {
+  return (left == "string") == (right == "string");
+}
+
+}  // namespace
+
+ColumnExpression::ColumnExpression(const ColumnID column_id) : AbstractExpression({}), _column_id{column_id} {}
+
+std::string ColumnExpression::data_type(const Table& table) const {
+  Assert(_column_id < table.column_count(), "Column does not exist");
+  return table.column_type(_column_id);
+}
+
+std::string ColumnExpression::description(const Table& table) const {
+  Assert(_column_id < table.column_count(), "Column does not exist");
+  return table.column_name(_column_id);
+}
+
+ColumnID ColumnExpression::column_id() const { return _column_id; }
+
+ValueExpression::ValueExpression(const AllTypeVariant& value) : AbstractExpression({}), _value{value} {}
+
+std::string ValueExpression::data_type(const Table&) const {
+  auto type_string = std::string{"int"};
+  hana::for_each(data_types, [&](auto type) {
+    using ValueType = typename decltype(+hana::second(type))::type;
+    if (_value.type() == typeid(ValueType)) type_string = hana::first(type);
+  });
+  return type_string;
+}
+
+std::string ValueExpression::description(const Table&) const {
+  if (variant_is_null(_value)) return "NULL";
+  if (_value.type() == typeid(std::string)) return "'" + type_cast<std::string>(_value) + "'";
+  return type_cast<std::string>(_value);
+}
+
+const AllTypeVariant& ValueExpression::value() const { return _value; }
+
+ArithmeticExpression::ArithmeticExpression(const ArithmeticOperator arithmetic_operator,
+                                           const std::shared_ptr<AbstractExpression>& left,
+                                           const std::shared_ptr<AbstractExpression>& right)
+    : AbstractExpression({left, right}), _arithmetic_operator{arithmetic_operator} {}
+
+std::string ArithmeticExpression::data_type(const Table& table) const {
+  return widened_numeric_type(_arguments[0]->data_type(table), _arguments[1]->data_type(table));
+}
+
+std::string ArithmeticExpression::description(const Table& table) const {
+  auto operator_string = std::string{};
+  switch (_arithmetic_operator) {
+    case ArithmeticOperator::Addition:
+      operator_string = " + ";
+      break;
+    case ArithmeticOperator::Subtraction:
+      operator_string = " - ";
+      break;
+    case ArithmeticOperator::Multiplication:
+      operator_string = " * ";
+      break;
+    case ArithmeticOperator::Division:
+      operator_string = " / ";
+      break;
+    case ArithmeticOperator::Modulo:
+      operator_string = " % ";
+      break;
+  }
+  return _argument_description(*_arguments[0], table) + operator_string + _argument_description(*_arguments[1], table);
+}
+
+ArithmeticOperator ArithmeticExpression::arithmetic_operator() const { return _arithmetic_operator; }
+
+bool ArithmeticExpression::_is_infix() const { return true; }
+
+ComparisonExpression::ComparisonExpression(const ScanType scan_type, const std::shared_ptr<AbstractExpression>& left,
+                                           const std::shared_ptr<AbstractExpression>& right)
+    : AbstractExpression({left, right}), _scan_type{scan_type} {
+  Assert(scan_type <= ScanType::OpGreaterThanEquals, "Comparisons only support the six comparison operators");
+}
+
+std::string ComparisonExpression::data_type(const Table& table) const {
+  Assert(is_string_or_numeric_pair(_arguments[0]->data_type(table), _arguments[1]->data_type(table)),
+         "Strings can only be compared with strings");
+  return "int";
+}
+
+std::string ComparisonExpression::description(const Table& table) const {
+  auto operator_string = std::string{};
+  switch (_scan_type) {
+    case ScanType::OpEquals:
+      operator_string = " = ";
+      break;
+    case ScanType::OpNotEquals:
+      operator_string = " != ";
+      break;
+    case ScanType::OpLessThan:
+      operator_string = " < ";
+      break;
+    case ScanType::OpLessThanEquals:
+      operator_string = " <= ";
+      break;
+    case ScanType::OpGreaterThan:
+      operator_string = " > ";
+      break;
+    case ScanType::OpGreaterThanEquals:
+      operator_string = " >= ";
+      break;
+    default:
+      Fail("Unsupported comparison");
+  }
+  return _argument_description(*_arguments[0], table) + operator_string + _argument_description(*_arguments[1], table);
+}
+
+ScanType ComparisonExpression::scan_type() const { return _scan_type; }
+
+bool ComparisonExpression::_is_infix() const { return true; }
+
+LogicalExpression::LogicalExpression(const LogicalOperator logical_operator,
+                                     const std::shared_ptr<AbstractExpression>& left,
+                                     const std::shared_ptr<AbstractExpression>& right)
+    : AbstractExpression({left, right}), _logical_operator{logical_operator} {}
+
+std::string LogicalExpression::data_type(const Table& table) const {
+  Assert(_arguments[0]->data_type(table) == "int" && _arguments[1]->data_type(table) == "int",
+         "Logical operators need int arguments");
+  return "int";
+}
+
+std::string LogicalExpression::description(const Table& table) const {
+  const auto operator_string = _logical_operator == LogicalOperator::And ? " AND " : " OR ";
+  return _argument_description(*_arguments[0], table) + operator_string + _argument_description(*_arguments[1], table);
+}
+
+LogicalOperator LogicalExpression::logical_operator() const { return _logical_operator; }
+
+bool LogicalExpression::_is_infix() const { return true; }
+
+CaseExpression::CaseExpression(const std::shared_ptr<AbstractExpression>& condition,
+                               const std::shared_ptr<AbstractExpression>& then,
+                               const std::shared_ptr<AbstractExpression>& otherwise)
+    : AbstractExpression(otherwise ? std::vector<std::shared_ptr<AbstractExpression>>{condition, then, otherwise}
+                                   : std::vector<std::shared_ptr<AbstractExpression>>{condition, then}) {}
+
+std::string CaseExpression::data_type(const Table& table) const {
+  Assert(_arguments[0]->data_type(table) == "int", "The condition of a CASE has to be an int");
+  const auto then_type = _arguments[1]->data_type(table);
+  if (!has_otherwise()) return then_type;
+
+  const auto otherwise_type = _arguments[2]->data_type(table);
+  Assert(is_string_or_numeric_pair(then_type, otherwise_type), "The branches of a CASE have incompatible types");
+  return then_type == "string" ? then_type : widened_numeric_type(then_type, otherwise_type);
+}
+
+std::string CaseExpression::description(const Table& table) const {
+  auto description = "CASE WHEN " + _arguments[0]->description(table) + " THEN " + _arguments[1]->description(table);
+  if (has_otherwise()) description += " ELSE " + _arguments[2]->description(table);
+  return description + " END";
+}
+
+bool CaseExpression::has_otherwise() const { return _arguments.size() == 3; }
+
+CastExpression::CastExpression(const std::shared_ptr<AbstractExpression>& argument, const std::string& data_type)
+    : AbstractExpression({argument}), _data_type{data_type} {
+  auto is_data_type = false;
+  hana::for_each(data_types, [&](auto type) { is_data_type |= std::string{hana::first(type)} == data_type; });
+  Assert(is_data_type, "Unknown data type " + data_type);
+}
+
+std::string CastExpression::data_type(const Table&) const { return _data_type; }
+
+std::string CastExpression::description(const Table& table) const {
+  return "CAST(" + _arguments[0]->description(table) + " AS " + _data_type + ")";
+}
+
+}  // namespace opossum
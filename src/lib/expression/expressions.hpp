@@ -0,0 +1,117 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "abstract_expression.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// the values of a column of the table
+class ColumnExpression : public AbstractExpression {
+ public:
+  explicit ColumnExpression(const ColumnID column_id);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  ColumnID column_id() const;
+
+ protected:
+  const ColumnID _column_id;
+};
+
+// the same value for every row. A NULL without a type is an int, CastExpression gives it another type.
+class ValueExpression : public AbstractExpression {
+ public:
+  explicit ValueExpression(const AllTypeVariant& value);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  const AllTypeVariant& value() const;
+
+ protected:
+  const AllTypeVariant _value;
+};
+
+// the arithmetic operator applied to two numeric arguments, in the wider of their types (int < long < float < double)
+class ArithmeticExpression : public AbstractExpression {
+ public:
+  ArithmeticExpression(const ArithmeticOperator arithmetic_operator, const std::shared_ptr<AbstractExpression>& left,
+                       const std::shared_ptr<AbstractExpression>& right);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  ArithmeticOperator arithmetic_operator() const;
+
+ protected:
+  bool _is_infix() const override;
+
+  const ArithmeticOperator _arithmetic_operator;
+};
+
+// compares two numeric or two string arguments with one of the ScanTypes from OpEquals to OpGreaterThanEquals. As
+// there is no boolean type, the result is an int that is 1 for true and 0 for false.
+class ComparisonExpression : public AbstractExpression {
+ public:
+  ComparisonExpression(const ScanType scan_type, const std::shared_ptr<AbstractExpression>& left,
+                       const std::shared_ptr<AbstractExpression>& right);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  ScanType scan_type() const;
+
+ protected:
+  bool _is_infix() const override;
+
+  const ScanType _scan_type;
+};
+
+// combines two int arguments, which are true if they are not 0, to an int that is 1 for true and 0 for false
+class LogicalExpression : public AbstractExpression {
+ public:
+  LogicalExpression(const LogicalOperator logical_operator, const std::shared_ptr<AbstractExpression>& left,
+                    const std::shared_ptr<AbstractExpression>& right);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  LogicalOperator logical_operator() const;
+
+ protected:
+  bool _is_infix() const override;
+
+  const LogicalOperator _logical_operator;
+};
+
+// CASE WHEN condition THEN then ELSE otherwise END, where a NULL condition counts as false. Without otherwise, the
+// ELSE branch is NULL. Numeric branches are widened like the arguments of an ArithmeticExpression.
+class CaseExpression : public AbstractExpression {
+ public:
+  CaseExpression(const std::shared_ptr<AbstractExpression>& condition, const std::shared_ptr<AbstractExpression>& then,
+                 const std::shared_ptr<AbstractExpression>& otherwise = nullptr);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  bool has_otherwise() const;
+};
+
+// converts the values of the argument to the data type. Strings that do not hold a number cannot be cast to one.
+class CastExpression : public AbstractExpression {
+ public:
+  CastExpression(const std::shared_ptr<AbstractExpression>& argument, const std::string& data_type);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+ protected:
+  const std::string _data_type;
+};
+
+}  // namespace opossum
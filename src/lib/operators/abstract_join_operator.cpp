@@ -0,0 +1,66 @@
+#include "abstract_join_operator.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+AbstractJoinOperator::AbstractJoinOperator(const std::shared_ptr<const AbstractOperator> left,
+                                           const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                                           const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type)
+    : AbstractOperator(left, right), _mode{mode}, _column_ids{column_ids}, _scan_type{scan_type} {
+  Assert(scan_type == ScanType::OpEquals || scan_type == ScanType::OpNotEquals || scan_type == ScanType::OpLessThan ||
+             scan_type == ScanType::OpLessThanEquals || scan_type == ScanType::OpGreaterThan ||
+             scan_type == ScanType::OpGreaterThanEquals,
+         "Columns can only be joined with =, !=, <, <=, > and >=");
+}
+
+JoinMode AbstractJoinOperator::mode() const { return _mode; }
+
+const std::pair<ColumnID, ColumnID>& AbstractJoinOperator::column_ids() const { return _column_ids; }
+
+ScanType AbstractJoinOperator::scan_type() const { return _scan_type; }
+
+std::shared_ptr<Table> AbstractJoinOperator::_build_output(
+    const std::vector<JoinedPositions>& joined_positions) const {
+  const auto left_table = _input_table_left();
+  const auto right_table = _input_table_right();
+  const auto outputs_right_columns = _mode == JoinMode::Inner || _mode == JoinMode::Left;
+
+  auto output = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < left_table->column_count(); ++column_id) {
+    output->add_column_definition(left_table->column_name(column_id), left_table->column_type(column_id));
+  }
+  if (outputs_right_columns) {
+    for (auto column_id = ColumnID{0}; column_id < right_table->column_count(); ++column_id) {
+      output->add_column_definition(right_table->column_name(column_id), right_table->column_type(column_id));
+    }
+  }
+
+  const auto add_chunk = [&](const JoinedPositions& positions) {
+    Chunk chunk;
+    _add_reference_segments(left_table, positions.left, chunk);
+    if (outputs_right_columns) _add_reference_segments(right_table, positions.right, chunk);
+    output->emplace_chunk(std::move(chunk));
+  };
+
+  for (const auto& positions : joined_positions) {
+    if (positions.left->empty()) continue;
+    DebugAssert(!outputs_right_columns || positions.right->size() == positions.left->size(),
+                "Both sides need a position for every row");
+    add_chunk(positions);
+  }
+
+  // a table always holds at least one chunk, if nothing qualifies, it is an empty one with all columns
+  if (output->row_count() == 0) {
+    add_chunk(JoinedPositions{std::make_shared<PosList>(), std::make_shared<PosList>()});
+  }
+
+  return output;
+}
+
+}  // namespace opossum
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// AbstractJoinOperator is the super class of all joins, which join two tables on the comparison of a column of the
+// left input with a column of the right input. The output holds the columns of the left input followed by those of
+// the right input (semi and anti joins only output the left columns). All of them are ReferenceSegments into the
+// data tables, also if an input is a reference table itself.
+class AbstractJoinOperator : public AbstractOperator {
+ public:
+  AbstractJoinOperator(const std::shared_ptr<const AbstractOperator> left,
+                       const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                       const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type);
+
+  JoinMode mode() const;
+
+  // the ids of the joined columns in the left and in the right input
+  const std::pair<ColumnID, ColumnID>& column_ids() const;
+
+  // the comparison of the left with the right column
+  ScanType scan_type() const;
+
+ protected:
+  // the rows of one output chunk as positions into the left and right input tables. Rows of a left outer join without
+  // a join partner are paired with NULL_ROW_ID. Semi and anti joins do not set the right positions.
+  struct JoinedPositions {
+    std::shared_ptr<PosList> left;
+    std::shared_ptr<PosList> right;
+  };
+
+  // creates the output table with one chunk per non-empty JoinedPositions
+  std::shared_ptr<Table> _build_output(const std::vector<JoinedPositions>& joined_positions) const;
+
+  const JoinMode _mode;
+  const std::pair<ColumnID, ColumnID> _column_ids;
+  const ScanType _scan_type;
+};
+
+// materializes the join keys of the column chunk by chunk in parallel and calls functor(chunk_id, values, positions)
+// for every non-empty chunk. If the column may contain NULLs, positions is the PosList of the chunk's
+// ReferenceSegment and the rows for which it holds NULL_ROW_ID are NULL. Otherwise, it is nullptr.
+template <typename T, typename Functor>
+void materialize_join_column(const Table& table, const ColumnID column_id, const Functor& functor) {
+  std::vector<std::function<void()>> jobs;
+  for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto& chunk = table.get_chunk(chunk_id);
+    if (chunk.column_count() == 0 || chunk.size() == 0) continue;
+
+    jobs.emplace_back([&table, &functor, column_id, chunk_id]() {
+      const auto& chunk = table.get_chunk(chunk_id);
+      const auto segment = chunk.get_segment(column_id);
+      std::vector<T> values(chunk.size());
+      materialize_values(*segment, ChunkOffsetRange{0, chunk.size()}, values.data());
+
+      functor(chunk_id, values, nullable_positions(*segment));
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+}
+
+}  // namespace opossum
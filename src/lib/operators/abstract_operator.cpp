@@ -1,10 +1,14 @@
 #include "abstract_operator.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
 
@@ -22,8 +26,106 @@ std::shared_ptr<const Table> AbstractOperator::get_output() const {
   return _output;
 }
 
+void AbstractOperator::set_output_row_limit(const size_t row_count) {
+  Assert(!_output, "The row limit has to be set before the operator is executed");
+  _output_row_limit = row_count;
+}
+
+std::optional<size_t> AbstractOperator::output_row_limit() const { return _output_row_limit; }
+
 std::shared_ptr<const Table> AbstractOperator::_input_table_left() const { return _input_left->get_output(); }
 
 std::shared_ptr<const Table> AbstractOperator::_input_table_right() const { return _input_right->get_output(); }
 
+void AbstractOperator::_add_reference_segments(const std::shared_ptr<const Table>& input_table,
+                                               const std::shared_ptr<const PosList>& positions, Chunk& chunk) {
+  const auto chunk_count = input_table->chunk_count();
+  const auto is_reference_table = [&]() {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto& input_chunk = input_table->get_chunk(chunk_id);
+      if (input_chunk.column_count() == 0) continue;
+      return std::dynamic_pointer_cast<const ReferenceSegment>(input_chunk.get_segment(ColumnID{0})) != nullptr;
+    }
+    return false;
+  }();
+
+  if (!is_reference_table) {
+    for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+      chunk.add_segment(std::make_shared<ReferenceSegment>(input_table, column_id, positions));
+    }
+    return;
+  }
+
+  // columns whose segments share the PosList in every chunk (e.g., all columns of a scan result) share the resolved
+  // positions as well
+  std::map<std::vector<const PosList*>, std::shared_ptr<const PosList>> resolved_positions;
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    auto segments = std::vector<std::shared_ptr<const ReferenceSegment>>(chunk_count);
+    auto pos_lists = std::vector<const PosList*>(chunk_count);
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto& input_chunk = input_table->get_chunk(chunk_id);
+      if (input_chunk.column_count() == 0) continue;
+      segments[chunk_id] = std::dynamic_pointer_cast<const ReferenceSegment>(input_chunk.get_segment(column_id));
+      Assert(segments[chunk_id], "All segments of a reference table have to be ReferenceSegments");
+      pos_lists[chunk_id] = segments[chunk_id]->pos_list().get();
+    }
+
+    auto& column_positions = resolved_positions[pos_lists];
+    if (!column_positions) {
+      auto referenced_positions = std::make_shared<PosList>();
+      referenced_positions->reserve(positions->size());
+      for (const auto& row_id : *positions) {
+        if (row_id == NULL_ROW_ID) {
+          referenced_positions->push_back(NULL_ROW_ID);
+        } else {
+          referenced_positions->push_back((*pos_lists[row_id.chunk_id])[row_id.chunk_offset]);
+        }
+      }
+      column_positions = referenced_positions;
+    }
+
+    // all segments of a column reference the same column of the same table
+    const auto& segment =
+        **std::find_if(segments.cbegin(), segments.cend(), [](const auto& candidate) { return candidate != nullptr; });
+    chunk.add_segment(std::make_shared<ReferenceSegment>(segment.referenced_table(), segment.referenced_column_id(),
+                                                         column_positions));
+  }
+}
+
+bool AbstractOperator::_has_uniform_positions(const Table& input_table) {
+  std::shared_ptr<const Table> referenced_table;
+  for (auto chunk_id = ChunkID{0}; chunk_id < input_table.chunk_count(); ++chunk_id) {
+    const auto& chunk = input_table.get_chunk(chunk_id);
+    if (chunk.column_count() == 0) continue;
+    const auto first_segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk.get_segment(ColumnID{0}));
+    if (!first_segment) return false;
+    if (!referenced_table) referenced_table = first_segment->referenced_table();
+
+    for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+      const auto segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk.get_segment(column_id));
+      if (!segment || segment->referenced_table() != referenced_table) return false;
+      if (segment == first_segment) continue;
+
+      const auto& rows = segment->referenced_rows();
+      const auto& first_rows = first_segment->referenced_rows();
+      const auto& bitmap = segment->referenced_bitmap();
+      const auto& first_bitmap = first_segment->referenced_bitmap();
+      if (rows || first_rows) {
+        if (!rows || !first_rows || rows->chunk_id != first_rows->chunk_id ||
+            rows->offsets.begin != first_rows->offsets.begin || rows->offsets.end != first_rows->offsets.end) {
+          return false;
+        }
+      } else if (bitmap || first_bitmap) {
+        if (!bitmap || !first_bitmap || bitmap->chunk_id != first_bitmap->chunk_id ||
+            bitmap->offsets != first_bitmap->offsets) {
+          return false;
+        }
+      } else if (segment->pos_list() != first_segment->pos_list()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 }  // namespace opossum
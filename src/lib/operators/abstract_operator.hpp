@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -8,6 +9,7 @@
 
 namespace opossum {
 
+class Chunk;
 class Table;
 
 // AbstractOperator is the abstract super class for all operators.
@@ -45,6 +47,13 @@ class AbstractOperator : private Noncopyable {
   std::shared_ptr<const AbstractOperator> input_left() const;
   std::shared_ptr<const AbstractOperator> input_right() const;
 
+  // tells the operator that its consumer only reads the first row_count rows of its output (e.g., a Limit). The
+  // operator may then stop early and return fewer rows, but always returns the first row_count rows of its full
+  // output, or all of them if there are fewer. This has to be set before execute() and only by the sole consumer of
+  // the output. Operators that cannot stop early ignore it.
+  void set_output_row_limit(const size_t row_count);
+  std::optional<size_t> output_row_limit() const;
+
  protected:
   // abstract method to actually execute the operator
   // execute and get_output are split into two methods to allow for easier
@@ -54,12 +63,23 @@ class AbstractOperator : private Noncopyable {
   std::shared_ptr<const Table> _input_table_left() const;
   std::shared_ptr<const Table> _input_table_right() const;
 
+  // adds a ReferenceSegment for every column of input_table at the given positions to chunk. If input_table is a
+  // reference table, the positions are resolved to the rows it references, once for all columns sharing a PosList.
+  static void _add_reference_segments(const std::shared_ptr<const Table>& input_table,
+                                      const std::shared_ptr<const PosList>& positions, Chunk& chunk);
+
+  // returns whether all columns of the reference table input_table reference the same table at the same positions.
+  // Positions are compared by identity, equal positions in separate lists count as different ones.
+  static bool _has_uniform_positions(const Table& input_table);
+
   // Shared pointers to input operators, can be nullptr.
   std::shared_ptr<const AbstractOperator> _input_left;
   std::shared_ptr<const AbstractOperator> _input_right;
 
   // Is nullptr until the operator is executed
   std::shared_ptr<const Table> _output;
+
+  std::optional<size_t> _output_row_limit;
 };
 
 }  // namespace opossum
@@ -0,0 +1,160 @@
+#include "abstract_position_set_operator.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "scheduler/thread_pool.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// returns the positions that the reference segment holds, as one bitmap per referenced chunk
+std::vector<std::pair<ChunkID, PositionBitmap>> referenced_offsets(const ReferenceSegment& segment) {
+  std::vector<std::pair<ChunkID, PositionBitmap>> offsets;
+  if (segment.size() == 0) return offsets;
+
+  if (const auto& bitmap = segment.referenced_bitmap()) {
+    offsets.emplace_back(bitmap->chunk_id, *bitmap->offsets);
+    return offsets;
+  }
+
+  if (const auto& rows = segment.referenced_rows()) {
+    offsets.emplace_back(rows->chunk_id, PositionBitmap{});
+    offsets.back().second.append_range(rows->offsets);
+    return offsets;
+  }
+
+  segment.for_each_referenced_chunk(
+      ChunkOffsetRange{0, static_cast<ChunkOffset>(segment.size())}, nullptr,
+      [&](const ChunkID chunk_id, const ChunkOffsetRange&, const std::vector<ChunkOffset>* offset_filter) {
+        auto chunk_offsets = *offset_filter;
+        if (!segment.pos_list()->is_sorted()) std::sort(chunk_offsets.begin(), chunk_offsets.end());
+        chunk_offsets.erase(std::unique(chunk_offsets.begin(), chunk_offsets.end()), chunk_offsets.end());
+
+        offsets.emplace_back(chunk_id, PositionBitmap{});
+        for (const auto chunk_offset : chunk_offsets) {
+          offsets.back().second.append(chunk_offset);
+        }
+      });
+  return offsets;
+}
+
+}  // namespace
+
+AbstractPositionSetOperator::AbstractPositionSetOperator(const std::shared_ptr<const AbstractOperator> left,
+                                                         const std::shared_ptr<const AbstractOperator> right)
+    : AbstractOperator(left, right) {}
+
+std::shared_ptr<const Table> AbstractPositionSetOperator::_on_execute() {
+  const auto left_table = _input_table_left();
+  const auto right_table = _input_table_right();
+  const auto column_count = left_table->column_count();
+  Assert(column_count > 0 && right_table->column_count() == column_count, "Inputs need the same columns");
+  Assert(_has_uniform_positions(*left_table) && _has_uniform_positions(*right_table),
+         "All columns of an input have to reference the same rows");
+
+  // the columns of both inputs have to reference the same columns of one table
+  const auto reference_segment = [](const Table& table, const ChunkID chunk_id, const ColumnID column_id) {
+    const auto segment =
+        std::dynamic_pointer_cast<const ReferenceSegment>(table.get_chunk(chunk_id).get_segment(column_id));
+    Assert(segment, "Inputs have to be reference tables");
+    return segment;
+  };
+  auto referenced_table = std::shared_ptr<const Table>{};
+  auto referenced_column_ids = std::vector<ColumnID>(column_count);
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    Assert(left_table->column_type(column_id) == right_table->column_type(column_id), "Inputs need the same columns");
+    const auto left_segment = reference_segment(*left_table, ChunkID{0}, column_id);
+    const auto right_segment = reference_segment(*right_table, ChunkID{0}, column_id);
+    if (!referenced_table) referenced_table = left_segment->referenced_table();
+    Assert(left_segment->referenced_table() == referenced_table &&
+               right_segment->referenced_table() == referenced_table,
+           "All columns have to reference the same table");
+    Assert(left_segment->referenced_column_id() == right_segment->referenced_column_id(),
+           "Inputs have to reference the same columns");
+    referenced_column_ids[column_id] = left_segment->referenced_column_id();
+  }
+  // collects the positions of every input chunk in parallel, identifying the rows by their first column
+  const auto collect = [&](const Table& table) {
+    auto chunk_offsets = std::vector<std::vector<std::pair<ChunkID, PositionBitmap>>>(table.chunk_count());
+    std::vector<std::function<void()>> jobs;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      jobs.emplace_back([&, chunk_id]() {
+        const auto segment = reference_segment(table, chunk_id, ColumnID{0});
+        Assert(segment->referenced_table() == referenced_table, "All chunks have to reference the same table");
+        chunk_offsets[chunk_id] = referenced_offsets(*segment);
+      });
+    }
+    ThreadPool::get().execute_and_wait(jobs);
+
+    // groups the bitmaps by the referenced chunk, an input chunk may reference several chunks and vice versa
+    auto offsets_by_chunk = std::vector<std::vector<PositionBitmap>>(referenced_table->chunk_count());
+    for (auto& offsets : chunk_offsets) {
+      for (auto& [referenced_chunk_id, bitmap] : offsets) {
+        offsets_by_chunk[referenced_chunk_id].push_back(std::move(bitmap));
+      }
+    }
+    return offsets_by_chunk;
+  };
+  const auto left_offsets = collect(*left_table);
+  const auto right_offsets = collect(*right_table);
+
+  // combines the positions of both inputs chunk by chunk, one range of referenced chunks per worker
+  const auto referenced_chunk_count = static_cast<size_t>(referenced_table->chunk_count());
+  auto combined_offsets = std::vector<std::shared_ptr<const PositionBitmap>>(referenced_chunk_count);
+  const auto unite_all = [](const std::vector<PositionBitmap>& bitmaps) {
+    auto result = PositionBitmap{};
+    for (const auto& bitmap : bitmaps) {
+      result = result.empty() ? bitmap : result.unite(bitmap);
+    }
+    return result;
+  };
+  const auto job_count = std::max(size_t{1}, std::min(referenced_chunk_count, ThreadPool::get().worker_count()));
+  std::vector<std::function<void()>> jobs;
+  for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+    jobs.emplace_back([&, job_id]() {
+      const auto chunk_id_begin = ChunkID{static_cast<ChunkID::base_type>(job_id * referenced_chunk_count / job_count)};
+      const auto chunk_id_end =
+          ChunkID{static_cast<ChunkID::base_type>((job_id + 1) * referenced_chunk_count / job_count)};
+      for (auto chunk_id = chunk_id_begin; chunk_id < chunk_id_end; ++chunk_id) {
+        auto combined = _combine(unite_all(left_offsets[chunk_id]), unite_all(right_offsets[chunk_id]));
+        if (!combined.empty()) combined_offsets[chunk_id] = std::make_shared<const PositionBitmap>(std::move(combined));
+      }
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  auto output = std::make_shared<Table>(left_table->max_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    output->add_column_definition(left_table->column_name(column_id), left_table->column_type(column_id));
+  }
+  for (auto chunk_id = ChunkID{0}; chunk_id < referenced_chunk_count; ++chunk_id) {
+    if (!combined_offsets[chunk_id]) continue;
+    Chunk chunk;
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      chunk.add_segment(std::make_shared<ReferenceSegment>(referenced_table, referenced_column_ids[column_id],
+                                                           ChunkRowBitmap{chunk_id, combined_offsets[chunk_id]}));
+    }
+    output->emplace_chunk(std::move(chunk));
+  }
+
+  // a table always holds at least one chunk, if no row is returned, it is an empty one with all columns
+  if (output->row_count() == 0) {
+    Chunk chunk;
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      chunk.add_segment(std::make_shared<ReferenceSegment>(referenced_table, referenced_column_ids[column_id],
+                                                           std::make_shared<PosList>()));
+    }
+    output->emplace_chunk(std::move(chunk));
+  }
+  return output;
+}
+
+}  // namespace opossum
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+
+#include "abstract_operator.hpp"
+#include "storage/position_bitmap.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// AbstractPositionSetOperator is the super class of UnionPositions and IntersectPositions, which combine the rows of
+// two reference tables by their positions, e.g., the results of two scans on the same table for an OR predicate.
+// Both inputs need the same columns, referencing the same columns of the same table, and all columns of a row have to
+// reference the same row of that table, as in the output of scans. Rows referencing NULL_ROW_ID are dropped.
+//
+// The positions of each input are collected per referenced chunk in a PositionBitmap, which sorts and deduplicates
+// them. The bitmaps of both inputs are then combined chunk by chunk in parallel. The output holds one chunk per
+// referenced chunk with at least one row, in the order of the referenced table, whose ReferenceSegments share the
+// combined bitmap.
+class AbstractPositionSetOperator : public AbstractOperator {
+ public:
+  AbstractPositionSetOperator(const std::shared_ptr<const AbstractOperator> left,
+                              const std::shared_ptr<const AbstractOperator> right);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  // combines the offsets that both inputs reference in a chunk
+  virtual PositionBitmap _combine(const PositionBitmap& left, const PositionBitmap& right) const = 0;
+};
+
+}  // namespace opossum
@@ -0,0 +1,517 @@
+#include "aggregate.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// the key of a group is the concatenation of its group-by values, each preceded by a byte that tells if it is NULL
+using GroupKey = std::string;
+
+template <typename T>
+void append_key_part(GroupKey& key, const T& value, const bool is_null) {
+  key.push_back(is_null ? '\0' : '\1');
+  if (is_null) return;
+
+  if constexpr (std::is_same_v<T, std::string>) {
+    const auto length = static_cast<uint32_t>(value.size());
+    key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    key.append(value);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    // -0.0 and 0.0 are equal, but differ in their bytes
+    const auto normalized_value = value == T{0} ? T{0} : value;
+    key.append(reinterpret_cast<const char*>(&normalized_value), sizeof(T));
+  } else {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+// reads the group-by value at offset of the key and moves offset behind it
+template <typename T>
+T read_key_part(const GroupKey& key, size_t& offset) {
+  if (key[offset++] == '\0') return T{};
+
+  if constexpr (std::is_same_v<T, std::string>) {
+    auto length = uint32_t{0};
+    std::memcpy(&length, key.data() + offset, sizeof(length));
+    offset += sizeof(length);
+    auto value = key.substr(offset, length);
+    offset += length;
+    return value;
+  } else {
+    auto value = T{};
+    std::memcpy(&value, key.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+  }
+}
+
+// returns the type of the output column of the aggregate function applied to a column of the given type
+std::string aggregate_type(const std::string& column_type, const AggregateFunction function) {
+  switch (function) {
+    case AggregateFunction::Min:
+    case AggregateFunction::Max:
+      return column_type;
+    case AggregateFunction::Sum:
+      return column_type == "int" || column_type == "long" ? "long" : "double";
+    case AggregateFunction::Avg:
+      return "double";
+    case AggregateFunction::Count:
+      return "long";
+  }
+  Fail("Unknown aggregate function");
+  return "";
+}
+
+std::string aggregate_function_name(const AggregateFunction function) {
+  switch (function) {
+    case AggregateFunction::Min:
+      return "MIN";
+    case AggregateFunction::Max:
+      return "MAX";
+    case AggregateFunction::Sum:
+      return "SUM";
+    case AggregateFunction::Avg:
+      return "AVG";
+    case AggregateFunction::Count:
+      return "COUNT";
+  }
+  Fail("Unknown aggregate function");
+  return "";
+}
+
+// computes one aggregate for all groups of a hash table, group by group
+class BaseAggregator {
+ public:
+  virtual ~BaseAggregator() = default;
+
+  // returns an aggregator of the same function and column without any groups
+  virtual std::unique_ptr<BaseAggregator> new_instance() const = 0;
+
+  virtual void resize(const size_t group_count) = 0;
+
+  // adds every row of the chunk to the aggregate of its group in group_ids
+  virtual void aggregate(const Chunk& chunk, const std::vector<uint32_t>& group_ids) = 0;
+
+  // adds the aggregates of the groups source_group_ids of source, an aggregator of the same kind, to the groups
+  // target_group_ids of this one
+  virtual void merge(const BaseAggregator& source, const std::vector<uint32_t>& source_group_ids,
+                     const std::vector<uint32_t>& target_group_ids) = 0;
+
+  // returns the aggregates of all groups
+  virtual std::shared_ptr<BaseSegment> result_segment() const = 0;
+};
+
+template <typename ColumnType, AggregateFunction function>
+class Aggregator : public BaseAggregator {
+ public:
+  // the type in which the aggregate is computed. It is the result type, except for AVG, which divides it by the count
+  using AggregateType = std::conditional_t<
+      function == AggregateFunction::Min || function == AggregateFunction::Max, ColumnType,
+      std::conditional_t<function == AggregateFunction::Sum && std::is_integral_v<ColumnType>, int64_t, double>>;
+  using ResultType = std::conditional_t<function == AggregateFunction::Count, int64_t,
+                                        std::conditional_t<function == AggregateFunction::Avg, double, AggregateType>>;
+
+  // COUNT(*) has no column
+  explicit Aggregator(const std::optional<ColumnID>& column_id) : _column_id{column_id} {}
+
+  std::unique_ptr<BaseAggregator> new_instance() const final { return std::make_unique<Aggregator>(_column_id); }
+
+  void resize(const size_t group_count) final {
+    _counts.resize(group_count);
+    if constexpr (function != AggregateFunction::Count) _aggregates.resize(group_count);
+  }
+
+  void aggregate(const Chunk& chunk, const std::vector<uint32_t>& group_ids) final {
+    const auto row_count = chunk.size();
+    if (!_column_id) {
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        ++_counts[group_ids[chunk_offset]];
+      }
+      return;
+    }
+
+    const auto& segment = *chunk.get_segment(*_column_id);
+    const auto positions = nullable_positions(segment);
+    if constexpr (function == AggregateFunction::Count) {
+      // only the NULLs matter, not the values
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        if (positions && (*positions)[chunk_offset] == NULL_ROW_ID) continue;
+        ++_counts[group_ids[chunk_offset]];
+      }
+    } else {
+      std::vector<ColumnType> values(row_count);
+      materialize_values(segment, ChunkOffsetRange{0, row_count}, values.data());
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        if (positions && (*positions)[chunk_offset] == NULL_ROW_ID) continue;
+        _add(group_ids[chunk_offset], values[chunk_offset], 1);
+      }
+    }
+  }
+
+  void merge(const BaseAggregator& source, const std::vector<uint32_t>& source_group_ids,
+             const std::vector<uint32_t>& target_group_ids) final {
+    const auto& typed_source = static_cast<const Aggregator&>(source);
+    for (auto index = size_t{0}; index < source_group_ids.size(); ++index) {
+      const auto source_group_id = source_group_ids[index];
+      const auto source_count = typed_source._counts[source_group_id];
+      if (source_count == 0) continue;
+      if constexpr (function == AggregateFunction::Count) {
+        _counts[target_group_ids[index]] += source_count;
+      } else {
+        _add(target_group_ids[index], typed_source._aggregates[source_group_id], source_count);
+      }
+    }
+  }
+
+  std::shared_ptr<BaseSegment> result_segment() const final {
+    const auto group_count = _counts.size();
+    std::vector<ResultType> results(group_count);
+    for (auto group_id = size_t{0}; group_id < group_count; ++group_id) {
+      if constexpr (function == AggregateFunction::Count) {
+        results[group_id] = static_cast<int64_t>(_counts[group_id]);
+      } else if constexpr (function == AggregateFunction::Avg) {
+        if (_counts[group_id] > 0) results[group_id] = _aggregates[group_id] / static_cast<double>(_counts[group_id]);
+      } else {
+        if (_counts[group_id] > 0) results[group_id] = _aggregates[group_id];
+      }
+    }
+    return std::make_shared<ValueSegment<ResultType>>(std::move(results));
+  }
+
+ protected:
+  // adds count values, which are aggregated to value already, to the group
+  template <typename ValueType>
+  void _add(const uint32_t group_id, const ValueType& value, const uint64_t count) {
+    auto& aggregate = _aggregates[group_id];
+    if constexpr (function == AggregateFunction::Min) {
+      if (_counts[group_id] == 0 || value < aggregate) aggregate = value;
+    } else if constexpr (function == AggregateFunction::Max) {
+      if (_counts[group_id] == 0 || aggregate < value) aggregate = value;
+    } else {
+      aggregate += value;
+    }
+    _counts[group_id] += count;
+  }
+
+  const std::optional<ColumnID> _column_id;
+
+  // the number of non-NULL values of each group, or of its rows for COUNT(*)
+  std::vector<uint64_t> _counts;
+  std::vector<AggregateType> _aggregates;
+};
+
+std::unique_ptr<BaseAggregator> make_aggregator(const Table& table, const AggregateColumnDefinition& definition) {
+  if (!definition.column_id) {
+    Assert(definition.function == AggregateFunction::Count, "Only COUNT can be computed without a column");
+    return std::make_unique<Aggregator<int32_t, AggregateFunction::Count>>(std::nullopt);
+  }
+  Assert(*definition.column_id < table.column_count(), "Aggregated column does not exist");
+
+  std::unique_ptr<BaseAggregator> aggregator;
+  resolve_data_type(table.column_type(*definition.column_id), [&](auto type) {
+    using ColumnType = typename decltype(type)::type;
+    switch (definition.function) {
+      case AggregateFunction::Min:
+        aggregator = std::make_unique<Aggregator<ColumnType, AggregateFunction::Min>>(definition.column_id);
+        break;
+      case AggregateFunction::Max:
+        aggregator = std::make_unique<Aggregator<ColumnType, AggregateFunction::Max>>(definition.column_id);
+        break;
+      case AggregateFunction::Sum:
+        if constexpr (std::is_arithmetic_v<ColumnType>) {
+          aggregator = std::make_unique<Aggregator<ColumnType, AggregateFunction::Sum>>(definition.column_id);
+        } else {
+          Fail("SUM is only defined for numeric columns");
+        }
+        break;
+      case AggregateFunction::Avg:
+        if constexpr (std::is_arithmetic_v<ColumnType>) {
+          aggregator = std::make_unique<Aggregator<ColumnType, AggregateFunction::Avg>>(definition.column_id);
+        } else {
+          Fail("AVG is only defined for numeric columns");
+        }
+        break;
+      case AggregateFunction::Count:
+        aggregator = std::make_unique<Aggregator<ColumnType, AggregateFunction::Count>>(definition.column_id);
+        break;
+    }
+  });
+  return aggregator;
+}
+
+// the groups of a part of the input and their aggregates
+struct GroupTable {
+  explicit GroupTable(const std::vector<std::unique_ptr<BaseAggregator>>& prototype_aggregators) {
+    for (const auto& prototype_aggregator : prototype_aggregators) {
+      aggregators.push_back(prototype_aggregator->new_instance());
+    }
+  }
+
+  // returns the id of the group with the key, a new group gets the next id
+  uint32_t group_id(GroupKey&& key) {
+    const auto [entry, inserted] = group_ids.try_emplace(std::move(key), static_cast<uint32_t>(keys.size()));
+    if (inserted) keys.push_back(&entry->first);
+    return entry->second;
+  }
+
+  std::unordered_map<GroupKey, uint32_t> group_ids;
+  // the keys of the groups by their id, they point into group_ids
+  std::vector<const GroupKey*> keys;
+  std::vector<std::unique_ptr<BaseAggregator>> aggregators;
+
+  // the groups that belong to each merge partition, set once the table is handed over to the merge
+  std::vector<std::vector<uint32_t>> partition_group_ids;
+};
+
+// sets the group of every row of the chunk in group_ids by building and hashing its key
+void hash_group_ids(const Table& table, const Chunk& chunk, const std::vector<ColumnID>& groupby_column_ids,
+                    GroupTable& group_table, std::vector<uint32_t>& group_ids) {
+  const auto row_count = chunk.size();
+  std::vector<GroupKey> row_keys(row_count);
+  for (const auto& column_id : groupby_column_ids) {
+    const auto& segment = *chunk.get_segment(column_id);
+    const auto positions = nullable_positions(segment);
+    resolve_data_type(table.column_type(column_id), [&](auto type) {
+      using ColumnType = typename decltype(type)::type;
+      std::vector<ColumnType> values(row_count);
+      materialize_values(segment, ChunkOffsetRange{0, row_count}, values.data());
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        append_key_part(row_keys[chunk_offset], values[chunk_offset],
+                        positions && (*positions)[chunk_offset] == NULL_ROW_ID);
+      }
+    });
+  }
+
+  group_ids.resize(row_count);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+    group_ids[chunk_offset] = group_table.group_id(std::move(row_keys[chunk_offset]));
+  }
+}
+
+// sets the group of every row of the chunk in group_ids if all its group-by segments are DictionarySegments. Their
+// value ids are combined like the digits of a number, and combination_group_ids, indexed by that number, maps them to
+// the group. Only the first row of every combination builds and hashes the key of its group. Returns false, without
+// setting any group, if a segment is no DictionarySegment or there are more than DENSE_GROUP_LIMIT combinations.
+bool dictionary_group_ids(const Table& table, const Chunk& chunk, const std::vector<ColumnID>& groupby_column_ids,
+                          GroupTable& group_table, std::vector<uint32_t>& group_ids,
+                          std::vector<uint32_t>& combination_group_ids) {
+  struct DictionaryColumn {
+    size_t stride;
+    size_t dictionary_size;
+    // appends the value of a value id to a key
+    std::function<void(GroupKey&, ValueID)> append_value;
+  };
+  std::vector<DictionaryColumn> dictionary_columns;
+
+  const auto row_count = chunk.size();
+  std::vector<uint32_t> combinations(row_count);
+  auto combination_count = size_t{1};
+  for (const auto& column_id : groupby_column_ids) {
+    auto is_dictionary_column = false;
+    resolve_data_type(table.column_type(column_id), [&](auto type) {
+      using ColumnType = typename decltype(type)::type;
+      const auto segment = std::dynamic_pointer_cast<const DictionarySegment<ColumnType>>(chunk.get_segment(column_id));
+      if (!segment) return;
+      const auto dictionary_size = segment->unique_values_count();
+      if (combination_count * dictionary_size > Aggregate::DENSE_GROUP_LIMIT) return;
+
+      const auto stride = combination_count;
+      segment->with_value_ids([&](const auto* const value_ids) {
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+          combinations[chunk_offset] += static_cast<uint32_t>(value_ids[chunk_offset] * stride);
+        }
+      });
+      const auto append_value = [segment](GroupKey& key, const ValueID value_id) {
+        append_key_part(key, segment->value_by_value_id(value_id), false);
+      };
+      dictionary_columns.push_back(DictionaryColumn{stride, dictionary_size, append_value});
+      combination_count *= dictionary_size;
+      is_dictionary_column = true;
+    });
+    if (!is_dictionary_column) return false;
+  }
+
+  constexpr auto NO_GROUP = std::numeric_limits<uint32_t>::max();
+  combination_group_ids.assign(combination_count, NO_GROUP);
+  group_ids.resize(row_count);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+    const auto combination = combinations[chunk_offset];
+    auto& group_id = combination_group_ids[combination];
+    if (group_id == NO_GROUP) {
+      auto key = GroupKey{};
+      for (const auto& dictionary_column : dictionary_columns) {
+        const auto value_id = combination / dictionary_column.stride % dictionary_column.dictionary_size;
+        dictionary_column.append_value(key, ValueID{static_cast<ValueID::base_type>(value_id)});
+      }
+      group_id = group_table.group_id(std::move(key));
+    }
+    group_ids[chunk_offset] = group_id;
+  }
+  return true;
+}
+
+}  // namespace
+
+AggregateColumnDefinition::AggregateColumnDefinition(const std::optional<ColumnID>& column_id,
+                                                     const AggregateFunction function)
+    : column_id{column_id}, function{function} {}
+
+Aggregate::Aggregate(const std::shared_ptr<const AbstractOperator> in,
+                     const std::vector<AggregateColumnDefinition>& aggregates,
+                     const std::vector<ColumnID>& groupby_column_ids)
+    : AbstractOperator(in), _aggregates{aggregates}, _groupby_column_ids{groupby_column_ids} {}
+
+const std::vector<AggregateColumnDefinition>& Aggregate::aggregates() const { return _aggregates; }
+
+const std::vector<ColumnID>& Aggregate::groupby_column_ids() const { return _groupby_column_ids; }
+
+std::shared_ptr<const Table> Aggregate::_on_execute() {
+  const auto input_table = _input_table_left();
+
+  auto output = std::make_shared<Table>();
+  for (const auto& column_id : _groupby_column_ids) {
+    Assert(column_id < input_table->column_count(), "Group-by column does not exist");
+    output->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+  std::vector<std::unique_ptr<BaseAggregator>> prototype_aggregators;
+  for (const auto& definition : _aggregates) {
+    prototype_aggregators.push_back(make_aggregator(*input_table, definition));
+    const auto column_name = definition.column_id ? input_table->column_name(*definition.column_id) : "*";
+    const auto column_type = definition.column_id ? input_table->column_type(*definition.column_id) : "int";
+    output->add_column_definition(aggregate_function_name(definition.function) + "(" + column_name + ")",
+                                  aggregate_type(column_type, definition.function));
+  }
+
+  // pre-aggregate the ranges of chunks in parallel
+  const auto chunk_count = static_cast<size_t>(input_table->chunk_count());
+  const auto job_count = std::max(size_t{1}, std::min(chunk_count, ThreadPool::get().worker_count()));
+  const auto partition_count = job_count;
+  std::vector<std::vector<std::unique_ptr<GroupTable>>> job_group_tables(job_count);
+  std::vector<std::function<void()>> jobs;
+  for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+    jobs.emplace_back([&, job_id]() {
+      auto& group_tables = job_group_tables[job_id];
+      const auto hand_over = [&](std::unique_ptr<GroupTable> group_table) {
+        group_table->partition_group_ids.resize(partition_count);
+        for (auto group_id = uint32_t{0}; group_id < group_table->keys.size(); ++group_id) {
+          const auto partition_id = std::hash<GroupKey>{}(*group_table->keys[group_id]) % partition_count;
+          group_table->partition_group_ids[partition_id].push_back(group_id);
+        }
+        group_tables.push_back(std::move(group_table));
+      };
+
+      auto group_table = std::make_unique<GroupTable>(prototype_aggregators);
+      std::vector<uint32_t> group_ids;
+      std::vector<uint32_t> combination_group_ids;
+      const auto chunk_id_begin = ChunkID{static_cast<ChunkID::base_type>(job_id * chunk_count / job_count)};
+      const auto chunk_id_end = ChunkID{static_cast<ChunkID::base_type>((job_id + 1) * chunk_count / job_count)};
+      for (auto chunk_id = chunk_id_begin; chunk_id < chunk_id_end; ++chunk_id) {
+        const auto& chunk = input_table->get_chunk(chunk_id);
+        const auto row_count = chunk.size();
+        if (row_count == 0) continue;
+
+        if (!dictionary_group_ids(*input_table, chunk, _groupby_column_ids, *group_table, group_ids,
+                                  combination_group_ids)) {
+          hash_group_ids(*input_table, chunk, _groupby_column_ids, *group_table, group_ids);
+        }
+        for (const auto& aggregator : group_table->aggregators) {
+          aggregator->resize(group_table->keys.size());
+          aggregator->aggregate(chunk, group_ids);
+        }
+
+        if (group_table->keys.size() >= LOCAL_GROUP_LIMIT) {
+          hand_over(std::move(group_table));
+          group_table = std::make_unique<GroupTable>(prototype_aggregators);
+        }
+      }
+      hand_over(std::move(group_table));
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  // creates an output chunk with the groups of the table
+  const auto build_chunk = [&](const GroupTable& group_table) {
+    Chunk chunk;
+    const auto group_count = group_table.keys.size();
+    std::vector<size_t> key_offsets(group_count);
+    for (const auto& column_id : _groupby_column_ids) {
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using ColumnType = typename decltype(type)::type;
+        std::vector<ColumnType> values(group_count);
+        for (auto group_id = size_t{0}; group_id < group_count; ++group_id) {
+          values[group_id] = read_key_part<ColumnType>(*group_table.keys[group_id], key_offsets[group_id]);
+        }
+        chunk.add_segment(std::make_shared<ValueSegment<ColumnType>>(std::move(values)));
+      });
+    }
+    for (const auto& aggregator : group_table.aggregators) {
+      chunk.add_segment(aggregator->result_segment());
+    }
+    return chunk;
+  };
+
+  // merge the partitions in parallel, each results in one chunk
+  std::vector<std::optional<Chunk>> partition_chunks(partition_count);
+  jobs.clear();
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    jobs.emplace_back([&, partition_id]() {
+      auto merged_table = GroupTable{prototype_aggregators};
+      std::vector<uint32_t> target_group_ids;
+      for (const auto& group_tables : job_group_tables) {
+        for (const auto& group_table : group_tables) {
+          const auto& source_group_ids = group_table->partition_group_ids[partition_id];
+          target_group_ids.clear();
+          for (const auto source_group_id : source_group_ids) {
+            target_group_ids.push_back(merged_table.group_id(GroupKey{*group_table->keys[source_group_id]}));
+          }
+          for (auto aggregator_id = size_t{0}; aggregator_id < merged_table.aggregators.size(); ++aggregator_id) {
+            merged_table.aggregators[aggregator_id]->resize(merged_table.keys.size());
+            merged_table.aggregators[aggregator_id]->merge(*group_table->aggregators[aggregator_id],
+                                                           source_group_ids, target_group_ids);
+          }
+        }
+      }
+      if (!merged_table.keys.empty()) partition_chunks[partition_id] = build_chunk(merged_table);
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  for (auto& chunk : partition_chunks) {
+    if (chunk) output->emplace_chunk(std::move(*chunk));
+  }
+
+  // without groups, the output is an empty chunk with all columns. Without group-by columns, there is always the one
+  // group of all rows, even if there are none.
+  if (output->row_count() == 0) {
+    auto empty_table = GroupTable{prototype_aggregators};
+    if (_groupby_column_ids.empty()) {
+      empty_table.group_id(GroupKey{});
+      for (const auto& aggregator : empty_table.aggregators) aggregator->resize(1);
+    }
+    output->emplace_chunk(build_chunk(empty_table));
+  }
+
+  return output;
+}
+
+}  // namespace opossum
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// an aggregate function applied to a column of the input, or COUNT(*) if no column is given
+struct AggregateColumnDefinition {
+  AggregateColumnDefinition(const std::optional<ColumnID>& column_id, const AggregateFunction function);
+
+  std::optional<ColumnID> column_id;
+  AggregateFunction function;
+};
+
+// Groups the rows of the input by the values of the group-by columns and computes the aggregates for every group.
+// The output holds the group-by columns followed by one column per aggregate, named like "SUM(a)". Without group-by
+// columns, all rows form a single group, which also exists if the input is empty.
+//
+// The input is split into one range of chunks per worker, and every worker pre-aggregates its range into a hash table
+// of its own. Once that table holds LOCAL_GROUP_LIMIT groups, i.e., it no longer fits into the cache, it is handed
+// over to the merge and the worker continues with an empty table. For the merge, the groups are partitioned by the
+// hash of their keys, and every partition is merged by one worker into one output chunk. Values are read in bulk with
+// materialize_values(), so that the aggregates are computed in tight loops per chunk.
+//
+// If all group-by segments of a chunk are DictionarySegments, the rows are grouped by their value ids instead: the
+// combination of value ids indexes an array of the chunk's groups, and values are looked up only once per
+// combination, to find its group in the hash table. This requires at most DENSE_GROUP_LIMIT combinations, which
+// typically holds for 8- and 16-bit value ids. Without aggregates, the operator computes the DISTINCT group-by values.
+//
+// SUM and AVG are only defined for numeric columns. SUM yields a long for integral and a double for floating-point
+// columns, AVG a double and COUNT a long. MIN and MAX keep the type of the column. NULLs are skipped by the aggregate
+// functions and form a group of their own. As data tables cannot hold NULLs, the output holds the default value of
+// the type (e.g., 0) for the key of that group and for the aggregates of groups without non-NULL values.
+class Aggregate : public AbstractOperator {
+ public:
+  Aggregate(const std::shared_ptr<const AbstractOperator> in, const std::vector<AggregateColumnDefinition>& aggregates,
+            const std::vector<ColumnID>& groupby_column_ids);
+
+  const std::vector<AggregateColumnDefinition>& aggregates() const;
+  const std::vector<ColumnID>& groupby_column_ids() const;
+
+  // the number of groups up to which a worker pre-aggregates into the same hash table
+  static constexpr size_t LOCAL_GROUP_LIMIT = 16 * 1024;
+
+  // the number of combinations of value ids up to which the rows of a chunk are grouped by their value ids
+  static constexpr size_t DENSE_GROUP_LIMIT = 64 * 1024;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<AggregateColumnDefinition> _aggregates;
+  const std::vector<ColumnID> _groupby_column_ids;
+};
+
+}  // namespace opossum
@@ -0,0 +1,143 @@
+#include "index_scan.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/index/base_index.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "table_scan.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+IndexScan::IndexScan(const std::shared_ptr<const AbstractOperator> in, const std::vector<ColumnID> column_ids,
+                     const ScanType scan_type, const std::vector<AllTypeVariant> search_values,
+                     const std::optional<AllTypeVariant> search_value2)
+    : AbstractOperator(in),
+      _column_ids{column_ids},
+      _scan_type{scan_type},
+      _search_values{search_values},
+      _search_value2{search_value2} {
+  Assert(!_column_ids.empty() && _column_ids.size() == _search_values.size(),
+         "IndexScan needs one search value per column");
+  Assert(_scan_type != ScanType::OpIn, "IndexScan does not support OpIn");
+  Assert((_scan_type == ScanType::OpBetween) == _search_value2.has_value(),
+         "A second search value has to be given for and only for OpBetween");
+}
+
+const std::vector<ColumnID>& IndexScan::column_ids() const { return _column_ids; }
+
+ScanType IndexScan::scan_type() const { return _scan_type; }
+
+const std::vector<AllTypeVariant>& IndexScan::search_values() const { return _search_values; }
+
+const std::optional<AllTypeVariant>& IndexScan::search_value2() const { return _search_value2; }
+
+std::shared_ptr<const Table> IndexScan::_on_execute() {
+  const auto input_table = _input_table_left();
+  const auto chunk_count = static_cast<size_t>(input_table->chunk_count());
+  const auto is_reference_table =
+      input_table->get_chunk(ChunkID{0}).column_count() > 0 &&
+      std::dynamic_pointer_cast<const ReferenceSegment>(input_table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+
+  // the qualifying rows of every chunk that was looked up in an index, std::nullopt for chunks without one
+  auto chunk_offsets = std::vector<std::optional<PositionBitmap>>(chunk_count);
+  if (!is_reference_table && BaseIndex::supports(_scan_type)) {
+    // indexes compare values of the same type, so the search values are converted to the types of the columns
+    auto search_values = std::vector<AllTypeVariant>{};
+    auto search_value2 = std::optional<AllTypeVariant>{};
+    for (auto value_id = size_t{0}; value_id < _column_ids.size(); ++value_id) {
+      resolve_data_type(input_table->column_type(_column_ids[value_id]), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        search_values.emplace_back(type_cast<Type>(_search_values[value_id]));
+        if (_search_value2 && value_id + 1 == _column_ids.size()) search_value2 = type_cast<Type>(*_search_value2);
+      });
+    }
+
+    const auto job_count = std::max(size_t{1}, std::min(chunk_count, ThreadPool::get().worker_count()));
+    std::vector<std::function<void()>> jobs;
+    for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+      jobs.emplace_back([&, job_id]() {
+        const auto chunk_id_begin = ChunkID{static_cast<ChunkID::base_type>(job_id * chunk_count / job_count)};
+        const auto chunk_id_end = ChunkID{static_cast<ChunkID::base_type>((job_id + 1) * chunk_count / job_count)};
+        for (auto chunk_id = chunk_id_begin; chunk_id < chunk_id_end; ++chunk_id) {
+          const auto& chunk = input_table->get_chunk(chunk_id);
+          if (chunk.size() == 0) {
+            chunk_offsets[chunk_id] = PositionBitmap{};
+            continue;
+          }
+          const auto indexes = chunk.get_indexes(_column_ids);
+          if (indexes.empty()) continue;
+          chunk_offsets[chunk_id] = indexes.front()->lookup(_scan_type, search_values, search_value2);
+        }
+      });
+    }
+    ThreadPool::get().execute_and_wait(jobs);
+  }
+
+  auto output = std::make_shared<Table>(input_table->max_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  auto looked_up_chunk_ids = std::vector<ChunkID>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (!chunk_offsets[chunk_id]) continue;
+    looked_up_chunk_ids.push_back(chunk_id);
+    if (chunk_offsets[chunk_id]->empty()) continue;
+
+    const auto row_count = input_table->get_chunk(chunk_id).size();
+    auto offsets = std::make_shared<const PositionBitmap>(std::move(*chunk_offsets[chunk_id]));
+    Chunk chunk;
+    for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+      if (offsets->size() == row_count) {
+        chunk.add_segment(std::make_shared<ReferenceSegment>(input_table, column_id,
+                                                             ChunkRowRange{chunk_id, ChunkOffsetRange{0, row_count}}));
+      } else {
+        chunk.add_segment(
+            std::make_shared<ReferenceSegment>(input_table, column_id, ChunkRowBitmap{chunk_id, offsets}));
+      }
+    }
+    output->emplace_chunk(std::move(chunk));
+  }
+
+  if (looked_up_chunk_ids.size() < chunk_count) {
+    auto predicates = std::vector<ScanPredicate>{};
+    for (auto value_id = size_t{0}; value_id + 1 < _column_ids.size(); ++value_id) {
+      predicates.push_back(ScanPredicate{_column_ids[value_id], ScanType::OpEquals, _search_values[value_id]});
+    }
+    predicates.push_back(ScanPredicate{_column_ids.back(), _scan_type, _search_values.back(), _search_value2});
+
+    auto table_scan = std::make_shared<TableScan>(_input_left, predicates);
+    table_scan->set_excluded_chunk_ids(looked_up_chunk_ids);
+    table_scan->execute();
+    const auto scan_output = table_scan->get_output();
+    for (auto chunk_id = ChunkID{0}; chunk_id < scan_output->chunk_count(); ++chunk_id) {
+      const auto& scan_chunk = scan_output->get_chunk(chunk_id);
+      if (scan_chunk.size() == 0) continue;
+      Chunk chunk;
+      for (auto column_id = ColumnID{0}; column_id < scan_chunk.column_count(); ++column_id) {
+        chunk.add_segment(scan_chunk.get_segment(column_id));
+      }
+      output->emplace_chunk(std::move(chunk));
+    }
+  }
+
+  // a table always holds at least one chunk, if no row is returned, it is an empty one with all columns
+  if (output->row_count() == 0) {
+    Chunk chunk;
+    _add_reference_segments(input_table, std::make_shared<PosList>(), chunk);
+    output->emplace_chunk(std::move(chunk));
+  }
+  return output;
+}
+
+}  // namespace opossum
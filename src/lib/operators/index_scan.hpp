@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Filters the input like a TableScan, but looks up the rows in the indexes of its chunks (see storage/index/) where
+// possible, e.g., for point and narrow range lookups. The search values are compared with the given columns like in
+// BaseIndex::lookup: all but the last one have to be equal, the last one is compared with scan_type.
+//
+// The chunks with an index on the columns are looked up in parallel. Their qualifying rows are referenced through the
+// bitmap of the lookup, or as a whole if all rows qualify. All other chunks, and scan types that indexes do not
+// support, fall back to a TableScan with the equivalent predicates, whose output follows the chunks that were looked
+// up. Reference tables hold no indexes and are always scanned.
+class IndexScan : public AbstractOperator {
+ public:
+  IndexScan(const std::shared_ptr<const AbstractOperator> in, const std::vector<ColumnID> column_ids,
+            const ScanType scan_type, const std::vector<AllTypeVariant> search_values,
+            const std::optional<AllTypeVariant> search_value2 = std::nullopt);
+
+  const std::vector<ColumnID>& column_ids() const;
+  ScanType scan_type() const;
+  const std::vector<AllTypeVariant>& search_values() const;
+  const std::optional<AllTypeVariant>& search_value2() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<ColumnID> _column_ids;
+  const ScanType _scan_type;
+  const std::vector<AllTypeVariant> _search_values;
+  const std::optional<AllTypeVariant> _search_value2;
+};
+
+}  // namespace opossum
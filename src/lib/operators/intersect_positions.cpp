@@ -0,0 +1,15 @@
+#include "intersect_positions.hpp"
+
+#include <memory>
+
+namespace opossum {
+
+IntersectPositions::IntersectPositions(const std::shared_ptr<const AbstractOperator> left,
+                                       const std::shared_ptr<const AbstractOperator> right)
+    : AbstractPositionSetOperator(left, right) {}
+
+PositionBitmap IntersectPositions::_combine(const PositionBitmap& left, const PositionBitmap& right) const {
+  return left.intersect(right);
+}
+
+}  // namespace opossum
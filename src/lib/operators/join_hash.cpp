@@ -0,0 +1,232 @@
+#include "join_hash.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// the upper bits of the hash select the partition of a join key
+template <typename T>
+size_t hash_key(const T& value) {
+  // std::hash is the identity for integers, the multiplication carries differences in the lower bits to the upper ones
+  return std::hash<T>{}(value) * size_t{0x9E3779B97F4A7C15};
+}
+
+template <typename T>
+struct PartitionElement {
+  T value;
+  RowID row_id;
+};
+
+template <typename T>
+struct RadixPartitions {
+  // the elements of all partitions, partition by partition
+  std::vector<PartitionElement<T>> elements;
+  // partition p holds the elements [offsets[p], offsets[p + 1])
+  std::vector<size_t> offsets;
+  // the rows whose join key is NULL, which never match
+  std::vector<RowID> null_rows;
+};
+
+// materializes the join keys of the column and scatters them into 2^radix_bits partitions. Within a partition, the
+// elements keep the order of the table.
+template <typename T>
+RadixPartitions<T> radix_partition(const Table& table, const ColumnID column_id, const size_t radix_bits) {
+  const auto partition_count = size_t{1} << radix_bits;
+  const auto chunk_count = table.chunk_count();
+
+  struct ChunkElements {
+    std::vector<PartitionElement<T>> elements;
+    std::vector<uint16_t> partition_ids;
+    std::vector<size_t> histogram;
+    std::vector<RowID> null_rows;
+  };
+  std::vector<ChunkElements> chunk_elements(chunk_count);
+
+  // materialize the keys and count the elements per partition, chunk by chunk
+  for (auto& result : chunk_elements) result.histogram.resize(partition_count);
+  materialize_join_column<T>(table, column_id, [&](const ChunkID chunk_id, std::vector<T>& values,
+                                               const PosList* positions) {
+    auto& result = chunk_elements[chunk_id];
+    result.elements.reserve(values.size());
+    result.partition_ids.reserve(values.size());
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+      if (positions && (*positions)[chunk_offset] == NULL_ROW_ID) {
+        result.null_rows.push_back(RowID{chunk_id, chunk_offset});
+        continue;
+      }
+      const auto partition_id =
+          radix_bits == 0 ? size_t{0}
+                          : hash_key(values[chunk_offset]) >> (std::numeric_limits<size_t>::digits - radix_bits);
+      ++result.histogram[partition_id];
+      result.partition_ids.push_back(static_cast<uint16_t>(partition_id));
+      result.elements.push_back(PartitionElement<T>{std::move(values[chunk_offset]), RowID{chunk_id, chunk_offset}});
+    }
+  });
+
+  // in every partition, the elements of a chunk are written behind those of the previous chunks
+  auto partitions = RadixPartitions<T>{};
+  partitions.offsets.resize(partition_count + 1);
+  std::vector<std::vector<size_t>> write_positions(chunk_count, std::vector<size_t>(partition_count));
+  auto element_count = size_t{0};
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    partitions.offsets[partition_id] = element_count;
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      write_positions[chunk_id][partition_id] = element_count;
+      element_count += chunk_elements[chunk_id].histogram[partition_id];
+    }
+  }
+  partitions.offsets[partition_count] = element_count;
+  partitions.elements.resize(element_count);
+
+  std::vector<std::function<void()>> jobs;
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back([&, chunk_id]() {
+      auto& chunk_result = chunk_elements[chunk_id];
+      auto& chunk_write_positions = write_positions[chunk_id];
+      for (auto index = size_t{0}; index < chunk_result.elements.size(); ++index) {
+        partitions.elements[chunk_write_positions[chunk_result.partition_ids[index]]++] =
+            std::move(chunk_result.elements[index]);
+      }
+      chunk_result.elements = std::vector<PartitionElement<T>>{};
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  for (const auto& chunk_result : chunk_elements) {
+    partitions.null_rows.insert(partitions.null_rows.end(), chunk_result.null_rows.cbegin(),
+                                chunk_result.null_rows.cend());
+  }
+  return partitions;
+}
+
+}  // namespace
+
+JoinHash::JoinHash(const std::shared_ptr<const AbstractOperator> left,
+                   const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                   const std::pair<ColumnID, ColumnID>& column_ids)
+    : AbstractJoinOperator(left, right, mode, column_ids, ScanType::OpEquals) {}
+
+size_t JoinHash::radix_bits(const size_t build_row_count, const size_t element_size) {
+  const auto partition_count = (build_row_count * element_size + PARTITION_TARGET_SIZE - 1) / PARTITION_TARGET_SIZE;
+  if (partition_count <= 1) return 0;
+
+  // once the right input needs to be partitioned anyway, every worker gets at least one partition
+  const auto target_partition_count = std::max(partition_count, ThreadPool::get().worker_count());
+  auto bits = size_t{0};
+  while ((size_t{1} << bits) < target_partition_count && bits < MAX_RADIX_BITS) ++bits;
+  return bits;
+}
+
+std::shared_ptr<const Table> JoinHash::_on_execute() {
+  const auto left_table = _input_table_left();
+  const auto right_table = _input_table_right();
+  Assert(_column_ids.first < left_table->column_count() && _column_ids.second < right_table->column_count(),
+         "Join column does not exist");
+  Assert(left_table->column_type(_column_ids.first) == right_table->column_type(_column_ids.second),
+         "Join columns need to have the same data type");
+
+  std::vector<JoinedPositions> joined_positions;
+  resolve_data_type(left_table->column_type(_column_ids.first), [&](auto type) {
+    using ColumnType = typename decltype(type)::type;
+    joined_positions = _join<ColumnType>(*left_table, *right_table);
+  });
+  return _build_output(joined_positions);
+}
+
+template <typename T>
+std::vector<AbstractJoinOperator::JoinedPositions> JoinHash::_join(const Table& left_table,
+                                                                   const Table& right_table) const {
+  const auto bits = radix_bits(right_table.row_count(), sizeof(PartitionElement<T>));
+  const auto left_partitions = radix_partition<T>(left_table, _column_ids.first, bits);
+  const auto right_partitions = radix_partition<T>(right_table, _column_ids.second, bits);
+  const auto outputs_right_positions = _mode == JoinMode::Inner || _mode == JoinMode::Left;
+
+  // build and probe the partitions in parallel, every partition results in one chunk
+  const auto partition_count = size_t{1} << bits;
+  std::vector<JoinedPositions> joined_positions(partition_count);
+  std::vector<std::function<void()>> jobs;
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    jobs.emplace_back([&, partition_id]() {
+      const auto* const build_elements = right_partitions.elements.data() + right_partitions.offsets[partition_id];
+      const auto build_size = right_partitions.offsets[partition_id + 1] - right_partitions.offsets[partition_id];
+
+      // rows of the right input with the same key form a chain: heads maps the key to the first row, next[index]
+      // points to the row after build_elements[index]
+      constexpr auto NO_NEXT = std::numeric_limits<size_t>::max();
+      std::unordered_map<T, size_t> heads;
+      heads.reserve(build_size);
+      std::vector<size_t> next(build_size, NO_NEXT);
+      // inserted from back to front, so that the chains keep the order of the right input
+      for (auto index = build_size; index-- > 0;) {
+        const auto [head, inserted] = heads.try_emplace(build_elements[index].value, index);
+        if (!inserted) {
+          next[index] = head->second;
+          head->second = index;
+        }
+      }
+
+      auto& result = joined_positions[partition_id];
+      result.left = std::make_shared<PosList>();
+      if (outputs_right_positions) result.right = std::make_shared<PosList>();
+
+      const auto probe_begin = left_partitions.elements.cbegin() + left_partitions.offsets[partition_id];
+      const auto probe_end = left_partitions.elements.cbegin() + left_partitions.offsets[partition_id + 1];
+      for (auto probe_element = probe_begin; probe_element != probe_end; ++probe_element) {
+        const auto head = heads.find(probe_element->value);
+        if (head == heads.end()) {
+          if (_mode == JoinMode::Left) {
+            result.left->push_back(probe_element->row_id);
+            result.right->push_back(NULL_ROW_ID);
+          } else if (_mode == JoinMode::Anti) {
+            result.left->push_back(probe_element->row_id);
+          }
+          continue;
+        }
+
+        if (_mode == JoinMode::Semi) {
+          result.left->push_back(probe_element->row_id);
+        } else if (outputs_right_positions) {
+          for (auto index = head->second; index != NO_NEXT; index = next[index]) {
+            result.left->push_back(probe_element->row_id);
+            result.right->push_back(build_elements[index].row_id);
+          }
+        }
+      }
+
+      // the partition keeps the order of the left input
+      result.left->guarantee_sorted();
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  // rows with a NULL key have no join partner
+  if ((_mode == JoinMode::Left || _mode == JoinMode::Anti) && !left_partitions.null_rows.empty()) {
+    auto null_key_positions = JoinedPositions{std::make_shared<PosList>(left_partitions.null_rows.cbegin(),
+                                                                        left_partitions.null_rows.cend()),
+                                              nullptr};
+    null_key_positions.left->guarantee_sorted();
+    if (_mode == JoinMode::Left) {
+      null_key_positions.right = std::make_shared<PosList>(left_partitions.null_rows.size(), NULL_ROW_ID);
+    }
+    joined_positions.push_back(null_key_positions);
+  }
+
+  return joined_positions;
+}
+
+}  // namespace opossum
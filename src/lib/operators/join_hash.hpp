@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "abstract_join_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Equi-join that builds a hash table on the right input and probes it with the left input.
+//
+// Both inputs are radix-partitioned by the hash of their join keys first, so that the hash table of each partition
+// of the right input fits into the L2 cache and the partitions can be joined independently. Materializing the keys
+// (chunk by chunk), scattering them into the partitions (chunk by chunk) as well as building and probing the hash
+// tables (partition by partition) runs in parallel on the ThreadPool. Each partition yields one output chunk.
+//
+// The join columns need to have the same data type. NULLs, i.e., NULL_ROW_IDs in a reference input, never match.
+class JoinHash : public AbstractJoinOperator {
+ public:
+  JoinHash(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
+           const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids);
+
+  // a partition of the right input should take at most this many bytes
+  static constexpr size_t PARTITION_TARGET_SIZE = 256 * 1024;
+
+  // the partitions are written at once, so their number is limited to keep the write positions in the cache and TLB
+  static constexpr size_t MAX_RADIX_BITS = 10;
+
+  // returns the number of bits of the hash that select the partition
+  static size_t radix_bits(const size_t build_row_count, const size_t element_size);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  template <typename T>
+  std::vector<JoinedPositions> _join(const Table& left_table, const Table& right_table) const;
+};
+
+}  // namespace opossum
@@ -0,0 +1,298 @@
+#include "join_sort_merge.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// the number of keys sampled per partition to choose the splitters between the partitions
+constexpr auto SAMPLES_PER_PARTITION = size_t{64};
+
+template <typename T>
+struct SortElement {
+  T value;
+  RowID row_id;
+};
+
+template <typename T>
+bool value_less(const SortElement<T>& lhs, const SortElement<T>& rhs) {
+  return lhs.value < rhs.value;
+}
+
+template <typename T>
+struct SortedColumn {
+  // the join keys in ascending order
+  std::vector<SortElement<T>> elements;
+  // the rows whose join key is NULL, which never match
+  std::vector<RowID> null_rows;
+};
+
+// materializes the join keys of the column and sorts them. Unless the chunks are sorted already, the keys are
+// scattered into ranges of values first, which are then sorted independently of each other.
+template <typename T>
+SortedColumn<T> sort_join_column(const Table& table, const ColumnID column_id) {
+  const auto chunk_count = table.chunk_count();
+
+  struct ChunkElements {
+    std::vector<SortElement<T>> elements;
+    std::vector<uint32_t> partition_ids;
+    std::vector<size_t> histogram;
+    std::vector<RowID> null_rows;
+    bool is_sorted = true;
+  };
+  std::vector<ChunkElements> chunk_elements(chunk_count);
+
+  materialize_join_column<T>(table, column_id, [&](const ChunkID chunk_id, std::vector<T>& values,
+                                               const PosList* positions) {
+    auto& result = chunk_elements[chunk_id];
+    result.elements.reserve(values.size());
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+      if (positions && (*positions)[chunk_offset] == NULL_ROW_ID) {
+        result.null_rows.push_back(RowID{chunk_id, chunk_offset});
+        continue;
+      }
+      result.elements.push_back(SortElement<T>{std::move(values[chunk_offset]), RowID{chunk_id, chunk_offset}});
+    }
+    result.is_sorted = std::is_sorted(result.elements.cbegin(), result.elements.cend(), value_less<T>);
+  });
+
+  // the input is sorted if every chunk is and each chunk starts with a value not smaller than the previous one ended
+  auto element_count = size_t{0};
+  auto is_sorted = true;
+  const SortElement<T>* previous_last_element = nullptr;
+  for (const auto& chunk_result : chunk_elements) {
+    if (chunk_result.elements.empty()) continue;
+    element_count += chunk_result.elements.size();
+    is_sorted &= chunk_result.is_sorted &&
+                 (!previous_last_element || !value_less(chunk_result.elements.front(), *previous_last_element));
+    previous_last_element = &chunk_result.elements.back();
+  }
+
+  // partition p holds the values in [splitters[p - 1], splitters[p]), the first and last partitions are unbounded
+  const auto partition_count = is_sorted ? size_t{1} : JoinSortMerge::partition_count(element_count);
+  std::vector<T> splitters;
+  if (partition_count > 1) {
+    std::vector<T> samples;
+    const auto sample_count = partition_count * SAMPLES_PER_PARTITION;
+    for (const auto& chunk_result : chunk_elements) {
+      const auto& elements = chunk_result.elements;
+      const auto chunk_sample_count = (elements.size() * sample_count + element_count - 1) / element_count;
+      for (auto sample_id = size_t{0}; sample_id < chunk_sample_count; ++sample_id) {
+        samples.push_back(elements[sample_id * elements.size() / chunk_sample_count].value);
+      }
+    }
+    std::sort(samples.begin(), samples.end());
+    for (auto partition_id = size_t{1}; partition_id < partition_count; ++partition_id) {
+      splitters.push_back(samples[partition_id * samples.size() / partition_count]);
+    }
+  }
+
+  std::vector<std::function<void()>> jobs;
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    auto& histogram = chunk_elements[chunk_id].histogram;
+    histogram.resize(partition_count);
+    if (partition_count == 1) {
+      histogram[0] = chunk_elements[chunk_id].elements.size();
+      continue;
+    }
+    jobs.emplace_back([&, chunk_id]() {
+      auto& chunk_result = chunk_elements[chunk_id];
+      chunk_result.partition_ids.reserve(chunk_result.elements.size());
+      for (const auto& element : chunk_result.elements) {
+        const auto partition_id = std::upper_bound(splitters.cbegin(), splitters.cend(), element.value) -
+                                  splitters.cbegin();
+        ++chunk_result.histogram[partition_id];
+        chunk_result.partition_ids.push_back(static_cast<uint32_t>(partition_id));
+      }
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  // in every partition, the elements of a chunk are written behind those of the previous chunks
+  std::vector<size_t> partition_offsets(partition_count + 1);
+  std::vector<std::vector<size_t>> write_positions(chunk_count, std::vector<size_t>(partition_count));
+  auto write_position = size_t{0};
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    partition_offsets[partition_id] = write_position;
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      write_positions[chunk_id][partition_id] = write_position;
+      write_position += chunk_elements[chunk_id].histogram[partition_id];
+    }
+  }
+  partition_offsets[partition_count] = write_position;
+
+  auto sorted_column = SortedColumn<T>{};
+  sorted_column.elements.resize(element_count);
+  jobs.clear();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back([&, chunk_id]() {
+      auto& chunk_result = chunk_elements[chunk_id];
+      auto& chunk_write_positions = write_positions[chunk_id];
+      for (auto index = size_t{0}; index < chunk_result.elements.size(); ++index) {
+        const auto partition_id = partition_count == 1 ? size_t{0} : chunk_result.partition_ids[index];
+        sorted_column.elements[chunk_write_positions[partition_id]++] = std::move(chunk_result.elements[index]);
+      }
+      chunk_result.elements = std::vector<SortElement<T>>{};
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  // each partition is sorted by one worker, which keeps its elements in the worker's cache and memory node
+  if (!is_sorted) {
+    jobs.clear();
+    for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+      jobs.emplace_back([&, partition_id]() {
+        std::sort(sorted_column.elements.begin() + partition_offsets[partition_id],
+                  sorted_column.elements.begin() + partition_offsets[partition_id + 1], value_less<T>);
+      });
+    }
+    ThreadPool::get().execute_and_wait(jobs);
+  }
+
+  for (const auto& chunk_result : chunk_elements) {
+    sorted_column.null_rows.insert(sorted_column.null_rows.end(), chunk_result.null_rows.cbegin(),
+                                   chunk_result.null_rows.cend());
+  }
+  return sorted_column;
+}
+
+}  // namespace
+
+JoinSortMerge::JoinSortMerge(const std::shared_ptr<const AbstractOperator> left,
+                             const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                             const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type)
+    : AbstractJoinOperator(left, right, mode, column_ids, scan_type) {}
+
+size_t JoinSortMerge::partition_count(const size_t row_count) {
+  return std::clamp(row_count / MIN_PARTITION_SIZE, size_t{1}, ThreadPool::get().worker_count());
+}
+
+std::shared_ptr<const Table> JoinSortMerge::_on_execute() {
+  const auto left_table = _input_table_left();
+  const auto right_table = _input_table_right();
+  Assert(_column_ids.first < left_table->column_count() && _column_ids.second < right_table->column_count(),
+         "Join column does not exist");
+  Assert(left_table->column_type(_column_ids.first) == right_table->column_type(_column_ids.second),
+         "Join columns need to have the same data type");
+
+  std::vector<JoinedPositions> joined_positions;
+  resolve_data_type(left_table->column_type(_column_ids.first), [&](auto type) {
+    using ColumnType = typename decltype(type)::type;
+    joined_positions = _join<ColumnType>(*left_table, *right_table);
+  });
+  return _build_output(joined_positions);
+}
+
+template <typename T>
+std::vector<AbstractJoinOperator::JoinedPositions> JoinSortMerge::_join(const Table& left_table,
+                                                                        const Table& right_table) const {
+  const auto left_column = sort_join_column<T>(left_table, _column_ids.first);
+  const auto right_column = sort_join_column<T>(right_table, _column_ids.second);
+  const auto& left_elements = left_column.elements;
+  const auto& right_elements = right_column.elements;
+  const auto outputs_right_positions = _mode == JoinMode::Inner || _mode == JoinMode::Left;
+
+  // every range of the left input is merged with the right input independently and results in one chunk
+  const auto merge_partition_count = partition_count(left_elements.size());
+  std::vector<JoinedPositions> joined_positions(merge_partition_count);
+  std::vector<std::function<void()>> jobs;
+  for (auto partition_id = size_t{0}; partition_id < merge_partition_count; ++partition_id) {
+    jobs.emplace_back([&, partition_id]() {
+      auto& result = joined_positions[partition_id];
+      result.left = std::make_shared<PosList>();
+      if (outputs_right_positions) result.right = std::make_shared<PosList>();
+
+      const auto begin = left_elements.cbegin() + partition_id * left_elements.size() / merge_partition_count;
+      const auto end = left_elements.cbegin() + (partition_id + 1) * left_elements.size() / merge_partition_count;
+      if (begin == end) return;
+
+      // [equal_begin, equal_end) are the right elements with the value of the current left element. As the left
+      // elements are sorted, both only move forward.
+      const auto right_begin = right_elements.cbegin();
+      const auto right_end = right_elements.cend();
+      auto equal_begin = std::lower_bound(right_begin, right_end, *begin, value_less<T>);
+      auto equal_end = std::upper_bound(equal_begin, right_end, *begin, value_less<T>);
+
+      for (auto left_element = begin; left_element != end; ++left_element) {
+        const auto& value = left_element->value;
+        while (equal_begin != right_end && equal_begin->value < value) ++equal_begin;
+        if (equal_end < equal_begin) equal_end = equal_begin;
+        while (equal_end != right_end && !(value < equal_end->value)) ++equal_end;
+
+        // the right elements that satisfy the predicate form one range, or two for !=
+        auto matches = std::make_pair(right_end, right_end);
+        auto more_matches = std::make_pair(right_end, right_end);
+        switch (_scan_type) {
+          case ScanType::OpEquals:
+            matches = {equal_begin, equal_end};
+            break;
+          case ScanType::OpNotEquals:
+            matches = {right_begin, equal_begin};
+            more_matches = {equal_end, right_end};
+            break;
+          case ScanType::OpLessThan:
+            matches = {equal_end, right_end};
+            break;
+          case ScanType::OpLessThanEquals:
+            matches = {equal_begin, right_end};
+            break;
+          case ScanType::OpGreaterThan:
+            matches = {right_begin, equal_begin};
+            break;
+          case ScanType::OpGreaterThanEquals:
+            matches = {right_begin, equal_end};
+            break;
+          default:
+            Fail("Columns can only be joined with =, !=, <, <=, > and >=");
+        }
+
+        if (matches.first == matches.second && more_matches.first == more_matches.second) {
+          if (_mode == JoinMode::Left) {
+            result.left->push_back(left_element->row_id);
+            result.right->push_back(NULL_ROW_ID);
+          } else if (_mode == JoinMode::Anti) {
+            result.left->push_back(left_element->row_id);
+          }
+          continue;
+        }
+
+        if (_mode == JoinMode::Semi) {
+          result.left->push_back(left_element->row_id);
+        } else if (outputs_right_positions) {
+          for (const auto& [first, last] : {matches, more_matches}) {
+            for (auto right_element = first; right_element != last; ++right_element) {
+              result.left->push_back(left_element->row_id);
+              result.right->push_back(right_element->row_id);
+            }
+          }
+        }
+      }
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  // rows with a NULL key have no join partner
+  if ((_mode == JoinMode::Left || _mode == JoinMode::Anti) && !left_column.null_rows.empty()) {
+    auto null_key_positions = JoinedPositions{
+        std::make_shared<PosList>(left_column.null_rows.cbegin(), left_column.null_rows.cend()), nullptr};
+    null_key_positions.left->guarantee_sorted();
+    if (_mode == JoinMode::Left) {
+      null_key_positions.right = std::make_shared<PosList>(left_column.null_rows.size(), NULL_ROW_ID);
+    }
+    joined_positions.push_back(null_key_positions);
+  }
+
+  return joined_positions;
+}
+
+}  // namespace opossum
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "abstract_join_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Join that sorts both inputs by their join keys and merges them. Unlike JoinHash, it supports the comparisons
+// =, !=, <, <=, > and >= of the left with the right column, e.g., to join events with time windows.
+//
+// The keys are materialized chunk by chunk in parallel. If every chunk of an input is sorted already and the chunks
+// follow each other in ascending order, the input is not sorted again. Otherwise, it is range-partitioned by
+// splitters sampled from the keys, so that each worker sorts one partition on its own and the concatenated partitions
+// are sorted as a whole. For the merge, the sorted left input is split into one range per worker. Each range finds
+// its start in the right input with a binary search and then advances through it. Each range yields one output chunk.
+//
+// The join columns need to have the same data type. NULLs, i.e., NULL_ROW_IDs in a reference input, never match.
+class JoinSortMerge : public AbstractJoinOperator {
+ public:
+  JoinSortMerge(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
+                const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type);
+
+  // inputs are only sorted and merged in parallel if every partition gets at least this many rows
+  static constexpr size_t MIN_PARTITION_SIZE = 10'000;
+
+  // returns the number of partitions in which an input of the given size is sorted and merged
+  static size_t partition_count(const size_t row_count);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  template <typename T>
+  std::vector<JoinedPositions> _join(const Table& left_table, const Table& right_table) const;
+};
+
+}  // namespace opossum
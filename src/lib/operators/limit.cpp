@@ -0,0 +1,68 @@
+#include "limit.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+Limit::Limit(const std::shared_ptr<AbstractOperator>& in, const size_t row_count,
+             const StopInputEarly stop_input_early)
+    : AbstractOperator(in), _row_count{row_count} {
+  // an input that already ran cannot stop early anymore
+  if (stop_input_early == StopInputEarly::Yes && !in->get_output()) in->set_output_row_limit(row_count);
+}
+
+size_t Limit::row_count() const { return _row_count; }
+
+std::shared_ptr<const Table> Limit::_on_execute() {
+  const auto input_table = _input_table_left();
+
+  auto output = std::make_shared<Table>(input_table->max_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  auto remaining_row_count = _row_count;
+  for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count() && remaining_row_count > 0; ++chunk_id) {
+    const auto& input_chunk = input_table->get_chunk(chunk_id);
+    const auto chunk_row_count = static_cast<ChunkOffset>(std::min(size_t{input_chunk.size()}, remaining_row_count));
+    if (chunk_row_count == 0) continue;
+    remaining_row_count -= chunk_row_count;
+
+    Chunk chunk;
+    const auto is_reference_chunk =
+        std::dynamic_pointer_cast<const ReferenceSegment>(input_chunk.get_segment(ColumnID{0})) != nullptr;
+    if (!is_reference_chunk) {
+      for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+        chunk.add_segment(std::make_shared<ReferenceSegment>(
+            input_table, column_id, ChunkRowRange{chunk_id, ChunkOffsetRange{0, chunk_row_count}}));
+      }
+    } else if (chunk_row_count == input_chunk.size()) {
+      for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+        chunk.add_segment(input_chunk.get_segment(column_id));
+      }
+    } else {
+      auto positions = std::make_shared<PosList>();
+      positions->reserve(chunk_row_count);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_row_count; ++chunk_offset) {
+        positions->push_back(RowID{chunk_id, chunk_offset});
+      }
+      _add_reference_segments(input_table, positions, chunk);
+    }
+    output->emplace_chunk(std::move(chunk));
+  }
+
+  // a table always holds at least one chunk, if no row is returned, it is an empty one with all columns
+  if (output->row_count() == 0) {
+    Chunk chunk;
+    _add_reference_segments(input_table, std::make_shared<PosList>(), chunk);
+    output->emplace_chunk(std::move(chunk));
+  }
+  return output;
+}
+
+}  // namespace opossum
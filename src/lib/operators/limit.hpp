@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Returns the first row_count rows of the input, i.e., LIMIT row_count. The output references the input: its chunks
+// are forwarded or referenced as a whole, only the last one is cut.
+//
+// Only the sole consumer of an operator's output may limit it (see AbstractOperator::set_output_row_limit). Whoever
+// builds the plan and knows that the Limit is that consumer can pass StopInputEarly::Yes, so that the Limit sets the
+// row limit of its input when it is constructed. The input then has to be constructed but not yet executed, and a
+// TableScan stops scanning once it found enough rows.
+class Limit : public AbstractOperator {
+ public:
+  enum class StopInputEarly { No, Yes };
+
+  Limit(const std::shared_ptr<AbstractOperator>& in, const size_t row_count,
+        const StopInputEarly stop_input_early = StopInputEarly::No);
+
+  size_t row_count() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const size_t _row_count;
+};
+
+}  // namespace opossum
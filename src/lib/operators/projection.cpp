@@ -0,0 +1,126 @@
+#include "projection.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expression/expression_evaluator.hpp"
+#include "expression/expressions.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+ProjectionColumnDefinition::ProjectionColumnDefinition(const std::shared_ptr<AbstractExpression>& expression,
+                                                       const std::optional<std::string>& name)
+    : expression{expression}, name{name} {}
+
+Projection::Projection(const std::shared_ptr<const AbstractOperator> in,
+                       const std::vector<ProjectionColumnDefinition>& columns)
+    : AbstractOperator(in), _columns{columns} {}
+
+const std::vector<ProjectionColumnDefinition>& Projection::columns() const { return _columns; }
+
+std::shared_ptr<const Table> Projection::_on_execute() {
+  const auto input_table = _input_table_left();
+
+  auto output = std::make_shared<Table>(input_table->max_chunk_size());
+  // the table that holds the values of the computed columns, whose ids in there are stored for the output columns
+  auto computed_table = std::make_shared<Table>();
+  std::vector<std::optional<ColumnID>> computed_column_ids;
+  std::vector<const AbstractExpression*> computed_expressions;
+  for (const auto& column : _columns) {
+    Assert(column.expression, "Projection columns need an expression");
+    const auto name = column.name ? *column.name : column.expression->description(*input_table);
+    const auto data_type = column.expression->data_type(*input_table);
+    output->add_column_definition(name, data_type);
+    if (dynamic_cast<const ColumnExpression*>(column.expression.get())) {
+      computed_column_ids.emplace_back(std::nullopt);
+      continue;
+    }
+    computed_column_ids.emplace_back(ColumnID{static_cast<ColumnID::base_type>(computed_expressions.size())});
+    computed_table->add_column_definition(name, data_type);
+    computed_expressions.push_back(column.expression.get());
+  }
+
+  // computes the values of the computed columns for all chunks, together with the rows for which they are NULL
+  const auto chunk_count = static_cast<size_t>(input_table->chunk_count());
+  std::vector<Chunk> computed_chunks(chunk_count);
+  std::vector<std::vector<std::vector<uint8_t>>> computed_is_null(
+      chunk_count, std::vector<std::vector<uint8_t>>(computed_expressions.size()));
+  if (!computed_expressions.empty()) {
+    const auto job_count = std::max(size_t{1}, std::min(chunk_count, ThreadPool::get().worker_count()));
+    std::vector<std::function<void()>> jobs;
+    for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+      jobs.emplace_back([&, job_id]() {
+        const auto chunk_id_begin = ChunkID{static_cast<ChunkID::base_type>(job_id * chunk_count / job_count)};
+        const auto chunk_id_end = ChunkID{static_cast<ChunkID::base_type>((job_id + 1) * chunk_count / job_count)};
+        for (auto chunk_id = chunk_id_begin; chunk_id < chunk_id_end; ++chunk_id) {
+          if (input_table->get_chunk(chunk_id).size() == 0) continue;
+          const auto evaluator = ExpressionEvaluator{*input_table, chunk_id};
+          for (auto expression_id = size_t{0}; expression_id < computed_expressions.size(); ++expression_id) {
+            computed_chunks[chunk_id].add_segment(evaluator.evaluate_to_segment(
+                *computed_expressions[expression_id], computed_is_null[chunk_id][expression_id]));
+          }
+        }
+      });
+    }
+    ThreadPool::get().execute_and_wait(jobs);
+  }
+
+  // the id of the chunk of computed values for every input chunk. Empty chunks have none.
+  std::vector<ChunkID> computed_chunk_ids(chunk_count, INVALID_CHUNK_ID);
+  auto computed_chunk_count = ChunkID{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (computed_expressions.empty() || computed_chunks[chunk_id].size() == 0) continue;
+    computed_table->emplace_chunk(std::move(computed_chunks[chunk_id]));
+    computed_chunk_ids[chunk_id] = computed_chunk_count++;
+  }
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto& input_chunk = input_table->get_chunk(chunk_id);
+    const auto rows = ChunkOffsetRange{0, input_chunk.size()};
+    Chunk chunk;
+    for (auto column_id = ColumnID{0}; column_id < _columns.size(); ++column_id) {
+      if (!computed_column_ids[column_id]) {
+        const auto input_column_id = static_cast<const ColumnExpression&>(*_columns[column_id].expression).column_id();
+        const auto segment = input_chunk.get_segment(input_column_id);
+        if (std::dynamic_pointer_cast<const ReferenceSegment>(segment)) {
+          chunk.add_segment(segment);
+        } else {
+          chunk.add_segment(
+              std::make_shared<ReferenceSegment>(input_table, input_column_id, ChunkRowRange{chunk_id, rows}));
+        }
+        continue;
+      }
+
+      const auto computed_column_id = *computed_column_ids[column_id];
+      const auto computed_chunk_id = computed_chunk_ids[chunk_id];
+      const auto& is_null = computed_is_null[chunk_id][computed_column_id];
+      if (computed_chunk_id == INVALID_CHUNK_ID) {
+        chunk.add_segment(std::make_shared<ReferenceSegment>(computed_table, computed_column_id,
+                                                             std::make_shared<PosList>()));
+      } else if (is_null.empty()) {
+        chunk.add_segment(std::make_shared<ReferenceSegment>(computed_table, computed_column_id,
+                                                             ChunkRowRange{computed_chunk_id, rows}));
+      } else {
+        auto positions = std::make_shared<PosList>(input_chunk.size());
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < input_chunk.size(); ++chunk_offset) {
+          (*positions)[chunk_offset] = is_null[chunk_offset] ? NULL_ROW_ID : RowID{computed_chunk_id, chunk_offset};
+        }
+        chunk.add_segment(std::make_shared<ReferenceSegment>(computed_table, computed_column_id, positions));
+      }
+    }
+    output->emplace_chunk(std::move(chunk));
+  }
+
+  return output;
+}
+
+}  // namespace opossum
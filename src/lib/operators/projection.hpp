@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "expression/abstract_expression.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// an expression computed for every row of the input, named by its description if no name is given
+struct ProjectionColumnDefinition {
+  ProjectionColumnDefinition(const std::shared_ptr<AbstractExpression>& expression,
+                             const std::optional<std::string>& name = std::nullopt);
+
+  std::shared_ptr<AbstractExpression> expression;
+  std::optional<std::string> name;
+};
+
+// Computes one output column per expression for every row of the input, e.g., SELECT a * (1 - b) AS revenue. The
+// output has the chunks of the input and consists of ReferenceSegments:
+//  - a column that only refers to a column of the input forwards its segments: ReferenceSegments of the input are
+//    used as they are, other segments are referenced by the range of rows of their chunk.
+//  - the values of other expressions are computed chunk by chunk with the ExpressionEvaluator and stored in a table
+//    of their own, which the output references. Rows for which the expression is NULL reference NULL_ROW_ID.
+// The columns of an output chunk can thus reference different tables, which a TableScan on the output resolves per
+// column. Chunks are processed in parallel, one range of chunks per worker.
+class Projection : public AbstractOperator {
+ public:
+  Projection(const std::shared_ptr<const AbstractOperator> in, const std::vector<ProjectionColumnDefinition>& columns);
+
+  const std::vector<ProjectionColumnDefinition>& columns() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<ProjectionColumnDefinition> _columns;
+};
+
+}  // namespace opossum
@@ -0,0 +1,557 @@
+#include "sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// the sort keys of one column for the rows of a run
+struct SortColumnKeys {
+  bool descending = false;
+  // if set, the keys are in strings, otherwise in normalized_keys
+  bool uses_strings = false;
+  // keys that compare like the values in the sort order (including its direction) as unsigned integers. Only their
+  // lowest key_bytes bytes can differ.
+  std::vector<uint64_t> normalized_keys;
+  size_t key_bytes = 0;
+  std::vector<std::string> strings;
+  // 1 for the rows that are NULL, empty if the column cannot contain NULLs
+  std::vector<uint8_t> is_null;
+};
+
+// returns a key that compares like the value as an unsigned integer
+template <typename T>
+uint64_t normalized_key(T value) {
+  if constexpr (std::is_integral_v<T>) {
+    using UnsignedType = std::make_unsigned_t<T>;
+    // flipping the sign bit moves the negative values below the positive ones
+    return static_cast<UnsignedType>(value) ^ (UnsignedType{1} << (sizeof(T) * 8 - 1));
+  } else {
+    using BitsType = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    // -0.0 and 0.0 are equal, but differ in their bits
+    if (value == T{0}) value = T{0};
+    auto bits = BitsType{0};
+    std::memcpy(&bits, &value, sizeof(T));
+    // the bits of negative values grow with their magnitude, so all of them are flipped, and the sign bit of positive
+    // values is set to move them above the negative ones
+    const auto sign_bit = BitsType{1} << (sizeof(T) * 8 - 1);
+    return (bits & sign_bit) ? static_cast<BitsType>(~bits) : bits | sign_bit;
+  }
+}
+
+// splits [0, size) into block_count blocks and calls functor(block_id, begin, end) for all of them in parallel
+template <typename Functor>
+void for_each_block(const size_t size, const size_t block_count, const Functor& functor) {
+  if (block_count == 1) {
+    functor(size_t{0}, size_t{0}, size);
+    return;
+  }
+  std::vector<std::function<void()>> jobs;
+  for (auto block_id = size_t{0}; block_id < block_count; ++block_id) {
+    jobs.emplace_back([&, block_id]() {
+      functor(block_id, block_id * size / block_count, (block_id + 1) * size / block_count);
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+}
+
+size_t block_count(const size_t size) {
+  return std::clamp(size / Sort::MIN_PARALLEL_SORT_SIZE, size_t{1}, ThreadPool::get().worker_count());
+}
+
+// stably sorts the rows by their normalized keys with a least significant digit radix sort over their bytes. Each
+// pass counts the digits per block of rows and then scatters the blocks in parallel.
+void radix_sort(std::vector<uint32_t>& rows, const std::vector<uint64_t>& normalized_keys, const size_t key_bytes) {
+  constexpr auto DIGIT_BITS = size_t{8};
+  constexpr auto DIGIT_COUNT = size_t{1} << DIGIT_BITS;
+  const auto row_count = rows.size();
+  const auto blocks = block_count(row_count);
+
+  // the keys are kept next to the rows, so that they are read sequentially in every pass
+  std::vector<uint64_t> keys(row_count);
+  for_each_block(row_count, blocks, [&](const size_t, const size_t begin, const size_t end) {
+    for (auto index = begin; index < end; ++index) keys[index] = normalized_keys[rows[index]];
+  });
+  std::vector<uint64_t> scattered_keys(row_count);
+  std::vector<uint32_t> scattered_rows(row_count);
+
+  std::vector<std::array<size_t, DIGIT_COUNT>> histograms(blocks);
+  for (auto digit_id = size_t{0}; digit_id < key_bytes; ++digit_id) {
+    const auto shift = digit_id * DIGIT_BITS;
+    for_each_block(row_count, blocks, [&](const size_t block_id, const size_t begin, const size_t end) {
+      auto& histogram = histograms[block_id];
+      histogram.fill(0);
+      for (auto index = begin; index < end; ++index) ++histogram[(keys[index] >> shift) & (DIGIT_COUNT - 1)];
+    });
+
+    // block b writes its rows with digit d behind those with smaller digits and those of the blocks before b with d
+    auto write_position = size_t{0};
+    auto pass_changes_order = true;
+    for (auto digit = size_t{0}; digit < DIGIT_COUNT; ++digit) {
+      const auto digit_begin = write_position;
+      for (auto& histogram : histograms) {
+        const auto count = histogram[digit];
+        histogram[digit] = write_position;
+        write_position += count;
+      }
+      if (write_position - digit_begin == row_count) pass_changes_order = false;
+    }
+    if (!pass_changes_order) continue;
+
+    for_each_block(row_count, blocks, [&](const size_t block_id, const size_t begin, const size_t end) {
+      auto& write_positions = histograms[block_id];
+      for (auto index = begin; index < end; ++index) {
+        const auto position = write_positions[(keys[index] >> shift) & (DIGIT_COUNT - 1)]++;
+        scattered_keys[position] = keys[index];
+        scattered_rows[position] = rows[index];
+      }
+    });
+    std::swap(keys, scattered_keys);
+    std::swap(rows, scattered_rows);
+  }
+}
+
+// stably sorts the rows with a merge sort: the blocks are sorted in parallel and then merged pairwise in parallel
+template <typename Less>
+void merge_sort(std::vector<uint32_t>& rows, const Less& less) {
+  const auto row_count = rows.size();
+  const auto blocks = block_count(row_count);
+  for_each_block(row_count, blocks, [&](const size_t, const size_t begin, const size_t end) {
+    std::stable_sort(rows.begin() + begin, rows.begin() + end, less);
+  });
+
+  const auto block_begin = [&](const size_t block_id) { return std::min(block_id, blocks) * row_count / blocks; };
+  std::vector<uint32_t> merged_rows(row_count);
+  for (auto merged_blocks = size_t{1}; merged_blocks < blocks; merged_blocks *= 2) {
+    std::vector<std::function<void()>> jobs;
+    for (auto first_block = size_t{0}; first_block < blocks; first_block += 2 * merged_blocks) {
+      jobs.emplace_back([&, first_block]() {
+        const auto begin = block_begin(first_block);
+        const auto middle = block_begin(first_block + merged_blocks);
+        const auto end = block_begin(first_block + 2 * merged_blocks);
+        std::merge(rows.cbegin() + begin, rows.cbegin() + middle, rows.cbegin() + middle, rows.cbegin() + end,
+                   merged_rows.begin() + begin, less);
+      });
+    }
+    ThreadPool::get().execute_and_wait(jobs);
+    std::swap(rows, merged_rows);
+  }
+}
+
+// returns the order of the rows of a run by all sort columns. The columns are sorted from the least to the most
+// significant one, each time stably.
+std::vector<uint32_t> sort_run(const std::vector<SortColumnKeys>& sort_columns, const size_t row_count) {
+  std::vector<uint32_t> order(row_count);
+  std::iota(order.begin(), order.end(), uint32_t{0});
+
+  for (auto column = sort_columns.crbegin(); column != sort_columns.crend(); ++column) {
+    // NULLs come first in ascending and last in descending order, only the other rows need to be sorted
+    auto non_null_rows = std::vector<uint32_t>{};
+    auto null_rows = std::vector<uint32_t>{};
+    if (column->is_null.empty()) {
+      std::swap(non_null_rows, order);
+    } else {
+      for (const auto row : order) (column->is_null[row] ? null_rows : non_null_rows).push_back(row);
+    }
+
+    if (column->uses_strings) {
+      const auto& strings = column->strings;
+      if (column->descending) {
+        merge_sort(non_null_rows, [&](const uint32_t lhs, const uint32_t rhs) { return strings[rhs] < strings[lhs]; });
+      } else {
+        merge_sort(non_null_rows, [&](const uint32_t lhs, const uint32_t rhs) { return strings[lhs] < strings[rhs]; });
+      }
+    } else {
+      radix_sort(non_null_rows, column->normalized_keys, column->key_bytes);
+    }
+
+    if (column->is_null.empty()) {
+      std::swap(order, non_null_rows);
+    } else {
+      order.clear();
+      const auto& first_rows = column->descending ? non_null_rows : null_rows;
+      const auto& last_rows = column->descending ? null_rows : non_null_rows;
+      order.insert(order.end(), first_rows.cbegin(), first_rows.cend());
+      order.insert(order.end(), last_rows.cbegin(), last_rows.cend());
+    }
+  }
+  return order;
+}
+
+// the rows of a run are the rows of consecutive chunks
+struct Run {
+  ChunkID chunk_id_begin;
+  ChunkID chunk_id_end;
+  size_t row_count;
+};
+
+// materializes the keys of the column for the rows of the run. Ranks of dictionary values are only comparable within
+// the run, so they are not used if runs are merged afterwards.
+SortColumnKeys materialize_sort_keys(const Table& table, const Run& run, const SortColumnDefinition& definition,
+                                     const bool use_dictionary_ranks) {
+  auto keys = SortColumnKeys{};
+  keys.descending = definition.order_by_mode == OrderByMode::Descending;
+
+  // the position of the first row of each chunk within the run
+  std::vector<size_t> run_offsets;
+  auto row_count = size_t{0};
+  auto is_nullable = false;
+  auto is_dictionary_encoded = true;
+  for (auto chunk_id = run.chunk_id_begin; chunk_id < run.chunk_id_end; ++chunk_id) {
+    run_offsets.push_back(row_count);
+    const auto& chunk = table.get_chunk(chunk_id);
+    row_count += chunk.size();
+    if (chunk.size() == 0) continue;
+    const auto& segment = *chunk.get_segment(definition.column_id);
+    is_nullable |= nullable_positions(segment) != nullptr;
+    is_dictionary_encoded &= dynamic_cast<const DictionarySegment<std::string>*>(&segment) != nullptr;
+  }
+  if (is_nullable) keys.is_null.resize(row_count);
+
+  // calls functor(chunk, segment, run_offset) for every non-empty chunk of the run in parallel
+  const auto for_each_chunk = [&](const auto& functor) {
+    std::vector<std::function<void()>> jobs;
+    for (auto chunk_id = run.chunk_id_begin; chunk_id < run.chunk_id_end; ++chunk_id) {
+      if (table.get_chunk(chunk_id).size() == 0) continue;
+      jobs.emplace_back([&, chunk_id]() {
+        const auto& chunk = table.get_chunk(chunk_id);
+        const auto& segment = *chunk.get_segment(definition.column_id);
+        const auto run_offset = run_offsets[chunk_id - run.chunk_id_begin];
+        if (const auto positions = nullable_positions(segment)) {
+          for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+            keys.is_null[run_offset + chunk_offset] = (*positions)[chunk_offset] == NULL_ROW_ID;
+          }
+        }
+        functor(chunk, segment, run_offset);
+      });
+    }
+    ThreadPool::get().execute_and_wait(jobs);
+  };
+
+  const auto& column_type = table.column_type(definition.column_id);
+  if (column_type == "string" && !(use_dictionary_ranks && is_dictionary_encoded)) {
+    keys.uses_strings = true;
+    keys.strings.resize(row_count);
+    for_each_chunk([&](const Chunk& chunk, const BaseSegment& segment, const size_t run_offset) {
+      materialize_values(segment, ChunkOffsetRange{0, chunk.size()}, keys.strings.data() + run_offset);
+    });
+    return keys;
+  }
+
+  keys.normalized_keys.resize(row_count);
+  if (column_type == "string") {
+    // all values of the dictionaries, sorted, the rank of a value is its position in there
+    std::vector<std::string> values;
+    std::vector<const std::vector<std::string>*> dictionaries;
+    for (auto chunk_id = run.chunk_id_begin; chunk_id < run.chunk_id_end; ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      if (chunk.size() == 0) continue;
+      const auto segment = chunk.get_segment(definition.column_id);
+      const auto* const dictionary = static_cast<const DictionarySegment<std::string>&>(*segment).dictionary().get();
+      // chunks may share their dictionary
+      if (std::find(dictionaries.cbegin(), dictionaries.cend(), dictionary) != dictionaries.cend()) continue;
+      dictionaries.push_back(dictionary);
+      values.insert(values.end(), dictionary->cbegin(), dictionary->cend());
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    keys.key_bytes = 1;
+    while (keys.key_bytes < sizeof(uint32_t) && (values.size() - 1) >> (keys.key_bytes * 8) != 0) ++keys.key_bytes;
+    const auto rank_mask = keys.descending ? (uint64_t{1} << (keys.key_bytes * 8)) - 1 : uint64_t{0};
+
+    for_each_chunk([&](const Chunk& chunk, const BaseSegment& segment, const size_t run_offset) {
+      const auto& dictionary_segment = static_cast<const DictionarySegment<std::string>&>(segment);
+      const auto& dictionary = *dictionary_segment.dictionary();
+      // both are sorted, so the ranks of the dictionary are found in a single pass over the values
+      std::vector<uint64_t> ranks(dictionary.size());
+      auto value = values.cbegin();
+      for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+        while (*value < dictionary[value_id]) ++value;
+        ranks[value_id] = static_cast<uint64_t>(value - values.cbegin()) ^ rank_mask;
+      }
+      dictionary_segment.with_value_ids([&](const auto* const value_ids) {
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+          keys.normalized_keys[run_offset + chunk_offset] = ranks[value_ids[chunk_offset]];
+        }
+      });
+    });
+    return keys;
+  }
+
+  resolve_data_type(column_type, [&](auto type) {
+    using ColumnType = typename decltype(type)::type;
+    if constexpr (std::is_arithmetic_v<ColumnType>) {
+      keys.key_bytes = sizeof(ColumnType);
+      const auto key_mask =
+          keys.key_bytes == sizeof(uint64_t) ? ~uint64_t{0} : (uint64_t{1} << (keys.key_bytes * 8)) - 1;
+      // descending keys are the complement of the ascending ones
+      const auto flip_mask = keys.descending ? key_mask : uint64_t{0};
+      for_each_chunk([&](const Chunk& chunk, const BaseSegment& segment, const size_t run_offset) {
+        std::vector<ColumnType> values(chunk.size());
+        materialize_values(segment, ChunkOffsetRange{0, chunk.size()}, values.data());
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+          keys.normalized_keys[run_offset + chunk_offset] = normalized_key(values[chunk_offset]) ^ flip_mask;
+        }
+      });
+    }
+  });
+  return keys;
+}
+
+// the row ids of the rows of a run, in the order of the run
+std::vector<RowID> run_row_ids(const Table& table, const Run& run) {
+  std::vector<RowID> row_ids;
+  row_ids.reserve(run.row_count);
+  for (auto chunk_id = run.chunk_id_begin; chunk_id < run.chunk_id_end; ++chunk_id) {
+    const auto chunk_size = table.get_chunk(chunk_id).size();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      row_ids.push_back(RowID{chunk_id, chunk_offset});
+    }
+  }
+  return row_ids;
+}
+
+// a row of a run that was written to a file, with its sort keys
+struct SpilledRow {
+  RowID row_id;
+  std::vector<uint64_t> normalized_keys;
+  std::vector<std::string> strings;
+  std::vector<uint8_t> is_null;
+};
+
+// a temporary file, which is deleted once it is closed
+using RunFile = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+RunFile write_run(const std::vector<SortColumnKeys>& sort_columns, const std::vector<RowID>& row_ids,
+                  const std::vector<uint32_t>& order) {
+  auto file = RunFile{std::tmpfile(), &std::fclose};
+  Assert(file, "Could not create a file to spill the sort run to");
+  const auto write = [&](const void* data, const size_t size) {
+    Assert(std::fwrite(data, 1, size, file.get()) == size, "Could not write the sort run");
+  };
+
+  for (const auto row : order) {
+    write(&row_ids[row], sizeof(RowID));
+    for (const auto& column : sort_columns) {
+      const auto is_null = uint8_t{!column.is_null.empty() && column.is_null[row]};
+      write(&is_null, sizeof(is_null));
+      if (is_null) continue;
+      if (column.uses_strings) {
+        const auto& string = column.strings[row];
+        const auto length = static_cast<uint32_t>(string.size());
+        write(&length, sizeof(length));
+        write(string.data(), length);
+      } else {
+        write(&column.normalized_keys[row], sizeof(uint64_t));
+      }
+    }
+  }
+  std::rewind(file.get());
+  return file;
+}
+
+// reads the next row of the run into row, returns false if there is none
+bool read_row(std::FILE* file, const std::vector<SortColumnKeys>& sort_columns, SpilledRow& row) {
+  const auto read = [&](void* data, const size_t size) {
+    Assert(std::fread(data, 1, size, file) == size, "Could not read the sort run");
+  };
+
+  if (std::fread(&row.row_id, 1, sizeof(RowID), file) != sizeof(RowID)) return false;
+  const auto column_count = sort_columns.size();
+  row.normalized_keys.resize(column_count);
+  row.strings.resize(column_count);
+  row.is_null.resize(column_count);
+  for (auto column_id = size_t{0}; column_id < column_count; ++column_id) {
+    read(&row.is_null[column_id], sizeof(uint8_t));
+    if (row.is_null[column_id]) continue;
+    if (sort_columns[column_id].uses_strings) {
+      auto length = uint32_t{0};
+      read(&length, sizeof(length));
+      row.strings[column_id].resize(length);
+      read(row.strings[column_id].data(), length);
+    } else {
+      read(&row.normalized_keys[column_id], sizeof(uint64_t));
+    }
+  }
+  return true;
+}
+
+bool spilled_row_less(const std::vector<SortColumnKeys>& sort_columns, const SpilledRow& lhs, const SpilledRow& rhs) {
+  for (auto column_id = size_t{0}; column_id < sort_columns.size(); ++column_id) {
+    const auto& column = sort_columns[column_id];
+    if (lhs.is_null[column_id] || rhs.is_null[column_id]) {
+      if (lhs.is_null[column_id] == rhs.is_null[column_id]) continue;
+      // NULLs come first in ascending and last in descending order
+      return column.descending ? rhs.is_null[column_id] : lhs.is_null[column_id];
+    }
+    if (column.uses_strings) {
+      const auto& lhs_string = lhs.strings[column_id];
+      const auto& rhs_string = rhs.strings[column_id];
+      if (lhs_string == rhs_string) continue;
+      return column.descending ? rhs_string < lhs_string : lhs_string < rhs_string;
+    }
+    if (lhs.normalized_keys[column_id] != rhs.normalized_keys[column_id]) {
+      return lhs.normalized_keys[column_id] < rhs.normalized_keys[column_id];
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+SortColumnDefinition::SortColumnDefinition(const ColumnID column_id, const OrderByMode order_by_mode)
+    : column_id{column_id}, order_by_mode{order_by_mode} {}
+
+Sort::Sort(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const ForceMaterialization force_materialization, const size_t memory_limit)
+    : AbstractOperator(in),
+      _sort_definitions{sort_definitions},
+      _force_materialization{force_materialization},
+      _memory_limit{memory_limit} {}
+
+const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
+
+std::shared_ptr<const Table> Sort::_on_execute() {
+  const auto input_table = _input_table_left();
+
+  // the memory a row takes while it is sorted: its row id, its position in the order and the buffers of the sorts
+  auto row_size = sizeof(RowID) + 2 * sizeof(uint32_t);
+  for (const auto& definition : _sort_definitions) {
+    Assert(definition.column_id < input_table->column_count(), "Sort column does not exist");
+    const auto is_string_column = input_table->column_type(definition.column_id) == "string";
+    row_size += sizeof(uint8_t) + (is_string_column ? sizeof(std::string) : 3 * sizeof(uint64_t));
+  }
+  const auto run_row_limit = std::max(_memory_limit / row_size, size_t{1});
+
+  // every run gets as many chunks as fit into the memory limit, but at least one
+  std::vector<Run> runs;
+  for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+    const auto chunk_size = input_table->get_chunk(chunk_id).size();
+    if (runs.empty() || runs.back().row_count + chunk_size > run_row_limit) {
+      runs.push_back(Run{chunk_id, chunk_id, 0});
+    }
+    runs.back().chunk_id_end = ChunkID{chunk_id + 1};
+    runs.back().row_count += chunk_size;
+  }
+
+  const auto sort_keys = [&](const Run& run, const bool use_dictionary_ranks) {
+    std::vector<SortColumnKeys> sort_columns;
+    for (const auto& definition : _sort_definitions) {
+      sort_columns.push_back(materialize_sort_keys(*input_table, run, definition, use_dictionary_ranks));
+    }
+    return sort_columns;
+  };
+
+  auto positions = std::make_shared<PosList>();
+  positions->reserve(input_table->row_count());
+  if (runs.size() <= 1) {
+    if (!runs.empty()) {
+      const auto sort_columns = sort_keys(runs.front(), true);
+      const auto row_ids = run_row_ids(*input_table, runs.front());
+      for (const auto row : sort_run(sort_columns, row_ids.size())) positions->push_back(row_ids[row]);
+    }
+  } else {
+    std::vector<RunFile> run_files;
+    std::vector<SortColumnKeys> sort_columns;
+    for (const auto& run : runs) {
+      sort_columns = sort_keys(run, false);
+      const auto order = sort_run(sort_columns, run.row_count);
+      run_files.push_back(write_run(sort_columns, run_row_ids(*input_table, run), order));
+    }
+
+    // merges the runs by always taking the smallest of their next rows, of the earliest run if several are equal
+    std::vector<SpilledRow> next_rows(runs.size());
+    const auto run_after = [&](const size_t lhs, const size_t rhs) {
+      if (spilled_row_less(sort_columns, next_rows[rhs], next_rows[lhs])) return true;
+      if (spilled_row_less(sort_columns, next_rows[lhs], next_rows[rhs])) return false;
+      return lhs > rhs;
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(run_after)> queue(run_after);
+    for (auto run_id = size_t{0}; run_id < runs.size(); ++run_id) {
+      if (read_row(run_files[run_id].get(), sort_columns, next_rows[run_id])) queue.push(run_id);
+    }
+    while (!queue.empty()) {
+      const auto run_id = queue.top();
+      queue.pop();
+      positions->push_back(next_rows[run_id].row_id);
+      if (read_row(run_files[run_id].get(), sort_columns, next_rows[run_id])) queue.push(run_id);
+    }
+  }
+
+  auto output = std::make_shared<Table>(input_table->max_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  // data segments cannot hold NULLs, so an input with NULLs stays referenced even if materialization is forced
+  const auto has_nulls = [&]() {
+    for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+      const auto& input_chunk = input_table->get_chunk(chunk_id);
+      for (auto column_id = ColumnID{0}; column_id < input_chunk.column_count(); ++column_id) {
+        const auto positions = nullable_positions(*input_chunk.get_segment(column_id));
+        if (positions && std::find(positions->cbegin(), positions->cend(), NULL_ROW_ID) != positions->cend()) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+  const auto materialize = _force_materialization == ForceMaterialization::Yes && !has_nulls();
+
+  const auto add_chunk = [&](const std::shared_ptr<const PosList>& chunk_positions) {
+    Chunk chunk;
+    _add_reference_segments(input_table, chunk_positions, chunk);
+    if (!materialize) {
+      output->emplace_chunk(std::move(chunk));
+      return;
+    }
+
+    Chunk materialized_chunk;
+    for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using ColumnType = typename decltype(type)::type;
+        std::vector<ColumnType> values(chunk.size());
+        materialize_values(*chunk.get_segment(column_id), ChunkOffsetRange{0, chunk.size()}, values.data());
+        materialized_chunk.add_segment(std::make_shared<ValueSegment<ColumnType>>(std::move(values)));
+      });
+    }
+    output->emplace_chunk(std::move(materialized_chunk));
+  };
+
+  const auto output_chunk_size =
+      input_table->max_chunk_size() == 0 ? positions->size() : size_t{input_table->max_chunk_size()};
+  for (auto begin = size_t{0}; begin < positions->size(); begin += output_chunk_size) {
+    const auto end = std::min(begin + output_chunk_size, positions->size());
+    if (begin == 0 && end == positions->size()) {
+      add_chunk(positions);
+    } else {
+      add_chunk(std::make_shared<PosList>(positions->cbegin() + begin, positions->cbegin() + end));
+    }
+  }
+  if (positions->empty()) add_chunk(positions);
+
+  return output;
+}
+
+}  // namespace opossum
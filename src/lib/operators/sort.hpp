@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+struct SortColumnDefinition {
+  explicit SortColumnDefinition(const ColumnID column_id, const OrderByMode order_by_mode = OrderByMode::Ascending);
+
+  ColumnID column_id;
+  OrderByMode order_by_mode;
+};
+
+// Sorts the rows of the input by the given columns, the first one being the most significant. Rows that are equal in
+// all of them keep their order. The output references the rows of the input, or holds their values if materialization
+// is forced and the input has no NULLs, which data segments cannot hold. Its chunks have the maximum chunk size of the
+// input.
+//
+// The columns are sorted one after the other, from the least to the most significant one, each time stably reordering
+// the permutation of the rows. Numeric values are sorted with a parallel LSD radix sort on keys that compare like the
+// values as unsigned integers. If all chunks of a string column are DictionarySegments, their values are replaced by
+// their rank among the values of all dictionaries, which is radix-sorted as well. Other strings are sorted with a
+// parallel merge sort.
+//
+// The sort keys are materialized in memory. If they need more than memory_limit bytes, the input is split into runs
+// of chunks that stay below that limit. Each run is sorted on its own and written to a temporary file, and the runs
+// are merged from these files afterwards.
+class Sort : public AbstractOperator {
+ public:
+  enum class ForceMaterialization { No, Yes };
+
+  Sort(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const ForceMaterialization force_materialization = ForceMaterialization::No,
+       const size_t memory_limit = DEFAULT_MEMORY_LIMIT);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+
+  static constexpr size_t DEFAULT_MEMORY_LIMIT = size_t{4} * 1024 * 1024 * 1024;
+
+  // the number of rows up to which a sort runs on a single thread
+  static constexpr size_t MIN_PARALLEL_SORT_SIZE = 64 * 1024;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const ForceMaterialization _force_materialization;
+  const size_t _memory_limit;
+};
+
+}  // namespace opossum
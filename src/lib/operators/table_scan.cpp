@@ -1,32 +1,77 @@
 #include <storage/table.hpp>
-#include <storage/value_segment.hpp>
-#include <storage/dictionary_segment.hpp>
+#include <storage/position_bitmap.hpp>
 #include <storage/reference_segment.hpp>
+#include <storage/segment_accessor.hpp>
+#include <storage/value_segment.hpp>
 #include <resolve_type.hpp>
 #include <operators/table_scan.hpp>
+#include <operators/table_scan/column_comparison_table_scan_impl.hpp>
+#include <operators/table_scan/column_vs_value_table_scan_impl.hpp>
+#include <scheduler/thread_pool.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace opossum {
 
 TableScan::TableScan(const std::shared_ptr<const AbstractOperator> in, ColumnID column_id,
-                     const ScanType scan_type, const AllTypeVariant search_value):
-  _in{in},
-  _column_id{column_id},
-  _scan_type{scan_type},
-  _search_value{search_value} {}
+                     const ScanType scan_type, const AllTypeVariant search_value,
+                     const std::optional<AllTypeVariant> search_value2):
+  TableScan(in, std::vector<ScanPredicate>{ScanPredicate{column_id, scan_type, search_value, search_value2}}) {}
+
+TableScan::TableScan(const std::shared_ptr<const AbstractOperator> in, const ColumnID column_id,
+                     const std::vector<AllTypeVariant> in_values):
+  TableScan(in, std::vector<ScanPredicate>{ScanPredicate{column_id, ScanType::OpIn, AllTypeVariant{}, std::nullopt,
+                                                         in_values}}) {}
+
+TableScan::TableScan(const std::shared_ptr<const AbstractOperator> in, const ColumnID left_column_id,
+                     const ScanType scan_type, const ColumnID right_column_id):
+  TableScan(in, std::vector<ScanPredicate>{ScanPredicate{left_column_id, scan_type, AllTypeVariant{}, std::nullopt, {},
+                                                         right_column_id}}) {}
+
+TableScan::TableScan(const std::shared_ptr<const AbstractOperator> in, const std::vector<ScanPredicate> predicates):
+  AbstractOperator(in),
+  _predicates{predicates} {
+  Assert(!_predicates.empty(), "TableScan needs at least one predicate");
+  for (const auto& predicate : _predicates) {
+    Assert((predicate.scan_type == ScanType::OpBetween) == predicate.search_value2.has_value(),
+           "A second search value has to be given for and only for OpBetween");
+    Assert(predicate.scan_type == ScanType::OpIn || predicate.in_values.empty(), "Only OpIn uses a list of values");
+    Assert(!predicate.right_column_id || predicate.scan_type == ScanType::OpEquals ||
+               predicate.scan_type == ScanType::OpNotEquals || predicate.scan_type == ScanType::OpLessThan ||
+               predicate.scan_type == ScanType::OpLessThanEquals || predicate.scan_type == ScanType::OpGreaterThan ||
+               predicate.scan_type == ScanType::OpGreaterThanEquals,
+           "Columns can only be compared with =, !=, <, <=, > and >=");
+  }
+}
 
 TableScan::~TableScan() {}
 
-ColumnID TableScan::column_id() const { return _column_id; }
+ColumnID TableScan::column_id() const { return _predicates.front().column_id; }
+
+ScanType TableScan::scan_type() const { return _predicates.front().scan_type; }
 
-ScanType TableScan::scan_type() const { return _scan_type; }
+const AllTypeVariant& TableScan::search_value() const { return _predicates.front().search_value; }
 
-const AllTypeVariant& TableScan::search_value() const { return _search_value; }
+const std::optional<AllTypeVariant>& TableScan::search_value2() const { return _predicates.front().search_value2; }
+
+const std::vector<ScanPredicate>& TableScan::predicates() const { return _predicates; }
+
+void TableScan::set_excluded_chunk_ids(const std::vector<ChunkID>& chunk_ids) {
+  Assert(!_output, "Excluded chunks have to be set before the operator is executed");
+  _excluded_chunk_ids = chunk_ids;
+}
+
+const std::vector<ChunkID>& TableScan::excluded_chunk_ids() const { return _excluded_chunk_ids; }
 
 std::shared_ptr<const Table> TableScan::_on_execute() {
-  const auto input_table = _in->get_output();
+  const auto input_table = _input_table_left();
   const auto table_column_count = input_table->column_count();
   const auto table_chunk_count = input_table->chunk_count();
-  const auto table_max_chunk_size = input_table->max_chunk_size();
 
   auto result = std::make_shared<Table>();
 
@@ -41,21 +86,39 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
   // if the table we are scanning is already a reference table, we create new references into the
   // original table
   auto referenced_table = input_table;
-  if (input_table->row_count() > 0) {
-    const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(input_table->get_chunk(ChunkID(0)).get_segment(ColumnID(0)));
-    referenced_table = reference_segment->referenced_table();
+  const auto& first_chunk = input_table->get_chunk(ChunkID{0});
+  if (first_chunk.column_count() > 0) {
+    const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(first_chunk.get_segment(ColumnID{0}));
+    if (reference_segment) referenced_table = reference_segment->referenced_table();
   }
+  if (referenced_table != input_table && !_has_uniform_positions(*input_table)) return _scan_materialized(input_table);
 
-  auto pos_list = std::make_shared<PosList>();
+  // maps a column of the input table to the column of the referenced table that it references
+  const auto referenced_column_id = [&](const ColumnID column_id) {
+    if (referenced_table == input_table) return column_id;
+    const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(first_chunk.get_segment(column_id));
+    Assert(reference_segment && reference_segment->referenced_table() == referenced_table,
+           "All columns of a reference table have to reference the same table");
+    return reference_segment->referenced_column_id();
+  };
+
+  // the predicates are evaluated on the referenced table, with the data types of its columns resolved only once
+  std::vector<std::unique_ptr<BaseTableScanImpl>> impls;
+  for (const auto& predicate : _predicates) {
+    auto right_column_id = std::optional<ColumnID>{};
+    if (predicate.right_column_id) right_column_id = referenced_column_id(*predicate.right_column_id);
+    impls.push_back(
+        _create_impl(*referenced_table, predicate, referenced_column_id(predicate.column_id), right_column_id));
+  }
 
-  auto output_chunk = [&referenced_table, &table_column_count, &result](const std::shared_ptr<PosList> pos_list) {
+  auto output_chunk = [&](const std::shared_ptr<PosList> pos_list) {
     // copy pos_list into chunk
     Chunk new_chunk;
-    for (uint16_t column_id = 0; column_id < table_column_count; column_id++) {
+    for (ColumnID column_id = ColumnID{0}; column_id < table_column_count; column_id++) {
       // link all found positions for each column
       new_chunk.add_segment(std::make_shared<ReferenceSegment>(
         referenced_table,
-        ColumnID(column_id),
+        referenced_column_id(column_id),
         pos_list
       ));
     }
@@ -63,25 +126,535 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
     result->emplace_chunk(std::move(new_chunk));
   };
 
-  // scan all chunks from the table
+  auto output_bitmap_chunk = [&](const ChunkRowBitmap& referenced_bitmap) {
+    Chunk new_chunk;
+    for (ColumnID column_id = ColumnID{0}; column_id < table_column_count; column_id++) {
+      new_chunk.add_segment(std::make_shared<ReferenceSegment>(input_table, column_id, referenced_bitmap));
+    }
+    result->emplace_chunk(std::move(new_chunk));
+  };
+
+  auto is_excluded = std::vector<bool>(table_chunk_count);
+  for (const auto& chunk_id : _excluded_chunk_ids) {
+    if (chunk_id < table_chunk_count) is_excluded[chunk_id] = true;
+  }
+  const auto is_scanned = [&](const ChunkID chunk_id) {
+    const auto& chunk = input_table->get_chunk(chunk_id);
+    // empty chunks cannot yield any rows
+    return chunk.column_count() > 0 && !is_excluded[chunk_id] && chunk.size() > 0;
+  };
+
+  // the chunks of a data table in which all predicates have an index are looked up first, in parallel. A chunk for
+  // which one of the lookups fails is scanned in morsels like all other chunks.
+  auto index_bitmaps = std::vector<std::optional<PositionBitmap>>(table_chunk_count);
+  if (referenced_table == input_table) {
+    std::vector<std::function<void()>> lookup_jobs;
+    for (ChunkID chunk_index = ChunkID{0}; chunk_index < table_chunk_count; ++chunk_index) {
+      if (!is_scanned(chunk_index)) continue;
+      const auto& chunk = input_table->get_chunk(chunk_index);
+      if (!std::all_of(impls.cbegin(), impls.cend(), [&](const auto& impl) { return impl->has_index(chunk); })) {
+        continue;
+      }
+
+      lookup_jobs.emplace_back([&, chunk_index]() {
+        const auto& chunk = input_table->get_chunk(chunk_index);
+        auto& bitmap = index_bitmaps[chunk_index];
+        for (const auto& impl : impls) {
+          auto predicate_bitmap = impl->lookup_index(chunk);
+          if (!predicate_bitmap) {
+            bitmap = std::nullopt;
+            return;
+          }
+          if (bitmap) {
+            bitmap = bitmap->intersect(*predicate_bitmap);
+          } else {
+            bitmap = std::move(predicate_bitmap);
+          }
+        }
+      });
+    }
+    ThreadPool::get().execute_and_wait(lookup_jobs);
+  }
+
+  // split the chunks into morsels
+  struct Morsel {
+    ChunkID chunk_id;
+    ChunkOffsetRange row_range;
+    // the morsel covers a whole chunk of a data table whose positions were looked up in indexes
+    bool uses_indexes = false;
+  };
+  std::vector<Morsel> morsels;
   for (ChunkID chunk_index = ChunkID{0}; chunk_index < table_chunk_count; ++chunk_index) {
-    // find the relevant column to scan
-    const auto segment = input_table->get_chunk(chunk_index).get_segment(_column_id);
+    if (!is_scanned(chunk_index)) continue;
+
+    const auto chunk_size = input_table->get_chunk(chunk_index).size();
+    if (index_bitmaps[chunk_index]) {
+      morsels.push_back(Morsel{chunk_index, ChunkOffsetRange{0, chunk_size}, true});
+      continue;
+    }
 
-    // scan segment and get matching values' position via lambda
-    segment->segment_scan(_search_value, _scan_type, [&](RowID row_id) {
-      pos_list->push_back(row_id);
+    for (auto morsel_begin = ChunkOffset{0}; morsel_begin < chunk_size; morsel_begin += MORSEL_SIZE) {
+      const auto morsel_end = std::min(chunk_size, morsel_begin + MORSEL_SIZE);
+      morsels.push_back(Morsel{chunk_index, ChunkOffsetRange{morsel_begin, morsel_end}});
+    }
+  }
+
+  // the positions found in a morsel are either listed in a PosList or, if they point into a data table and are
+  // dense or were looked up in indexes, set in a PositionBitmap. If neither is given, all rows of the morsel match.
+  struct MorselResult {
+    std::shared_ptr<PosList> pos_list;
+    std::shared_ptr<PositionBitmap> bitmap;
+  };
+  const auto morsel_match_count = [&](const MorselResult& morsel_result, const Morsel& morsel) {
+    if (morsel_result.pos_list) return morsel_result.pos_list->size();
+    if (morsel_result.bitmap) return morsel_result.bitmap->size();
+    return size_t{morsel.row_range.end - morsel.row_range.begin};
+  };
+  const auto is_dense = [](const size_t match_count, const size_t row_count) {
+    return static_cast<float>(match_count) >= BITMAP_MIN_SELECTIVITY * static_cast<float>(row_count);
+  };
+
+  // scan all morsels in parallel
+  std::vector<MorselResult> morsel_results(morsels.size());
+  std::vector<std::function<void()>> jobs;
+  jobs.reserve(morsels.size());
+  for (auto morsel_index = size_t{0}; morsel_index < morsels.size(); ++morsel_index) {
+    jobs.emplace_back([&, morsel_index]() {
+      const auto& morsel = morsels[morsel_index];
+      auto& morsel_result = morsel_results[morsel_index];
+      if (morsel.uses_indexes) {
+        // if all rows qualify, the morsel result stays empty
+        auto& bitmap = *index_bitmaps[morsel.chunk_id];
+        if (bitmap.size() < morsel.row_range.end) {
+          morsel_result.bitmap = std::make_shared<PositionBitmap>(std::move(bitmap));
+        }
+        return;
+      }
+
+      morsel_result.pos_list = _scan_morsel(*referenced_table, input_table->get_chunk(morsel.chunk_id),
+                                            morsel.chunk_id, morsel.row_range, impls);
+
+      // dense positions are compressed right away, so that the lists of all morsels do not pile up
+      if (referenced_table == input_table && morsel_result.pos_list &&
+          is_dense(morsel_result.pos_list->size(), morsel.row_range.end - morsel.row_range.begin)) {
+        morsel_result.bitmap = std::make_shared<PositionBitmap>();
+        for (const auto& row_id : *morsel_result.pos_list) {
+          morsel_result.bitmap->append(row_id.chunk_offset);
+        }
+        morsel_result.pos_list = nullptr;
+      }
+    });
+  }
+
+  if (!_output_row_limit) {
+    ThreadPool::get().execute_and_wait(jobs);
+  } else {
+    // the morsels are scanned in waves of whole chunks, each twice as large as the previous one, until the scanned
+    // morsels hold enough matches. The morsels that were not scanned are dropped.
+    auto scanned_morsel_count = size_t{0};
+    auto match_count = size_t{0};
+    auto wave_size = ThreadPool::get().worker_count();
+    while (scanned_morsel_count < morsels.size() && match_count < *_output_row_limit) {
+      auto wave_end = std::min(scanned_morsel_count + wave_size, morsels.size());
+      while (wave_end < morsels.size() && morsels[wave_end].chunk_id == morsels[wave_end - 1].chunk_id) ++wave_end;
+      ThreadPool::get().execute_and_wait(
+          std::vector<std::function<void()>>(jobs.begin() + scanned_morsel_count, jobs.begin() + wave_end));
+      for (; scanned_morsel_count < wave_end; ++scanned_morsel_count) {
+        match_count += morsel_match_count(morsel_results[scanned_morsel_count], morsels[scanned_morsel_count]);
+      }
+      wave_size *= 2;
+    }
+    morsels.resize(scanned_morsel_count);
+  }
+
+  // Sparse results of consecutive chunks are collected and written as a single output chunk once they reach the
+  // chunk size of the input table, so that selective scans on many small chunks do not produce as many tiny chunks.
+  // All columns of an output chunk share the same PosList.
+  const auto target_chunk_size = input_table->max_chunk_size() > 0 ? size_t{input_table->max_chunk_size()}
+                                                                   : std::numeric_limits<size_t>::max();
+  std::vector<std::shared_ptr<PosList>> pending_pos_lists;
+  auto pending_row_count = size_t{0};
+  const auto flush_pending_pos_lists = [&]() {
+    if (pending_pos_lists.empty()) return;
 
-      if (pos_list->size() == table_max_chunk_size) {
-        output_chunk(pos_list);
-        // create new pos_list
-        pos_list = std::make_shared<PosList>();
+    auto pos_list = pending_pos_lists.front();
+    if (pending_pos_lists.size() == 1) {
+      // the refinement by further predicates reserves more positions than qualify in the end
+      if (pos_list->capacity() > pos_list->size()) pos_list->shrink_to_fit();
+    } else {
+      pos_list = std::make_shared<PosList>();
+      pos_list->reserve(pending_row_count);
+      auto single_chunk = true;
+      auto sorted = true;
+      const auto first_chunk_id = pending_pos_lists.front()->front().chunk_id;
+      for (const auto& pending_pos_list : pending_pos_lists) {
+        single_chunk &= pending_pos_list->references_single_chunk() &&
+                        pending_pos_list->front().chunk_id == first_chunk_id;
+        sorted &= pending_pos_list->is_sorted() &&
+                  (pos_list->empty() || !(pending_pos_list->front() < pos_list->back()));
+        pos_list->insert(pos_list->end(), pending_pos_list->cbegin(), pending_pos_list->cend());
       }
-    }, chunk_index);
+      if (single_chunk) pos_list->guarantee_single_chunk();
+      if (sorted) pos_list->guarantee_sorted();
+    }
+
     output_chunk(pos_list);
+    pending_pos_lists.clear();
+    pending_row_count = 0;
+  };
+
+  // merge the morsels of each chunk in positional order
+  auto morsel_index = size_t{0};
+  while (morsel_index < morsels.size()) {
+    const auto chunk_id = morsels[morsel_index].chunk_id;
+    auto morsel_end = morsel_index;
+    while (morsel_end < morsels.size() && morsels[morsel_end].chunk_id == chunk_id) ++morsel_end;
+
+    const auto& input_chunk = input_table->get_chunk(chunk_id);
+    const auto input_reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(input_chunk.get_segment(ColumnID{0}));
+
+    const auto all_rows_match = std::all_of(morsel_results.cbegin() + morsel_index,
+                                            morsel_results.cbegin() + morsel_end, [](const auto& morsel_result) {
+                                              return !morsel_result.pos_list && !morsel_result.bitmap;
+                                            });
+    if (all_rows_match) {
+      flush_pending_pos_lists();
+
+      // instead of listing all positions, we reference the whole chunk or, for reference tables, the same rows as the
+      // input segments do
+      Chunk new_chunk;
+      for (ColumnID column_id = ColumnID{0}; column_id < table_column_count; column_id++) {
+        if (input_reference_segment) {
+          new_chunk.add_segment(input_chunk.get_segment(column_id));
+        } else {
+          const auto all_rows = ChunkRowRange{chunk_id, ChunkOffsetRange{0, static_cast<ChunkOffset>(input_chunk.size())}};
+          new_chunk.add_segment(std::make_shared<ReferenceSegment>(input_table, column_id, all_rows));
+        }
+      }
+      result->emplace_chunk(std::move(new_chunk));
+      morsel_index = morsel_end;
+      continue;
+    }
+
+    // positions into a data chunk are sorted, so those of all morsels can be appended to a single bitmap
+    auto match_count = size_t{0};
+    for (auto index = morsel_index; index < morsel_end; ++index) {
+      match_count += morsel_match_count(morsel_results[index], morsels[index]);
+    }
+    if (match_count == 0) {
+      morsel_index = morsel_end;
+      continue;
+    }
+
+    if (!input_reference_segment && is_dense(match_count, input_chunk.size())) {
+      auto bitmap = morsel_results[morsel_index].bitmap;
+      if (!bitmap || morsel_end - morsel_index > 1) {
+        bitmap = std::make_shared<PositionBitmap>();
+        for (; morsel_index < morsel_end; ++morsel_index) {
+          const auto& morsel_result = morsel_results[morsel_index];
+          if (morsel_result.pos_list) {
+            for (const auto& row_id : *morsel_result.pos_list) bitmap->append(row_id.chunk_offset);
+          } else if (morsel_result.bitmap) {
+            morsel_result.bitmap->for_each([&](const ChunkOffset chunk_offset) { bitmap->append(chunk_offset); });
+          } else {
+            bitmap->append_range(morsels[morsel_index].row_range);
+          }
+        }
+      }
+      morsel_index = morsel_end;
+
+      flush_pending_pos_lists();
+      output_bitmap_chunk(ChunkRowBitmap{chunk_id, bitmap});
+      continue;
+    }
+
+    auto pos_list = morsel_results[morsel_index].pos_list;
+    if (!pos_list || morsel_end - morsel_index > 1) {
+      pos_list = std::make_shared<PosList>();
+      pos_list->reserve(match_count);
+      for (; morsel_index < morsel_end; ++morsel_index) {
+        const auto& morsel_result = morsel_results[morsel_index];
+        if (morsel_result.pos_list) {
+          pos_list->insert(pos_list->end(), morsel_result.pos_list->cbegin(), morsel_result.pos_list->cend());
+        } else if (morsel_result.bitmap) {
+          morsel_result.bitmap->for_each(
+              [&](const ChunkOffset chunk_offset) { pos_list->push_back(RowID{chunk_id, chunk_offset}); });
+        } else {
+          // all rows of the morsel match, we have to list them as they are mixed with morsels that do not match
+          // entirely
+          _append_all_positions(input_chunk, chunk_id, morsels[morsel_index].row_range, *pos_list);
+        }
+      }
+    }
+    morsel_index = morsel_end;
+
+    // the scan keeps the order of the positions, so the guarantees of the input positions still hold for the output,
+    // while positions into a data table always reference a single chunk and are sorted
+    if (!input_reference_segment || input_reference_segment->referenced_rows() ||
+        input_reference_segment->referenced_bitmap() ||
+        input_reference_segment->pos_list()->references_single_chunk()) {
+      pos_list->guarantee_single_chunk();
+    }
+    if (!input_reference_segment || input_reference_segment->referenced_rows() ||
+        input_reference_segment->referenced_bitmap() || input_reference_segment->pos_list()->is_sorted()) {
+      pos_list->guarantee_sorted();
+    }
+
+    if (pending_row_count + match_count > target_chunk_size) flush_pending_pos_lists();
+    pending_pos_lists.push_back(pos_list);
+    pending_row_count += match_count;
   }
+  flush_pending_pos_lists();
+
+  // a table always holds at least one chunk, if nothing qualifies, it is an empty one with all columns
+  if (result->row_count() == 0) output_chunk(std::make_shared<PosList>());
 
   return result;
 }
 
+std::shared_ptr<const Table> TableScan::_scan_materialized(const std::shared_ptr<const Table>& input_table) const {
+  // the columns that predicates read are materialized, in the order of their first use, into a table that holds a
+  // single chunk of the input at a time
+  auto scanned_table = std::make_shared<Table>();
+  std::vector<ColumnID> input_column_ids;
+  const auto scanned_column_id = [&](const ColumnID input_column_id) {
+    const auto position = std::find(input_column_ids.cbegin(), input_column_ids.cend(), input_column_id);
+    if (position != input_column_ids.cend()) {
+      return ColumnID{static_cast<ColumnID::base_type>(position - input_column_ids.cbegin())};
+    }
+    input_column_ids.push_back(input_column_id);
+    scanned_table->add_column_definition(input_table->column_name(input_column_id),
+                                         input_table->column_type(input_column_id));
+    return ColumnID{static_cast<ColumnID::base_type>(input_column_ids.size() - 1)};
+  };
+
+  std::vector<std::unique_ptr<BaseTableScanImpl>> impls;
+  for (const auto& predicate : _predicates) {
+    const auto column_id = scanned_column_id(predicate.column_id);
+    auto right_column_id = std::optional<ColumnID>{};
+    if (predicate.right_column_id) right_column_id = scanned_column_id(*predicate.right_column_id);
+    impls.push_back(_create_impl(*scanned_table, predicate, column_id, right_column_id));
+  }
+
+  auto is_excluded = std::vector<bool>(input_table->chunk_count());
+  for (const auto& chunk_id : _excluded_chunk_ids) {
+    if (chunk_id < input_table->chunk_count()) is_excluded[chunk_id] = true;
+  }
+
+  auto result = std::make_shared<Table>();
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    result->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+    const auto& input_chunk = input_table->get_chunk(chunk_id);
+    const auto chunk_size = input_chunk.size();
+    if (input_chunk.column_count() == 0 || is_excluded[chunk_id] || chunk_size == 0) continue;
+
+    // rows that are NULL in a predicate column never qualify
+    auto is_null = std::vector<uint8_t>(chunk_size);
+    Chunk scanned_chunk;
+    for (const auto& input_column_id : input_column_ids) {
+      const auto& segment = *input_chunk.get_segment(input_column_id);
+      resolve_data_type(input_table->column_type(input_column_id), [&](auto type) {
+        using ColumnType = typename decltype(type)::type;
+        auto values = std::vector<ColumnType>(chunk_size);
+        materialize_values(segment, ChunkOffsetRange{0, chunk_size}, values.data());
+        scanned_chunk.add_segment(std::make_shared<ValueSegment<ColumnType>>(std::move(values)));
+      });
+      if (const auto positions = nullable_positions(segment)) {
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+          if ((*positions)[chunk_offset] == NULL_ROW_ID) is_null[chunk_offset] = true;
+        }
+      }
+    }
+    auto chunk_table = std::make_shared<Table>();
+    for (auto column_id = ColumnID{0}; column_id < scanned_table->column_count(); ++column_id) {
+      chunk_table->add_column_definition(scanned_table->column_name(column_id), scanned_table->column_type(column_id));
+    }
+    chunk_table->emplace_chunk(std::move(scanned_chunk));
+
+    const auto scanned_positions = _scan_morsel(*chunk_table, chunk_table->get_chunk(ChunkID{0}), ChunkID{0},
+                                                ChunkOffsetRange{0, chunk_size}, impls);
+    auto positions = std::make_shared<PosList>();
+    const auto add_position = [&](const ChunkOffset chunk_offset) {
+      if (!is_null[chunk_offset]) positions->push_back(RowID{chunk_id, chunk_offset});
+    };
+    if (scanned_positions) {
+      for (const auto& row_id : *scanned_positions) add_position(row_id.chunk_offset);
+    } else {
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) add_position(chunk_offset);
+    }
+    if (positions->empty()) continue;
+
+    Chunk output_chunk;
+    _add_reference_segments(input_table, positions, output_chunk);
+    result->emplace_chunk(std::move(output_chunk));
+  }
+
+  // a table always holds at least one chunk, if nothing qualifies, it is an empty one with all columns
+  if (result->row_count() == 0) {
+    Chunk output_chunk;
+    _add_reference_segments(input_table, std::make_shared<PosList>(), output_chunk);
+    result->emplace_chunk(std::move(output_chunk));
+  }
+  return result;
+}
+
+std::shared_ptr<PosList> TableScan::_scan_morsel(const Table& referenced_table, const Chunk& chunk,
+                                                 const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                                                 const std::vector<std::unique_ptr<BaseTableScanImpl>>& impls) const {
+  auto pos_list = std::make_shared<PosList>();
+
+  const auto ordered_predicates = _order_predicates(referenced_table, chunk, impls);
+  if (!ordered_predicates) return pos_list;
+  const auto& predicate_order = *ordered_predicates;
+  if (predicate_order.empty()) return nullptr;
+
+  // the most selective predicate scans the whole morsel
+  const auto& first_impl = *impls[predicate_order.front()];
+  const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(ColumnID{0}));
+  if (!reference_segment) {
+    first_impl.scan_chunk(chunk, chunk_id, row_range, nullptr, *pos_list);
+  } else {
+    // for reference tables, the referenced chunks are scanned, but only at the referenced rows
+    reference_segment->for_each_referenced_chunk(
+        row_range, nullptr,
+        [&](const ChunkID referenced_chunk_id, const ChunkOffsetRange& referenced_row_range,
+            const std::vector<ChunkOffset>* offset_filter) {
+          first_impl.scan_chunk(referenced_table.get_chunk(referenced_chunk_id), referenced_chunk_id,
+                                referenced_row_range, offset_filter, *pos_list);
+        });
+  }
+
+  // all other predicates only look at the remaining positions, we stop as soon as nothing qualifies anymore
+  for (auto order_index = size_t{1}; order_index < predicate_order.size() && !pos_list->empty(); ++order_index) {
+    const auto& impl = *impls[predicate_order[order_index]];
+
+    const auto previous_pos_list = pos_list;
+    pos_list = std::make_shared<PosList>();
+    pos_list->reserve(previous_pos_list->size());
+
+    // positions are grouped by the chunk they point to, we check each group with one call on the referenced chunk
+    std::vector<ChunkOffset> offset_filter;
+    auto group_begin = previous_pos_list->cbegin();
+    while (group_begin != previous_pos_list->cend()) {
+      const auto group_chunk_id = group_begin->chunk_id;
+      const auto group_end = std::find_if(group_begin, previous_pos_list->cend(),
+                                          [&](const RowID& row_id) { return row_id.chunk_id != group_chunk_id; });
+
+      offset_filter.clear();
+      std::transform(group_begin, group_end, std::back_inserter(offset_filter),
+                     [](const RowID& row_id) { return row_id.chunk_offset; });
+      impl.scan_chunk(referenced_table.get_chunk(group_chunk_id), group_chunk_id, ChunkOffsetRange{}, &offset_filter,
+                      *pos_list);
+
+      group_begin = group_end;
+    }
+  }
+
+  return pos_list;
+}
+
+std::optional<std::vector<size_t>> TableScan::_order_predicates(
+    const Table& referenced_table, const Chunk& chunk,
+    const std::vector<std::unique_ptr<BaseTableScanImpl>>& impls) const {
+  // the dictionaries only tell us something if all rows of the chunk come from the same chunk of the referenced table
+  const Chunk* estimation_chunk = &chunk;
+  if (const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(ColumnID{0}))) {
+    const auto referenced_chunk_id = reference_segment->referenced_chunk_id();
+    estimation_chunk = referenced_chunk_id ? &referenced_table.get_chunk(*referenced_chunk_id) : nullptr;
+  }
+
+  std::vector<size_t> predicate_order;
+  std::vector<float> selectivities(_predicates.size());
+  for (auto predicate_index = size_t{0}; predicate_index < _predicates.size(); ++predicate_index) {
+    const auto qualifying_values =
+        estimation_chunk ? impls[predicate_index]->count_qualifying_values(*estimation_chunk) : std::nullopt;
+    if (qualifying_values) {
+      // if no value qualifies, no row does; if all values qualify, the predicate does not need to be checked
+      const auto [qualifying_count, distinct_count] = *qualifying_values;
+      if (qualifying_count == 0) return std::nullopt;
+      if (qualifying_count == distinct_count) continue;
+      selectivities[predicate_index] = static_cast<float>(qualifying_count) / static_cast<float>(distinct_count);
+    } else {
+      selectivities[predicate_index] = _default_selectivity(_predicates[predicate_index]);
+    }
+    predicate_order.push_back(predicate_index);
+  }
+
+  // column comparisons read two segments, so they are checked after the predicates on a single column
+  std::stable_sort(predicate_order.begin(), predicate_order.end(), [&](size_t left, size_t right) {
+    return std::make_pair(_predicates[left].right_column_id.has_value(), selectivities[left]) <
+           std::make_pair(_predicates[right].right_column_id.has_value(), selectivities[right]);
+  });
+  return predicate_order;
 }
+
+std::unique_ptr<BaseTableScanImpl> TableScan::_create_impl(const Table& referenced_table,
+                                                           const ScanPredicate& predicate, const ColumnID column_id,
+                                                           const std::optional<ColumnID>& right_column_id) {
+  std::unique_ptr<BaseTableScanImpl> impl;
+  resolve_data_type(referenced_table.column_type(column_id), [&](auto type) {
+    using ColumnType = typename decltype(type)::type;
+
+    if (!right_column_id) {
+      impl = std::make_unique<ColumnVsValueTableScanImpl<ColumnType>>(column_id, predicate);
+      return;
+    }
+
+    resolve_data_type(referenced_table.column_type(*right_column_id), [&](auto right_type) {
+      using RightColumnType = typename decltype(right_type)::type;
+
+      if constexpr (std::is_same_v<ColumnType, std::string> != std::is_same_v<RightColumnType, std::string>) {
+        Fail("Strings can only be compared with strings");
+      } else {
+        impl = std::make_unique<ColumnComparisonTableScanImpl<ColumnType, RightColumnType>>(
+            column_id, predicate.scan_type, *right_column_id);
+      }
+    });
+  });
+  return impl;
+}
+
+float TableScan::_default_selectivity(const ScanPredicate& predicate) {
+  // textbook defaults used by query optimizers when no statistics are available
+  switch (predicate.scan_type) {
+    case ScanType::OpEquals:
+      return 0.1f;
+    case ScanType::OpNotEquals:
+      return 0.9f;
+    case ScanType::OpBetween:
+      return 0.25f;
+    case ScanType::OpIn:
+      return std::min(1.0f, 0.1f * predicate.in_values.size());
+    case ScanType::OpLike:
+    case ScanType::OpILike:
+      return 0.2f;
+    default:
+      return 1.0f / 3.0f;
+  }
+}
+
+void TableScan::_append_all_positions(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                                      PosList& pos_list) {
+  const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(ColumnID{0}));
+  if (!reference_segment) {
+    for (auto chunk_offset = row_range.begin; chunk_offset < row_range.end; ++chunk_offset) {
+      pos_list.push_back(RowID{chunk_id, chunk_offset});
+    }
+  } else if (const auto& referenced_rows = reference_segment->referenced_rows()) {
+    for (auto chunk_offset = row_range.begin; chunk_offset < row_range.end; ++chunk_offset) {
+      pos_list.push_back(RowID{referenced_rows->chunk_id, referenced_rows->offsets.begin + chunk_offset});
+    }
+  } else if (const auto& referenced_bitmap = reference_segment->referenced_bitmap()) {
+    referenced_bitmap->offsets->for_each(
+        [&](const ChunkOffset chunk_offset) { pos_list.push_back(RowID{referenced_bitmap->chunk_id, chunk_offset}); },
+        row_range.begin, row_range.end);
+  } else {
+    const auto& input_pos_list = *reference_segment->pos_list();
+    pos_list.insert(pos_list.end(), input_pos_list.cbegin() + row_range.begin, input_pos_list.cbegin() + row_range.end);
+  }
+}
+
+}  // namespace opossum
@@ -3,6 +3,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "abstract_operator.hpp"
@@ -13,27 +14,124 @@
 namespace opossum {
 
 class BaseTableScanImpl;
+class Chunk;
 class Table;
 
+// a single comparison of a column with a search value
+// search_value2 is only used by OpBetween, where it is the (inclusive) upper bound
+// in_values is only used by OpIn, which ignores search_value
+// if right_column_id is set, the column is compared with that column of the same row instead of search_value
+struct ScanPredicate {
+  ColumnID column_id;
+  ScanType scan_type;
+  AllTypeVariant search_value;
+  std::optional<AllTypeVariant> search_value2 = std::nullopt;
+  std::vector<AllTypeVariant> in_values = {};
+  std::optional<ColumnID> right_column_id = std::nullopt;
+};
+
+// Filters the input table and returns a table of ReferenceSegments pointing to the matching rows.
+// Several predicates are combined conjunctively (AND) and evaluated chunk by chunk in a single pass: the most
+// selective predicate scans the chunk, the others only check the rows that are still qualifying.
+//
+// The scan is morsel-driven: the input is split into morsels of at most MORSEL_SIZE rows - across chunks and within
+// large chunks - that are scanned in parallel on the ThreadPool. The results of all morsels of a chunk are
+// concatenated in positional order, so the output is the same as that of a sequential scan.
+//
+// Each predicate is evaluated by a BaseTableScanImpl, which is created once per execution for the data types of the
+// scanned columns (see operators/table_scan/).
+//
+// If the dictionary of a segment shows that all or none of its rows satisfy a predicate, the segment is not scanned.
+// Chunks in which all rows qualify are referenced as a whole, without listing every position. Dense results are
+// referenced through a compressed bitmap of their positions.
+//
+// In chunks of a data table where every predicate can be answered by an index on its column - a BitmapIndex on a
+// dictionary segment or a CrackerIndex on a value segment (see storage/index/) - the predicates are not scanned but
+// looked up in the indexes, and their results are intersected. These lookups run before the morsels are scanned, also
+// with an output row limit, and a chunk whose lookups cannot answer all predicates is split into morsels instead.
+//
+// Chunks without qualifying rows produce no output chunk. Sparse results of consecutive chunks are combined into
+// output chunks of up to the input table's chunk size.
+//
+// The predicates are evaluated on the table that the input references. If the columns of a reference table do not
+// share their positions - they reference different tables, or some are NULL where others are not (e.g., the output
+// of a join or a projection) - the predicate columns are materialized chunk by chunk instead, rows that are NULL in
+// one of them are dropped, and the qualifying rows are resolved for each column of the input separately.
+//
+// With an output row limit, the morsels are scanned in waves of whole chunks, in their order, and no further wave is
+// started once the scanned morsels hold enough matches.
 class TableScan : public AbstractOperator {
  private:
-  const std::shared_ptr<const AbstractOperator> _in;
-  const ColumnID _column_id;
-  const ScanType _scan_type;
-  const AllTypeVariant _search_value;
+  const std::vector<ScanPredicate> _predicates;
+  std::vector<ChunkID> _excluded_chunk_ids;
 
  public:
+  static constexpr ChunkOffset MORSEL_SIZE = ChunkOffset{1} << 15;
+
+  // the positions found in a chunk of a data table are kept in a PositionBitmap instead of a PosList if at least this
+  // fraction of its rows qualifies, which is also the density at which a roaring bitmap switches to bitmap containers.
+  // Sparser results stay PosLists, which consumers can access without decoding.
+  static constexpr float BITMAP_MIN_SELECTIVITY = 1.0f / 16;
+
   TableScan(const std::shared_ptr<const AbstractOperator> in, const ColumnID column_id, const ScanType scan_type,
-            const AllTypeVariant search_value);
+            const AllTypeVariant search_value, const std::optional<AllTypeVariant> search_value2 = std::nullopt);
+
+  // scans for all values contained in in_values (OpIn)
+  TableScan(const std::shared_ptr<const AbstractOperator> in, const ColumnID column_id,
+            const std::vector<AllTypeVariant> in_values);
+
+  // compares two columns of the same row, e.g., a < b
+  TableScan(const std::shared_ptr<const AbstractOperator> in, const ColumnID left_column_id, const ScanType scan_type,
+            const ColumnID right_column_id);
+
+  TableScan(const std::shared_ptr<const AbstractOperator> in, const std::vector<ScanPredicate> predicates);
 
   ~TableScan() override;
 
+  // these refer to the first predicate
   ColumnID column_id() const;
   ScanType scan_type() const;
   const AllTypeVariant& search_value() const;
+  const std::optional<AllTypeVariant>& search_value2() const;
+
+  const std::vector<ScanPredicate>& predicates() const;
+
+  // the chunks of the input that are not scanned and produce no output, e.g., because an IndexScan looks them up in
+  // their indexes instead. This has to be set before execute().
+  void set_excluded_chunk_ids(const std::vector<ChunkID>& chunk_ids);
+  const std::vector<ChunkID>& excluded_chunk_ids() const;
 
  protected:
   std::shared_ptr<const Table> _on_execute() override;
+
+  // scans a reference table whose columns do not have uniform positions, see above
+  std::shared_ptr<const Table> _scan_materialized(const std::shared_ptr<const Table>& input_table) const;
+
+  // returns the positions of all rows in row_range of the chunk that satisfy all predicates, or nullptr if all rows
+  // of the range satisfy them. For reference tables, the positions point into the referenced table.
+  std::shared_ptr<PosList> _scan_morsel(const Table& referenced_table, const Chunk& chunk, const ChunkID chunk_id,
+                                        const ChunkOffsetRange& row_range,
+                                        const std::vector<std::unique_ptr<BaseTableScanImpl>>& impls) const;
+
+  // returns the indices of the predicates that need to be checked on the given chunk, ordered by their estimated
+  // selectivity (most selective first). Predicates that all rows satisfy are left out, std::nullopt is returned if
+  // no row can satisfy one of the predicates.
+  std::optional<std::vector<size_t>> _order_predicates(
+      const Table& referenced_table, const Chunk& chunk,
+      const std::vector<std::unique_ptr<BaseTableScanImpl>>& impls) const;
+
+  // creates the implementation that evaluates predicate on the given column(s) of the referenced table, which is the
+  // input table itself if that is a data table
+  static std::unique_ptr<BaseTableScanImpl> _create_impl(const Table& referenced_table, const ScanPredicate& predicate,
+                                                         const ColumnID column_id,
+                                                         const std::optional<ColumnID>& right_column_id);
+
+  // estimates the fraction of rows that satisfy predicate when nothing is known about the segment
+  static float _default_selectivity(const ScanPredicate& predicate);
+
+  // appends the positions of all rows in row_range of the chunk
+  static void _append_all_positions(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                                    PosList& pos_list);
 };
 
 }  // namespace opossum
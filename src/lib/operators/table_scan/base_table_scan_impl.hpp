@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "storage/position_bitmap.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+/**
+ * A BaseTableScanImpl evaluates a single predicate of a TableScan on chunks of a data table. Implementations are
+ * templated by the data types of the scanned columns and created once per TableScan execution, so that search values
+ * are converted only once. Per chunk, they dispatch on the segment type and then on the ScanType, so that the loops
+ * over the rows call neither virtual methods nor compare variants.
+ *
+ * For reference tables, the TableScan passes the chunks of the referenced table together with the offsets into them.
+ */
+class BaseTableScanImpl {
+ public:
+  virtual ~BaseTableScanImpl() = default;
+
+  // appends the positions of all rows of chunk that satisfy the predicate to matches, looking either at the rows in
+  // row_range or, if given, only at those in offset_filter
+  virtual void scan_chunk(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                          const std::vector<ChunkOffset>* offset_filter, PosList& matches) const = 0;
+
+  // returns the number of distinct values of the scanned segment of chunk that satisfy the predicate and the number
+  // of all its distinct values, if they are known without a scan (e.g., from a dictionary)
+  virtual std::optional<std::pair<size_t, size_t>> count_qualifying_values(const Chunk& chunk) const {
+    return std::nullopt;
+  }
+
+  // returns whether an index on the scanned segment of chunk answers the predicate without a scan
+  virtual bool has_index(const Chunk& chunk) const { return false; }
+
+  // returns the offsets of all rows of chunk that satisfy the predicate, looked up in the index on the scanned
+  // segment, or std::nullopt if there is no such index
+  virtual std::optional<PositionBitmap> lookup_index(const Chunk& chunk) const { return std::nullopt; }
+
+ protected:
+  // calls functor with the function object that implements scan_type, which has to be a comparison
+  template <typename Functor>
+  static void _resolve_comparator(const ScanType scan_type, const Functor& functor) {
+    switch (scan_type) {
+      case ScanType::OpEquals:
+        return functor(std::equal_to<>{});
+      case ScanType::OpNotEquals:
+        return functor(std::not_equal_to<>{});
+      case ScanType::OpLessThan:
+        return functor(std::less<>{});
+      case ScanType::OpLessThanEquals:
+        return functor(std::less_equal<>{});
+      case ScanType::OpGreaterThan:
+        return functor(std::greater<>{});
+      case ScanType::OpGreaterThanEquals:
+        return functor(std::greater_equal<>{});
+      default:
+        Fail("Unsupported comparison");
+    }
+  }
+
+  // appends the positions of the rows in row_range (or in offset_filter, if given) for which row_matches(chunk_offset)
+  // returns true. Rows in a range are evaluated in blocks without branches first, which the compiler can vectorize
+  // if row_matches reads from plain arrays.
+  template <typename RowMatches>
+  static void _scan_rows(const RowMatches& row_matches, const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                         const std::vector<ChunkOffset>* offset_filter, PosList& matches) {
+    if (offset_filter) {
+      for (const auto chunk_offset : *offset_filter) {
+        if (row_matches(chunk_offset)) matches.push_back(RowID{chunk_id, chunk_offset});
+      }
+      return;
+    }
+
+    constexpr auto BLOCK_SIZE = ChunkOffset{1024};
+    auto block_matches = std::array<uint8_t, BLOCK_SIZE>{};
+    for (auto block_begin = row_range.begin; block_begin < row_range.end; block_begin += BLOCK_SIZE) {
+      const auto block_size = std::min(BLOCK_SIZE, row_range.end - block_begin);
+      for (auto index = ChunkOffset{0}; index < block_size; ++index) {
+        block_matches[index] = row_matches(block_begin + index);
+      }
+      for (auto index = ChunkOffset{0}; index < block_size; ++index) {
+        if (block_matches[index]) matches.push_back(RowID{chunk_id, block_begin + index});
+      }
+    }
+  }
+
+  // appends the positions of all rows in row_range (or in offset_filter, if given)
+  static void _append_all_rows(const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                               const std::vector<ChunkOffset>* offset_filter, PosList& matches) {
+    if (offset_filter) {
+      for (const auto chunk_offset : *offset_filter) matches.push_back(RowID{chunk_id, chunk_offset});
+      return;
+    }
+    for (auto chunk_offset = row_range.begin; chunk_offset < row_range.end; ++chunk_offset) {
+      matches.push_back(RowID{chunk_id, chunk_offset});
+    }
+  }
+};
+
+}  // namespace opossum
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "base_table_scan_impl.hpp"
+#include "storage/chunk.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// Compares two columns of the same row, e.g., a < b. The comparator is resolved once per chunk, the loop over the
+// rows reads the values (or, if both segments share a dictionary, the value ids) directly from the typed vectors.
+//
+// Unlike the other implementations, this one is templated by two types. It is therefore defined in the header, as
+// EXPLICITLY_INSTANTIATE_DATA_TYPES only covers templates with a single type.
+template <typename LeftType, typename RightType>
+class ColumnComparisonTableScanImpl : public BaseTableScanImpl {
+ public:
+  // the column ids refer to the scanned data table, which, for reference inputs, is the referenced table
+  ColumnComparisonTableScanImpl(const ColumnID left_column_id, const ScanType scan_type,
+                                const ColumnID right_column_id)
+      : _left_column_id{left_column_id}, _scan_type{scan_type}, _right_column_id{right_column_id} {
+    static_assert(std::is_same_v<LeftType, std::string> == std::is_same_v<RightType, std::string>,
+                  "Strings can only be compared with strings");
+  }
+
+  void scan_chunk(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                  const std::vector<ChunkOffset>* offset_filter, PosList& matches) const override {
+    const auto left_segment = chunk.get_segment(_left_column_id);
+    const auto right_segment = chunk.get_segment(_right_column_id);
+
+    _resolve_comparator(_scan_type, [&](const auto comparator) {
+      // with a common dictionary, the order of the value ids is that of the values
+      if constexpr (std::is_same_v<LeftType, RightType>) {
+        const auto left_dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<LeftType>>(left_segment);
+        const auto right_dictionary_segment =
+            std::dynamic_pointer_cast<const DictionarySegment<RightType>>(right_segment);
+        if (left_dictionary_segment && right_dictionary_segment &&
+            left_dictionary_segment->dictionary() == right_dictionary_segment->dictionary() &&
+            left_dictionary_segment->attribute_vector()->width() ==
+                right_dictionary_segment->attribute_vector()->width()) {
+          left_dictionary_segment->with_value_ids([&](const auto* const left_value_ids) {
+            using LeftValueIDs = std::decay_t<decltype(left_value_ids)>;
+            right_dictionary_segment->with_value_ids([&](const auto* const right_value_ids) {
+              // both attribute vectors have the same width, other combinations do not occur
+              if constexpr (std::is_same_v<LeftValueIDs, std::decay_t<decltype(right_value_ids)>>) {
+                _scan_rows(
+                    [&](const ChunkOffset chunk_offset) {
+                      return comparator(left_value_ids[chunk_offset], right_value_ids[chunk_offset]);
+                    },
+                    chunk_id, row_range, offset_filter, matches);
+              }
+            });
+          });
+          return;
+        }
+      }
+
+      _with_value_accessor<LeftType>(*left_segment, [&](const auto& left_value) {
+        _with_value_accessor<RightType>(*right_segment, [&](const auto& right_value) {
+          _scan_rows(
+              [&](const ChunkOffset chunk_offset) {
+                return comparator(left_value(chunk_offset), right_value(chunk_offset));
+              },
+              chunk_id, row_range, offset_filter, matches);
+        });
+      });
+    });
+  }
+
+ protected:
+  // calls functor with an accessor to the values of a value or dictionary segment
+  template <typename T, typename Functor>
+  static void _with_value_accessor(const BaseSegment& segment, const Functor& functor) {
+    if (const auto value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+      const auto* const values = value_segment->values().data();
+      functor([values](const ChunkOffset chunk_offset) -> const T& { return values[chunk_offset]; });
+      return;
+    }
+
+    if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+      const auto* const dictionary = dictionary_segment->dictionary()->data();
+      dictionary_segment->with_value_ids([&](const auto* const value_ids) {
+        functor([dictionary, value_ids](const ChunkOffset chunk_offset) -> const T& {
+          return dictionary[value_ids[chunk_offset]];
+        });
+      });
+      return;
+    }
+
+    Fail("Columns can only be compared on value or dictionary segments");
+  }
+
+  const ColumnID _left_column_id;
+  const ScanType _scan_type;
+  const ColumnID _right_column_id;
+};
+
+}  // namespace opossum
@@ -0,0 +1,292 @@
+#include "column_vs_value_table_scan_impl.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "storage/chunk.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/index/bitmap_index.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// IN lists up to this size are probed by binary search on a sorted array, which easily stays in the cache.
+// Larger lists are put into a hash set so that each probe is O(1).
+constexpr auto IN_LIST_HASH_SET_THRESHOLD = size_t{32};
+
+template <typename T>
+ColumnVsValueTableScanImpl<T>::ColumnVsValueTableScanImpl(const ColumnID column_id, const ScanPredicate& predicate)
+    : _column_id{column_id}, _scan_type{predicate.scan_type} {
+  switch (_scan_type) {
+    case ScanType::OpBetween:
+      _search_value = type_cast<T>(predicate.search_value);
+      _upper_value = type_cast<T>(*predicate.search_value2);
+      break;
+    case ScanType::OpIn:
+      _in_values.reserve(predicate.in_values.size());
+      for (const auto& in_value : predicate.in_values) {
+        _in_values.push_back(type_cast<T>(in_value));
+      }
+      std::sort(_in_values.begin(), _in_values.end());
+      _in_values.erase(std::unique(_in_values.begin(), _in_values.end()), _in_values.end());
+      if (_in_values.size() > IN_LIST_HASH_SET_THRESHOLD) {
+        _in_value_set = std::unordered_set<T>(_in_values.cbegin(), _in_values.cend());
+      }
+      break;
+    case ScanType::OpLike:
+    case ScanType::OpILike:
+      if constexpr (std::is_same_v<T, std::string>) {
+        _like_matcher.emplace(type_cast<std::string>(predicate.search_value), _scan_type == ScanType::OpILike);
+      } else {
+        Fail("LIKE can only be used on string columns");
+      }
+      break;
+    default:
+      _search_value = type_cast<T>(predicate.search_value);
+  }
+}
+
+template <typename T>
+void ColumnVsValueTableScanImpl<T>::scan_chunk(const Chunk& chunk, const ChunkID chunk_id,
+                                               const ChunkOffsetRange& row_range,
+                                               const std::vector<ChunkOffset>* offset_filter, PosList& matches) const {
+  const auto segment = chunk.get_segment(_column_id);
+
+  if (const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<T>>(segment)) {
+    DebugAssert(offset_filter || row_range.end <= value_segment->size(), "Row range out of bounds");
+    _scan_value_segment(*value_segment, chunk_id, row_range, offset_filter, matches);
+    return;
+  }
+
+  if (const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(segment)) {
+    DebugAssert(offset_filter || row_range.end <= dictionary_segment->size(), "Row range out of bounds");
+    _scan_dictionary_segment(*dictionary_segment, chunk_id, row_range, offset_filter, matches);
+    return;
+  }
+
+  Fail("Only value and dictionary segments of the column type can be scanned");
+}
+
+template <typename T>
+std::optional<std::pair<size_t, size_t>> ColumnVsValueTableScanImpl<T>::count_qualifying_values(
+    const Chunk& chunk) const {
+  const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(chunk.get_segment(_column_id));
+  if (!dictionary_segment) return std::nullopt;
+
+  // evaluating a LIKE pattern on the dictionary costs as much as the scan itself, we rather use the default
+  if (_like_matcher && !_like_matcher->prefix()) return std::nullopt;
+
+  return std::make_pair(_matching_value_ids(*dictionary_segment).count, dictionary_segment->unique_values_count());
+}
+
+template <typename T>
+bool ColumnVsValueTableScanImpl<T>::has_index(const Chunk& chunk) const {
+  const auto segment = chunk.get_segment(_column_id);
+  if (std::dynamic_pointer_cast<const DictionarySegment<T>>(segment)) {
+    return chunk.get_index(SegmentIndexType::Bitmap, {_column_id}) != nullptr;
+  }
+  if (std::dynamic_pointer_cast<const ValueSegment<T>>(segment)) {
+    return BaseIndex::supports(_scan_type) && chunk.get_index(SegmentIndexType::Cracking, {_column_id}) != nullptr;
+  }
+  return false;
+}
+
+template <typename T>
+std::optional<PositionBitmap> ColumnVsValueTableScanImpl<T>::lookup_index(const Chunk& chunk) const {
+  if (!has_index(chunk)) return std::nullopt;
+
+  const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(chunk.get_segment(_column_id));
+  if (!dictionary_segment) {
+    const auto index = chunk.get_index(SegmentIndexType::Cracking, {_column_id});
+    auto search_value2 = std::optional<AllTypeVariant>{};
+    if (_scan_type == ScanType::OpBetween) search_value2 = AllTypeVariant{_upper_value};
+    return index->lookup(_scan_type, {AllTypeVariant{_search_value}}, search_value2);
+  }
+
+  const auto index =
+      std::static_pointer_cast<const BitmapIndex>(chunk.get_index(SegmentIndexType::Bitmap, {_column_id}));
+
+  const auto matching_value_ids = _matching_value_ids(*dictionary_segment);
+  auto value_ids = std::vector<ValueID>{};
+  value_ids.reserve(matching_value_ids.count);
+  for (auto value_id = ValueID{0}; value_id < dictionary_segment->unique_values_count(); ++value_id) {
+    const auto is_match = matching_value_ids.bitmap
+                              ? (*matching_value_ids.bitmap)[value_id] != 0
+                              : (value_id >= matching_value_ids.begin && value_id < matching_value_ids.end) !=
+                                    matching_value_ids.negated;
+    if (is_match) value_ids.push_back(value_id);
+  }
+  return index->lookup_value_ids(value_ids);
+}
+
+template <typename T>
+typename ColumnVsValueTableScanImpl<T>::MatchingValueIDs ColumnVsValueTableScanImpl<T>::_matching_value_ids(
+    const DictionarySegment<T>& segment) const {
+  const auto dictionary_size = ValueID{static_cast<ValueID::base_type>(segment.unique_values_count())};
+  const auto value_id_or_end = [&](const ValueID value_id) {
+    return value_id == INVALID_VALUE_ID ? dictionary_size : value_id;
+  };
+
+  auto matching_value_ids = MatchingValueIDs{};
+  switch (_scan_type) {
+    case ScanType::OpEquals:
+      std::tie(matching_value_ids.begin, matching_value_ids.end) = segment.value_id_range(_search_value, _search_value);
+      break;
+    case ScanType::OpNotEquals:
+      std::tie(matching_value_ids.begin, matching_value_ids.end) = segment.value_id_range(_search_value, _search_value);
+      matching_value_ids.negated = true;
+      break;
+    case ScanType::OpLessThan:
+      matching_value_ids.end = value_id_or_end(segment.lower_bound(_search_value));
+      break;
+    case ScanType::OpLessThanEquals:
+      matching_value_ids.end = value_id_or_end(segment.upper_bound(_search_value));
+      break;
+    case ScanType::OpGreaterThan:
+      matching_value_ids.begin = value_id_or_end(segment.upper_bound(_search_value));
+      matching_value_ids.end = dictionary_size;
+      break;
+    case ScanType::OpGreaterThanEquals:
+      matching_value_ids.begin = value_id_or_end(segment.lower_bound(_search_value));
+      matching_value_ids.end = dictionary_size;
+      break;
+    case ScanType::OpBetween:
+      std::tie(matching_value_ids.begin, matching_value_ids.end) = segment.value_id_range(_search_value, _upper_value);
+      break;
+    case ScanType::OpIn: {
+      // translated into a bitmap over the value ids once, so that every row is checked in O(1)
+      auto& bitmap = matching_value_ids.bitmap.emplace(static_cast<size_t>(dictionary_size));
+      for (const auto& in_value : _in_values) {
+        const auto value_id = segment.find_value(in_value);
+        if (value_id == INVALID_VALUE_ID) continue;
+        bitmap[value_id] = 1;
+        ++matching_value_ids.count;
+      }
+      return matching_value_ids;
+    }
+    case ScanType::OpLike:
+    case ScanType::OpILike:
+      if constexpr (std::is_same_v<T, std::string>) {
+        const auto& dictionary = *segment.dictionary();
+
+        // the matches of a case-sensitive prefix pattern ('abc%') form a single value id range
+        if (const auto prefix = _like_matcher->prefix()) {
+          const auto begin = std::lower_bound(dictionary.cbegin(), dictionary.cend(), *prefix);
+          const auto end = std::partition_point(begin, dictionary.cend(), [&](const std::string& value) {
+            return value.compare(0, prefix->size(), *prefix) == 0;
+          });
+          matching_value_ids.begin = ValueID{static_cast<ValueID::base_type>(begin - dictionary.cbegin())};
+          matching_value_ids.end = ValueID{static_cast<ValueID::base_type>(end - dictionary.cbegin())};
+          break;
+        }
+
+        // otherwise, the pattern is evaluated once per dictionary entry instead of once per row
+        auto& bitmap = matching_value_ids.bitmap.emplace(static_cast<size_t>(dictionary_size));
+        for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+          if (!_like_matcher->matches(dictionary[value_id])) continue;
+          bitmap[value_id] = 1;
+          ++matching_value_ids.count;
+        }
+        return matching_value_ids;
+      }
+      break;
+  }
+
+  const auto range_size = static_cast<size_t>(matching_value_ids.end - matching_value_ids.begin);
+  matching_value_ids.count = matching_value_ids.negated ? dictionary_size - range_size : range_size;
+  return matching_value_ids;
+}
+
+template <typename T>
+void ColumnVsValueTableScanImpl<T>::_scan_value_segment(const ValueSegment<T>& segment, const ChunkID chunk_id,
+                                                        const ChunkOffsetRange& row_range,
+                                                        const std::vector<ChunkOffset>* offset_filter,
+                                                        PosList& matches) const {
+  const auto* const values = segment.values().data();
+
+  switch (_scan_type) {
+    case ScanType::OpBetween: {
+      const auto lower_value = _search_value;
+      const auto upper_value = _upper_value;
+      _scan_rows(
+          [&](const ChunkOffset chunk_offset) {
+            return lower_value <= values[chunk_offset] && values[chunk_offset] <= upper_value;
+          },
+          chunk_id, row_range, offset_filter, matches);
+      return;
+    }
+    case ScanType::OpIn:
+      if (_in_value_set.empty()) {
+        _scan_rows(
+            [&](const ChunkOffset chunk_offset) {
+              return std::binary_search(_in_values.cbegin(), _in_values.cend(), values[chunk_offset]);
+            },
+            chunk_id, row_range, offset_filter, matches);
+      } else {
+        _scan_rows([&](const ChunkOffset chunk_offset) { return _in_value_set.count(values[chunk_offset]) > 0; },
+                   chunk_id, row_range, offset_filter, matches);
+      }
+      return;
+    case ScanType::OpLike:
+    case ScanType::OpILike:
+      if constexpr (std::is_same_v<T, std::string>) {
+        _scan_rows([&](const ChunkOffset chunk_offset) { return _like_matcher->matches(values[chunk_offset]); },
+                   chunk_id, row_range, offset_filter, matches);
+      }
+      return;
+    default:
+      // the search value is copied so that the compiler knows it does not change during the loop
+      const auto search_value = _search_value;
+      _resolve_comparator(_scan_type, [&](const auto comparator) {
+        _scan_rows([&](const ChunkOffset chunk_offset) { return comparator(values[chunk_offset], search_value); },
+                   chunk_id, row_range, offset_filter, matches);
+      });
+  }
+}
+
+template <typename T>
+void ColumnVsValueTableScanImpl<T>::_scan_dictionary_segment(const DictionarySegment<T>& segment,
+                                                             const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                                                             const std::vector<ChunkOffset>* offset_filter,
+                                                             PosList& matches) const {
+  const auto matching_value_ids = _matching_value_ids(segment);
+
+  // if the dictionary shows that all or none of the rows match, the value ids do not need to be looked at
+  if (matching_value_ids.count == 0) return;
+  if (matching_value_ids.count == segment.unique_values_count()) {
+    _append_all_rows(chunk_id, row_range, offset_filter, matches);
+    return;
+  }
+
+  segment.with_value_ids([&](const auto* const value_ids) {
+    if (matching_value_ids.bitmap) {
+      const auto* const bitmap = matching_value_ids.bitmap->data();
+      _scan_rows([&](const ChunkOffset chunk_offset) { return bitmap[value_ids[chunk_offset]] != 0; }, chunk_id,
+                 row_range, offset_filter, matches);
+      return;
+    }
+
+    // begin <= value_id < end as a single unsigned comparison
+    const auto begin = static_cast<uint32_t>(matching_value_ids.begin);
+    const auto range_size = static_cast<uint32_t>(matching_value_ids.end - matching_value_ids.begin);
+    if (matching_value_ids.negated) {
+      _scan_rows([&](const ChunkOffset chunk_offset) { return value_ids[chunk_offset] - begin >= range_size; },
+                 chunk_id, row_range, offset_filter, matches);
+    } else {
+      _scan_rows([&](const ChunkOffset chunk_offset) { return value_ids[chunk_offset] - begin < range_size; },
+                 chunk_id, row_range, offset_filter, matches);
+    }
+  });
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(ColumnVsValueTableScanImpl);
+
+}  // namespace opossum
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "base_table_scan_impl.hpp"
+#include "operators/table_scan.hpp"
+#include "types.hpp"
+#include "utils/like_matcher.hpp"
+
+namespace opossum {
+
+template <typename T>
+class DictionarySegment;
+
+template <typename T>
+class ValueSegment;
+
+// Compares a column of type T with the search value(s) of a predicate. The search values are converted to T once,
+// on construction. Value segments are scanned with a comparator that is fixed at compile time, dictionary segments
+// translate the predicate into the set of qualifying value ids and only compare those.
+template <typename T>
+class ColumnVsValueTableScanImpl : public BaseTableScanImpl {
+ public:
+  // column_id refers to the scanned data table, which, for reference inputs, is the referenced table
+  ColumnVsValueTableScanImpl(const ColumnID column_id, const ScanPredicate& predicate);
+
+  void scan_chunk(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                  const std::vector<ChunkOffset>* offset_filter, PosList& matches) const override;
+
+  std::optional<std::pair<size_t, size_t>> count_qualifying_values(const Chunk& chunk) const override;
+
+  // dictionary segments are looked up in a BitmapIndex, which unites the bitmaps of the qualifying value ids, value
+  // segments in a CrackerIndex, which supports comparisons and OpBetween
+  bool has_index(const Chunk& chunk) const override;
+  std::optional<PositionBitmap> lookup_index(const Chunk& chunk) const override;
+
+ protected:
+  // the value ids of a dictionary segment that satisfy the predicate: those in [begin, end) or, if negated, all
+  // others. If a bitmap is given, it marks the qualifying value ids instead.
+  struct MatchingValueIDs {
+    ValueID begin{0};
+    ValueID end{0};
+    bool negated = false;
+    std::optional<std::vector<uint8_t>> bitmap;
+    size_t count = 0;
+  };
+
+  MatchingValueIDs _matching_value_ids(const DictionarySegment<T>& segment) const;
+
+  void _scan_value_segment(const ValueSegment<T>& segment, const ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                           const std::vector<ChunkOffset>* offset_filter, PosList& matches) const;
+
+  void _scan_dictionary_segment(const DictionarySegment<T>& segment, const ChunkID chunk_id,
+                                const ChunkOffsetRange& row_range, const std::vector<ChunkOffset>* offset_filter,
+                                PosList& matches) const;
+
+  const ColumnID _column_id;
+  const ScanType _scan_type;
+
+  // for OpBetween, _search_value is the lower and _upper_value the upper bound
+  T _search_value{};
+  T _upper_value{};
+
+  // the values of OpIn, sorted and without duplicates. Large lists are additionally put into a hash set.
+  std::vector<T> _in_values;
+  std::unordered_set<T> _in_value_set;
+
+  std::optional<LikeMatcher> _like_matcher;
+};
+
+}  // namespace opossum
@@ -0,0 +1,374 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// a row that may belong to the result, with its value in the first sort column, the slot that holds its values in the
+// other sort columns (see SortColumnValues), and its position in the input
+template <typename T>
+struct Candidate {
+  bool first_is_null;
+  T first_value;
+  size_t slot;
+  RowID position;
+};
+
+// the order of the rows by a single column: NULLs come first in ascending and last in descending order
+template <typename T>
+bool value_precedes(const bool descending, const bool lhs_is_null, const T& lhs, const bool rhs_is_null,
+                    const T& rhs) {
+  if (lhs_is_null || rhs_is_null) return descending ? !lhs_is_null && rhs_is_null : lhs_is_null && !rhs_is_null;
+  return descending ? rhs < lhs : lhs < rhs;
+}
+
+// the values of a sort column other than the first one, for the candidates of a heap, each in a slot, and for a batch
+// of rows that are offered to the heap. The values of a batch are gathered at once, and all comparisons are typed.
+class BaseSortColumnValues {
+ public:
+  virtual ~BaseSortColumnValues() = default;
+
+  // replaces the batch with the values of segment at the given offsets
+  virtual void gather_batch(const BaseSegment& segment, const std::vector<ChunkOffset>& offsets) = 0;
+
+  // stores the value of a row of the batch in a slot
+  virtual void store_batch_value(const size_t batch_index, const size_t slot) = 0;
+
+  // stores the value in other_slot of other, which holds values of the same column, in a slot
+  virtual void store_value(const BaseSortColumnValues& other, const size_t other_slot, const size_t slot) = 0;
+
+  // returns a negative number if the value in lhs_slot comes first, a positive one if that in rhs_slot does, and 0
+  // if they are equal
+  virtual int compare(const size_t lhs_slot, const size_t rhs_slot) const = 0;
+};
+
+template <typename T>
+class SortColumnValues : public BaseSortColumnValues {
+ public:
+  explicit SortColumnValues(const bool descending) : _descending{descending} {}
+
+  void gather_batch(const BaseSegment& segment, const std::vector<ChunkOffset>& offsets) override {
+    _batch_values.resize(offsets.size());
+    gather_values(segment, offsets, _batch_values.data());
+    _batch_is_null.assign(offsets.size(), 0);
+    if (const auto* const positions = nullable_positions(segment)) {
+      for (auto index = size_t{0}; index < offsets.size(); ++index) {
+        _batch_is_null[index] = (*positions)[offsets[index]] == NULL_ROW_ID;
+      }
+    }
+  }
+
+  void store_batch_value(const size_t batch_index, const size_t slot) override {
+    _reserve_slot(slot);
+    _values[slot] = _batch_values[batch_index];
+    _is_null[slot] = _batch_is_null[batch_index];
+  }
+
+  void store_value(const BaseSortColumnValues& other, const size_t other_slot, const size_t slot) override {
+    // other may be this object, so its values are only accessed after the slot has been reserved
+    _reserve_slot(slot);
+    const auto& typed_other = static_cast<const SortColumnValues<T>&>(other);
+    _values[slot] = typed_other._values[other_slot];
+    _is_null[slot] = typed_other._is_null[other_slot];
+  }
+
+  int compare(const size_t lhs_slot, const size_t rhs_slot) const override {
+    if (value_precedes(_descending, _is_null[lhs_slot], _values[lhs_slot], _is_null[rhs_slot], _values[rhs_slot])) {
+      return -1;
+    }
+    if (value_precedes(_descending, _is_null[rhs_slot], _values[rhs_slot], _is_null[lhs_slot], _values[lhs_slot])) {
+      return 1;
+    }
+    return 0;
+  }
+
+ private:
+  void _reserve_slot(const size_t slot) {
+    if (slot < _values.size()) return;
+    _values.resize(slot + 1);
+    _is_null.resize(slot + 1);
+  }
+
+  const bool _descending;
+  std::vector<T> _values;
+  std::vector<uint8_t> _is_null;
+  std::vector<T> _batch_values;
+  std::vector<uint8_t> _batch_is_null;
+};
+
+// a bounded heap of the best k candidates of a worker, the worst of them at its front
+template <typename T>
+class CandidateHeap {
+ public:
+  CandidateHeap(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions, const size_t k)
+      : _descending{sort_definitions.front().order_by_mode == OrderByMode::Descending}, _k{k} {
+    for (auto column = size_t{1}; column < sort_definitions.size(); ++column) {
+      const auto& definition = sort_definitions[column];
+      resolve_data_type(table.column_type(definition.column_id), [&](auto type) {
+        using ColumnType = typename decltype(type)::type;
+        _columns.push_back(
+            std::make_unique<SortColumnValues<ColumnType>>(definition.order_by_mode == OrderByMode::Descending));
+      });
+    }
+  }
+
+  bool is_full() const { return _candidates.size() == _k; }
+
+  const Candidate<T>& worst() const { return _candidates.front(); }
+
+  // whether a row with the given value in the first sort column cannot make it into the heap
+  bool excludes(const bool is_null, const T& value) const {
+    return is_full() && value_precedes(_descending, worst().first_is_null, worst().first_value, is_null, value);
+  }
+
+  // the order of the rows by all sort columns, equal rows in the order of the input
+  bool candidate_precedes(const Candidate<T>& lhs, const Candidate<T>& rhs) const {
+    if (value_precedes(_descending, lhs.first_is_null, lhs.first_value, rhs.first_is_null, rhs.first_value)) {
+      return true;
+    }
+    if (value_precedes(_descending, rhs.first_is_null, rhs.first_value, lhs.first_is_null, lhs.first_value)) {
+      return false;
+    }
+    for (const auto& column : _columns) {
+      const auto comparison = column->compare(lhs.slot, rhs.slot);
+      if (comparison != 0) return comparison < 0;
+    }
+    return lhs.position < rhs.position;
+  }
+
+  // gathers the values of the other sort columns of the rows at the given offsets of a chunk
+  void gather_batch(const std::vector<std::shared_ptr<BaseSegment>>& segments,
+                    const std::vector<ChunkOffset>& offsets) {
+    for (auto column = size_t{0}; column < _columns.size(); ++column) {
+      _columns[column]->gather_batch(*segments[column], offsets);
+    }
+  }
+
+  // offers the row at batch_index of the last gathered batch
+  void offer(const bool is_null, const T& value, const size_t batch_index, const RowID& position) {
+    for (const auto& column : _columns) column->store_batch_value(batch_index, INCOMING_SLOT);
+    _offer(Candidate<T>{is_null, value, INCOMING_SLOT, position});
+  }
+
+  // offers all candidates of other, which was built for the same sort columns
+  void merge(const CandidateHeap<T>& other) {
+    for (const auto& candidate : other._candidates) {
+      for (auto column = size_t{0}; column < _columns.size(); ++column) {
+        _columns[column]->store_value(*other._columns[column], candidate.slot, INCOMING_SLOT);
+      }
+      _offer(Candidate<T>{candidate.first_is_null, candidate.first_value, INCOMING_SLOT, candidate.position});
+    }
+  }
+
+  std::vector<Candidate<T>>& candidates() { return _candidates; }
+
+ private:
+  // the slot that holds the values of the row that is offered, the candidates use the slots after it
+  static constexpr size_t INCOMING_SLOT = 0;
+
+  // offers a candidate whose values are in INCOMING_SLOT
+  void _offer(Candidate<T>&& candidate) {
+    const auto less = [&](const Candidate<T>& lhs, const Candidate<T>& rhs) { return candidate_precedes(lhs, rhs); };
+    if (is_full()) {
+      if (!candidate_precedes(candidate, worst())) return;
+      std::pop_heap(_candidates.begin(), _candidates.end(), less);
+      candidate.slot = _candidates.back().slot;
+      _candidates.back() = std::move(candidate);
+    } else {
+      candidate.slot = _candidates.size() + 1;
+      _candidates.push_back(std::move(candidate));
+    }
+    for (const auto& column : _columns) column->store_value(*column, INCOMING_SLOT, _candidates.back().slot);
+    std::push_heap(_candidates.begin(), _candidates.end(), less);
+  }
+
+  const bool _descending;
+  const size_t _k;
+  std::vector<std::unique_ptr<BaseSortColumnValues>> _columns;
+  std::vector<Candidate<T>> _candidates;
+};
+
+// offers the rows of a chunk to the heap, given the values of the first sort column for which excludes() is false.
+// The rows are collected in batches, for which the other sort columns are gathered at once. flush() has to be called
+// after the last row of the chunk.
+template <typename T>
+class ChunkScanner {
+ public:
+  static constexpr size_t BATCH_SIZE = 1024;
+
+  ChunkScanner(const std::vector<SortColumnDefinition>& sort_definitions, const Chunk& chunk, const ChunkID chunk_id,
+               CandidateHeap<T>& heap)
+      : _chunk_id{chunk_id}, _heap{heap} {
+    for (auto column = size_t{1}; column < sort_definitions.size(); ++column) {
+      _segments.push_back(chunk.get_segment(sort_definitions[column].column_id));
+    }
+  }
+
+  void offer(const ChunkOffset chunk_offset, const bool is_null, const T& value) {
+    _offsets.push_back(chunk_offset);
+    _is_null.push_back(is_null);
+    _values.push_back(value);
+    if (_offsets.size() == BATCH_SIZE) flush();
+  }
+
+  // offers the collected rows to the heap
+  void flush() {
+    if (_offsets.empty()) return;
+    _heap.gather_batch(_segments, _offsets);
+    for (auto index = size_t{0}; index < _offsets.size(); ++index) {
+      // the threshold may have improved since the row was collected
+      if (_heap.excludes(_is_null[index], _values[index])) continue;
+      _heap.offer(_is_null[index], _values[index], index, RowID{_chunk_id, _offsets[index]});
+    }
+    _offsets.clear();
+    _is_null.clear();
+    _values.clear();
+  }
+
+ private:
+  const ChunkID _chunk_id;
+  CandidateHeap<T>& _heap;
+  std::vector<std::shared_ptr<BaseSegment>> _segments;
+  std::vector<ChunkOffset> _offsets;
+  std::vector<uint8_t> _is_null;
+  std::vector<T> _values;
+};
+
+// scans a chunk whose first sort column is a DictionarySegment, which holds no NULLs
+template <typename T>
+void scan_dictionary_chunk(const DictionarySegment<T>& segment, const bool descending, CandidateHeap<T>& heap,
+                           ChunkScanner<T>& scanner) {
+  const auto& dictionary = *segment.dictionary();
+  if (dictionary.empty()) return;
+  // the dictionary may be shared with other chunks, so its values only bound those of this chunk
+  if (heap.excludes(false, descending ? dictionary.back() : dictionary.front())) return;
+
+  // the value ids of the rows that can beat the threshold are in [value_id_begin, value_id_end)
+  auto value_id_begin = size_t{0};
+  auto value_id_end = dictionary.size();
+  if (heap.is_full() && !heap.worst().first_is_null) {
+    const auto& threshold = heap.worst().first_value;
+    if (descending) {
+      value_id_begin = std::lower_bound(dictionary.cbegin(), dictionary.cend(), threshold) - dictionary.cbegin();
+    } else {
+      value_id_end = std::upper_bound(dictionary.cbegin(), dictionary.cend(), threshold) - dictionary.cbegin();
+    }
+  }
+
+  segment.with_value_ids([&](const auto* const value_ids) {
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment.size(); ++chunk_offset) {
+      const auto value_id = static_cast<size_t>(value_ids[chunk_offset]);
+      if (value_id < value_id_begin || value_id >= value_id_end) continue;
+      // the threshold may have improved since the chunk was started
+      const auto& value = dictionary[value_id];
+      if (!heap.excludes(false, value)) scanner.offer(chunk_offset, false, value);
+    }
+  });
+}
+
+template <typename T>
+std::vector<Candidate<T>> find_candidates(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions,
+                                          const size_t k) {
+  const auto first_column_id = sort_definitions.front().column_id;
+  const auto descending = sort_definitions.front().order_by_mode == OrderByMode::Descending;
+
+  const auto chunk_count = static_cast<size_t>(table.chunk_count());
+  const auto job_count = std::max(size_t{1}, std::min(chunk_count, ThreadPool::get().worker_count()));
+  std::vector<CandidateHeap<T>> heaps;
+  heaps.reserve(job_count);
+  for (auto job_id = size_t{0}; job_id < job_count; ++job_id) heaps.emplace_back(table, sort_definitions, k);
+
+  std::vector<std::function<void()>> jobs;
+  for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+    jobs.emplace_back([&, job_id]() {
+      auto& heap = heaps[job_id];
+      const auto chunk_id_begin = ChunkID{static_cast<ChunkID::base_type>(job_id * chunk_count / job_count)};
+      const auto chunk_id_end = ChunkID{static_cast<ChunkID::base_type>((job_id + 1) * chunk_count / job_count)};
+      std::vector<T> values;
+      for (auto chunk_id = chunk_id_begin; chunk_id < chunk_id_end; ++chunk_id) {
+        const auto& chunk = table.get_chunk(chunk_id);
+        if (chunk.size() == 0) continue;
+        auto scanner = ChunkScanner<T>{sort_definitions, chunk, chunk_id, heap};
+        const auto segment = chunk.get_segment(first_column_id);
+
+        if (const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<T>>(segment)) {
+          scan_dictionary_chunk(*dictionary_segment, descending, heap, scanner);
+          scanner.flush();
+          continue;
+        }
+
+        values.resize(chunk.size());
+        materialize_values(*segment, ChunkOffsetRange{0, chunk.size()}, values.data());
+        const auto* const positions = nullable_positions(*segment);
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+          const auto is_null = positions && (*positions)[chunk_offset] == NULL_ROW_ID;
+          if (!heap.excludes(is_null, values[chunk_offset])) scanner.offer(chunk_offset, is_null, values[chunk_offset]);
+        }
+        scanner.flush();
+      }
+    });
+  }
+  ThreadPool::get().execute_and_wait(jobs);
+
+  // merges the heaps of all workers
+  auto& heap = heaps.front();
+  for (auto job_id = size_t{1}; job_id < job_count; ++job_id) heap.merge(heaps[job_id]);
+  auto& result = heap.candidates();
+  std::sort(result.begin(), result.end(),
+            [&](const Candidate<T>& lhs, const Candidate<T>& rhs) { return heap.candidate_precedes(lhs, rhs); });
+  if (result.size() > k) result.erase(result.begin() + k, result.end());
+  return std::move(result);
+}
+
+}  // namespace
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const size_t k)
+    : AbstractOperator(in), _sort_definitions{sort_definitions}, _k{k} {}
+
+const std::vector<SortColumnDefinition>& TopK::sort_definitions() const { return _sort_definitions; }
+
+size_t TopK::k() const { return _k; }
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  const auto input_table = _input_table_left();
+  Assert(!_sort_definitions.empty(), "TopK needs at least one sort column");
+  for (const auto& definition : _sort_definitions) {
+    Assert(definition.column_id < input_table->column_count(), "Sort column does not exist");
+  }
+
+  auto positions = std::make_shared<PosList>();
+  if (_k > 0) {
+    resolve_data_type(input_table->column_type(_sort_definitions.front().column_id), [&](auto type) {
+      using ColumnType = typename decltype(type)::type;
+      for (const auto& candidate : find_candidates<ColumnType>(*input_table, _sort_definitions, _k)) {
+        positions->push_back(candidate.position);
+      }
+    });
+  }
+
+  auto output = std::make_shared<Table>(input_table->max_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+  Chunk chunk;
+  _add_reference_segments(input_table, positions, chunk);
+  output->emplace_chunk(std::move(chunk));
+  return output;
+}
+
+}  // namespace opossum
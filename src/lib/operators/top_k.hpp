@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "sort.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Returns the first k rows of the input in the order that Sort would produce for the same sort definitions, i.e.,
+// ORDER BY ... LIMIT k, without sorting the whole input. The output is a single chunk that references the input.
+//
+// The chunks are split into one range per worker, and every worker keeps the best k rows of its range in a bounded
+// heap. Once the heap is full, its last row is the threshold a row has to beat: rows whose value in the first sort
+// column comes after it are skipped without looking at the other columns. If the first sort column of a chunk is a
+// DictionarySegment, the chunk is skipped as a whole if even the best value of its dictionary comes after the
+// threshold, and otherwise its rows are filtered by comparing their value ids with the value id of the threshold. The
+// values of the other sort columns are only gathered for the rows that pass this filter, in typed batches. In the end,
+// the heaps of all workers are merged.
+class TopK : public AbstractOperator {
+ public:
+  TopK(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t k);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+  size_t k() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const size_t _k;
+};
+
+}  // namespace opossum
@@ -0,0 +1,15 @@
+#include "union_positions.hpp"
+
+#include <memory>
+
+namespace opossum {
+
+UnionPositions::UnionPositions(const std::shared_ptr<const AbstractOperator> left,
+                               const std::shared_ptr<const AbstractOperator> right)
+    : AbstractPositionSetOperator(left, right) {}
+
+PositionBitmap UnionPositions::_combine(const PositionBitmap& left, const PositionBitmap& right) const {
+  return left.unite(right);
+}
+
+}  // namespace opossum
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <memory>
+
+#include "abstract_position_set_operator.hpp"
+
+namespace opossum {
+
+// returns the rows referenced by either input, each of them once (see AbstractPositionSetOperator)
+class UnionPositions : public AbstractPositionSetOperator {
+ public:
+  UnionPositions(const std::shared_ptr<const AbstractOperator> left,
+                 const std::shared_ptr<const AbstractOperator> right);
+
+ protected:
+  PositionBitmap _combine(const PositionBitmap& left, const PositionBitmap& right) const override;
+};
+
+}  // namespace opossum
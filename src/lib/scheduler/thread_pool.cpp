@@ -0,0 +1,163 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr auto NO_WORKER = std::numeric_limits<size_t>::max();
+
+// identifies the queue of the worker a thread belongs to, NO_WORKER for all other threads
+thread_local size_t current_worker_id = NO_WORKER;
+
+}  // namespace
+
+ThreadPool& ThreadPool::get() {
+  static ThreadPool instance(std::max(1u, std::thread::hardware_concurrency()));
+  return instance;
+}
+
+ThreadPool::ThreadPool(const size_t worker_count) {
+  DebugAssert(worker_count > 0, "ThreadPool needs at least one worker");
+  _queues.reserve(worker_count);
+  for (auto worker_id = size_t{0}; worker_id < worker_count; ++worker_id) {
+    _queues.push_back(std::make_unique<JobQueue>());
+  }
+
+  _workers.reserve(worker_count);
+  for (auto worker_id = size_t{0}; worker_id < worker_count; ++worker_id) {
+    _workers.emplace_back([this, worker_id]() { _work(worker_id); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  _shutdown = true;
+  {
+    std::lock_guard<std::mutex> lock(_wake_up_mutex);
+  }
+  _wake_up.notify_all();
+
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::worker_count() const { return _workers.size(); }
+
+void ThreadPool::execute_and_wait(const std::vector<std::function<void()>>& jobs) {
+  if (jobs.empty()) return;
+
+  // a single job is not worth the hand-over to another thread
+  if (jobs.size() == 1) {
+    jobs.front()();
+    return;
+  }
+
+  struct Batch {
+    std::atomic<size_t> remaining_job_count;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr exception;
+  };
+
+  auto batch = std::make_shared<Batch>();
+  batch->remaining_job_count = jobs.size();
+
+  for (const auto& job : jobs) {
+    // the jobs are only referenced, as we do not return before all of them have finished
+    _push([batch, &job]() {
+      try {
+        job();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        if (!batch->exception) batch->exception = std::current_exception();
+      }
+
+      if (--batch->remaining_job_count == 0) {
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        batch->finished.notify_all();
+      }
+    });
+  }
+
+  // instead of idling, the waiting thread helps with the pending jobs
+  const auto queue_id = current_worker_id != NO_WORKER ? current_worker_id : size_t{0};
+  while (batch->remaining_job_count > 0) {
+    if (_try_run_job(queue_id)) continue;
+
+    // the remaining jobs are running on other threads
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->finished.wait_for(lock, std::chrono::milliseconds(1), [&]() { return batch->remaining_job_count == 0; });
+  }
+
+  if (batch->exception) std::rethrow_exception(batch->exception);
+}
+
+void ThreadPool::_push(std::function<void()> job) {
+  const auto queue_id = current_worker_id != NO_WORKER ? current_worker_id : _next_queue++ % _queues.size();
+
+  // the counter is increased first so that it never drops below zero when a job is taken right away
+  ++_queued_job_count;
+  {
+    auto& queue = *_queues[queue_id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_wake_up_mutex);
+  }
+  _wake_up.notify_one();
+}
+
+bool ThreadPool::_try_run_job(const size_t queue_id) {
+  auto job = std::function<void()>{};
+
+  // the own queue is used as a stack, the most recent job is the most likely to find its data in the cache
+  {
+    auto& queue = *_queues[queue_id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    }
+  }
+
+  // steal the oldest job of another queue
+  for (auto offset = size_t{1}; !job && offset < _queues.size(); ++offset) {
+    auto& queue = *_queues[(queue_id + offset) % _queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    }
+  }
+
+  if (!job) return false;
+
+  --_queued_job_count;
+  job();
+  return true;
+}
+
+void ThreadPool::_work(const size_t worker_id) {
+  current_worker_id = worker_id;
+
+  while (!_shutdown) {
+    if (_try_run_job(worker_id)) continue;
+
+    std::unique_lock<std::mutex> lock(_wake_up_mutex);
+    _wake_up.wait(lock, [&]() { return _shutdown || _queued_job_count > 0; });
+  }
+}
+
+}  // namespace opossum
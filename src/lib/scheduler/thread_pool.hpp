@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * The ThreadPool is a singleton that runs jobs on one worker thread per hardware thread.
+ *
+ * Every worker owns a queue. Jobs are distributed round-robin over these queues (or pushed to the own queue when a
+ * worker submits jobs itself). A worker takes jobs from the back of its own queue and, once it runs dry, steals from
+ * the front of the other queues. This keeps all workers busy even if the jobs are of very different cost.
+ *
+ * Operators hand in a batch of jobs with execute_and_wait(). The calling thread does not sleep but works on pending
+ * jobs until the batch is done, so jobs can submit further batches without dead-locking the pool.
+ */
+class ThreadPool : private Noncopyable {
+ public:
+  static ThreadPool& get();
+
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool&&) = delete;
+
+  size_t worker_count() const;
+
+  // runs all jobs and returns once they have finished
+  // if a job throws, the first exception is rethrown here after all jobs of the batch have finished
+  void execute_and_wait(const std::vector<std::function<void()>>& jobs);
+
+ protected:
+  explicit ThreadPool(const size_t worker_count);
+
+  struct JobQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> jobs;
+  };
+
+  void _push(std::function<void()> job);
+
+  // takes a job from the own queue or steals one from another queue, returns false if all queues are empty
+  bool _try_run_job(const size_t queue_id);
+
+  void _work(const size_t worker_id);
+
+  std::vector<std::unique_ptr<JobQueue>> _queues;
+  std::vector<std::thread> _workers;
+
+  std::atomic<size_t> _next_queue{0};
+  std::atomic<size_t> _queued_job_count{0};
+  std::atomic<bool> _shutdown{false};
+
+  std::mutex _wake_up_mutex;
+  std::condition_variable _wake_up;
+};
+
+}  // namespace opossum
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+
+#include "base_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// BaseTypedSegment is the super class of all segments that store values of type T themselves,
+// e.g., ValueSegment<T> and DictionarySegment<T>. It provides typed bulk access, which operators should prefer over
+// operator[] as it neither creates an AllTypeVariant per value nor calls a virtual method per value.
+// To read any segment, including ReferenceSegments, use the functions in segment_accessor.hpp.
+template <typename T>
+class BaseTypedSegment : public BaseSegment {
+ public:
+  // gather() prefetches the values this many offsets ahead
+  static constexpr size_t GATHER_PREFETCH_DISTANCE = 16;
+
+  // writes the values of the rows in row_range to output, which has to have room for all of them
+  virtual void materialize(const ChunkOffsetRange& row_range, T* output) const = 0;
+
+  // writes the values at the given offsets to output, which has to have room for all of them
+  virtual void gather(const std::vector<ChunkOffset>& offsets, T* output) const = 0;
+};
+
+}  // namespace opossum
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iomanip>
 #include <iterator>
 #include <limits>
@@ -9,6 +10,7 @@
 
 #include "base_segment.hpp"
 #include "chunk.hpp"
+#include "index/base_index.hpp"
 
 #include "utils/assert.hpp"
 
@@ -18,6 +20,8 @@ void Chunk::add_segment(std::shared_ptr<BaseSegment> segment) { _columns.push_ba
 
 void Chunk::append(const std::vector<AllTypeVariant>& values) {
   DebugAssert(values.size() == column_count(), "Row size mismatch while appending a new row.");
+  // indexes only cover the rows they were built on, an appended row would be missing from their lookups
+  Assert(_indexes.empty(), "Rows cannot be appended to an indexed chunk.");
   ColumnID max_bounds_index = ColumnID{column_count()};
   for (ColumnID current_index = ColumnID{0}; current_index < max_bounds_index; ++current_index) {
     _columns[current_index]->append(values[current_index]);
@@ -41,4 +45,48 @@ uint32_t Chunk::size() const {
   }
 }
 
+std::vector<std::shared_ptr<const BaseIndex>> Chunk::get_indexes(const std::vector<ColumnID>& column_ids) const {
+  const auto segments = _get_segments(column_ids);
+  auto indexes = std::vector<std::shared_ptr<const BaseIndex>>{};
+  for (const auto& index : _indexes) {
+    if (index->is_index_for(segments)) indexes.push_back(index);
+  }
+  return indexes;
+}
+
+std::shared_ptr<const BaseIndex> Chunk::get_index(const SegmentIndexType index_type,
+                                                  const std::vector<ColumnID>& column_ids) const {
+  const auto segments = _get_segments(column_ids);
+  for (const auto& index : _indexes) {
+    if (index->type() == index_type && index->indexed_segments() == segments) return index;
+  }
+  return nullptr;
+}
+
+void Chunk::remove_index(const std::shared_ptr<const BaseIndex>& index) {
+  const auto it = std::find(_indexes.cbegin(), _indexes.cend(), index);
+  DebugAssert(it != _indexes.cend(), "Index is not part of the chunk");
+  _indexes.erase(it);
+}
+
+size_t Chunk::estimate_memory_usage() const {
+  auto memory_usage = size_t{0};
+  for (const auto& segment : _columns) {
+    memory_usage += segment->estimate_memory_usage();
+  }
+  for (const auto& index : _indexes) {
+    memory_usage += index->estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
+std::vector<std::shared_ptr<const BaseSegment>> Chunk::_get_segments(const std::vector<ColumnID>& column_ids) const {
+  auto segments = std::vector<std::shared_ptr<const BaseSegment>>{};
+  segments.reserve(column_ids.size());
+  for (const auto& column_id : column_ids) {
+    segments.push_back(get_segment(column_id));
+  }
+  return segments;
+}
+
 }  // namespace opossum
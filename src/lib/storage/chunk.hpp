@@ -45,8 +45,34 @@ class Chunk : private Noncopyable {
   // Returns the segment at a given position
   std::shared_ptr<BaseSegment> get_segment(ColumnID column_id) const;
 
+  // creates an index of type Index (see storage/index/) on the segments of the given columns, e.g.,
+  //   chunk.create_index<SortedIndex>({ColumnID{0}, ColumnID{2}});
+  // Indexes are built on the current content of the segments, appending rows afterwards fails. They belong to the
+  // chunk and are gone when it is replaced, e.g., by Table::compress_chunk.
+  template <typename Index>
+  std::shared_ptr<Index> create_index(const std::vector<ColumnID>& column_ids) {
+    auto index = std::make_shared<Index>(_get_segments(column_ids));
+    _indexes.push_back(index);
+    return index;
+  }
+
+  // returns the indexes that can look up the given columns, i.e., whose first indexed columns they are
+  std::vector<std::shared_ptr<const BaseIndex>> get_indexes(const std::vector<ColumnID>& column_ids) const;
+
+  // returns the index of the given type on exactly the given columns, or nullptr if there is none
+  std::shared_ptr<const BaseIndex> get_index(const SegmentIndexType index_type,
+                                             const std::vector<ColumnID>& column_ids) const;
+
+  void remove_index(const std::shared_ptr<const BaseIndex>& index);
+
+  // returns the calculated memory usage of the segments and indexes
+  size_t estimate_memory_usage() const;
+
  protected:
+  std::vector<std::shared_ptr<const BaseSegment>> _get_segments(const std::vector<ColumnID>& column_ids) const;
+
   std::vector<std::shared_ptr<BaseSegment>> _columns;
+  std::vector<std::shared_ptr<BaseIndex>> _indexes;
 };
 
 }  // namespace opossum
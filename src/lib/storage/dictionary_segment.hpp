@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <numeric>
@@ -8,7 +9,7 @@
 #include <vector>
 
 #include "all_type_variant.hpp"
-#include "storage/base_segment.hpp"
+#include "storage/base_typed_segment.hpp"
 #include "storage/fixed_size_attribute_vector.hpp"
 #include "storage/value_segment.hpp"
 #include "type_cast.hpp"
@@ -23,12 +24,9 @@ class BaseAttributeVector;
 // types (uint8_t, uint16_t) since after a down-cast INVALID_VALUE_ID will look like their numeric_limit::max()
 constexpr ValueID INVALID_VALUE_ID{std::numeric_limits<ValueID::base_type>::max()};
 
-const auto ALWAYS_TRUE_SCAN_PREDICATE = [](const ValueID& value_id) { return true; };
-const auto ALWAYS_FALSE_SCAN_PREDICATE = [](const ValueID& value_id) { return false; };
-
 // Dictionary is a specific segment type that stores all its values in a vector
 template <typename T>
-class DictionarySegment : public BaseSegment {
+class DictionarySegment : public BaseTypedSegment<T> {
  public:
   /**
    * Creates a Dictionary segment from a given value segment.
@@ -43,12 +41,78 @@ class DictionarySegment : public BaseSegment {
     _compress_values(column_values);
   }
 
+  /**
+   * Creates a Dictionary segment from a given value segment, using a dictionary that other segments may share.
+   * The dictionary has to be sorted and contain all values of the segment.
+   */
+  DictionarySegment(const std::shared_ptr<BaseSegment>& base_segment,
+                    const std::shared_ptr<const std::vector<T>>& dictionary) {
+    auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+    Assert(value_segment, "Input should be a ValueSegment of same data type");
+    Assert(value_segment->size() > 0, "Segment has no elements");
+
+    _dictionary = dictionary;
+    if (dictionary->size() <= static_cast<size_t>(std::numeric_limits<uint8_t>::max()) + 1) {
+      _encode_with_dictionary<uint8_t>(value_segment->values());
+    } else if (dictionary->size() <= static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1) {
+      _encode_with_dictionary<uint16_t>(value_segment->values());
+    } else {
+      _encode_with_dictionary<uint32_t>(value_segment->values());
+    }
+  }
+
+  // builds a sorted dictionary of all values in the given value segments, which can then be shared by them
+  static std::shared_ptr<const std::vector<T>> build_shared_dictionary(
+      const std::vector<std::shared_ptr<BaseSegment>>& base_segments) {
+    auto dictionary = std::make_shared<std::vector<T>>();
+    for (const auto& base_segment : base_segments) {
+      auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+      Assert(value_segment, "Input should be a ValueSegment of same data type");
+      dictionary->insert(dictionary->end(), value_segment->values().cbegin(), value_segment->values().cend());
+    }
+
+    std::sort(dictionary->begin(), dictionary->end());
+    dictionary->erase(std::unique(dictionary->begin(), dictionary->end()), dictionary->end());
+    return dictionary;
+  }
+
   // return the value at a certain position. If you want to write efficient operators, back off!
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const override { return get(chunk_offset); }
 
   // return the value at a certain position.
   T get(const size_t chunk_offset) const { return _dictionary->at(_attribute_vector->get(chunk_offset)); }
 
+  // decodes the values of the rows in row_range into output
+  void materialize(const ChunkOffsetRange& row_range, T* output) const final {
+    DebugAssert(row_range.begin <= row_range.end && row_range.end <= size(), "Row range out of bounds");
+    const auto* const dictionary = _dictionary->data();
+    with_value_ids([&](const auto* const value_ids) {
+      for (auto chunk_offset = row_range.begin; chunk_offset < row_range.end; ++chunk_offset) {
+        *output++ = dictionary[value_ids[chunk_offset]];
+      }
+    });
+  }
+
+  // decodes the values at the given offsets into output. Both the value ids and the dictionary entries are read at
+  // random positions, so the value ids are prefetched twice as far ahead as the dictionary entries they point to.
+  void gather(const std::vector<ChunkOffset>& offsets, T* output) const final {
+    const auto* const dictionary = _dictionary->data();
+    const auto offset_count = offsets.size();
+    constexpr auto PREFETCH_DISTANCE = DictionarySegment::GATHER_PREFETCH_DISTANCE;
+    with_value_ids([&](const auto* const value_ids) {
+      for (auto index = size_t{0}; index < offset_count; ++index) {
+        if (index + 2 * PREFETCH_DISTANCE < offset_count) {
+          __builtin_prefetch(&value_ids[offsets[index + 2 * PREFETCH_DISTANCE]]);
+        }
+        if (index + PREFETCH_DISTANCE < offset_count) {
+          __builtin_prefetch(&dictionary[value_ids[offsets[index + PREFETCH_DISTANCE]]]);
+        }
+        DebugAssert(offsets[index] < size(), "Chunk offset out of bounds");
+        output[index] = dictionary[value_ids[offsets[index]]];
+      }
+    });
+  }
+
   // dictionary segments are immutable
   void append(const AllTypeVariant&) override { throw std::logic_error("dictionary segments are immutable"); }
 
@@ -58,6 +122,20 @@ class DictionarySegment : public BaseSegment {
   // returns an underlying data structure
   std::shared_ptr<const BaseAttributeVector> attribute_vector() const { return _attribute_vector; }
 
+  // calls functor with a pointer to the value ids, typed by the width of the attribute vector
+  template <typename Functor>
+  void with_value_ids(const Functor& functor) const {
+    // the attribute vector is always created by this class, as a FixedSizeAttributeVector of the given width
+    switch (_attribute_vector->width()) {
+      case 1:
+        return functor(static_cast<const FixedSizeAttributeVector<uint8_t>&>(*_attribute_vector).value_ids().data());
+      case 2:
+        return functor(static_cast<const FixedSizeAttributeVector<uint16_t>&>(*_attribute_vector).value_ids().data());
+      default:
+        return functor(static_cast<const FixedSizeAttributeVector<uint32_t>&>(*_attribute_vector).value_ids().data());
+    }
+  }
+
   // return the value represented by a given ValueID
   const T& value_by_value_id(ValueID value_id) const { return _dictionary->at(value_id); }
 
@@ -108,100 +186,29 @@ class DictionarySegment : public BaseSegment {
   // return the number of entries
   size_t size() const override { return _attribute_vector->size(); }
 
-  // returns the calculated memory usage
+  // returns the calculated memory usage. A dictionary shared by several segments is counted in equal parts by each of
+  // them, so that the memory usage of a table counts it once.
   size_t estimate_memory_usage() const final {
-    const size_t dictionary_size = _dictionary->capacity() * sizeof(T);
+    const size_t dictionary_size = _dictionary->capacity() * sizeof(T) / static_cast<size_t>(_dictionary.use_count());
     return dictionary_size + _attribute_vector->estimate_memory_usage();
   }
-  
-  // scans every value in this segment and calls the result_callback if the scan_op comparison with compare_value returns true
-  virtual void segment_scan(const AllTypeVariant& compare_value, const ScanType scan_op, const std::function<void(RowID)> result_callback, ChunkID chunk_id) const override {
-    const auto row_count = _attribute_vector->size();
-    const auto scan_predicate = _scan_predicate(type_cast<T>(compare_value), scan_op);
-    for(ChunkOffset row_index = 0; row_index < row_count; ++row_index) {
-      if(scan_predicate(_attribute_vector->get(row_index))) {
-        result_callback(RowID{chunk_id, row_index});
-      }
-    }
-  }
 
-  // same as above, but only using the values at offsets from offset_filter
-  virtual void segment_scan(const AllTypeVariant& compare_value, const ScanType scan_op, const std::function<void(RowID)> result_callback, ChunkID chunk_id, std::vector<ChunkOffset> row_filter) const override {
-    const auto scan_predicate = _scan_predicate(type_cast<T>(compare_value), scan_op);
-    for(const ChunkOffset row_index: row_filter) {
-      if(scan_predicate(_attribute_vector->get(row_index))) {
-        result_callback(RowID{chunk_id, row_index});
-      }
-    }
+  // returns the range [begin, end) of value ids whose values lie within [lower_value, upper_value]
+  // begin == end if no value is in the range
+  std::pair<ValueID, ValueID> value_id_range(const T& lower_value, const T& upper_value) const {
+    const auto dictionary_size = ValueID{static_cast<ValueID::base_type>(_dictionary->size())};
+    auto begin = lower_bound(lower_value);
+    auto end = upper_bound(upper_value);
+    if (begin == INVALID_VALUE_ID) begin = dictionary_size;
+    if (end == INVALID_VALUE_ID) end = dictionary_size;
+    if (begin > end) end = begin;
+    return {begin, end};
   }
 
  protected:
-  std::shared_ptr<std::vector<T>> _dictionary;
+  std::shared_ptr<const std::vector<T>> _dictionary;
   std::shared_ptr<BaseAttributeVector> _attribute_vector;
 
-  const std::function<bool(const ValueID&)> _scan_predicate(const T& compare_value, const ScanType scan_op) const {
-    // optimized scan - we can use the order of _dictionary and it's indices to filter the elements via binary search
-    ValueID found_value_id, lower_bounds_id, upper_bounds_id;
-    switch(scan_op) {
-      case ScanType::OpEquals:
-        found_value_id = find_value(compare_value);
-        if(found_value_id != INVALID_VALUE_ID) {
-          // value found, filter rows by matching id
-          return [&found_value_id](const ValueID& value_id) { return value_id == found_value_id; };
-        } else {
-          // value not found, no row will match
-          return ALWAYS_FALSE_SCAN_PREDICATE;
-        }
-      case ScanType::OpNotEquals:
-        found_value_id = find_value(compare_value);
-        if(found_value_id != INVALID_VALUE_ID) {
-          // value found, filter rows by non-matching id
-          return [&found_value_id](const ValueID& value_id) { return value_id != found_value_id; };
-        } else {
-          // value not found, all rows will match
-          return ALWAYS_TRUE_SCAN_PREDICATE;
-        }
-      case ScanType::OpLessThan:
-        lower_bounds_id = lower_bound(compare_value);
-        if (lower_bounds_id != INVALID_VALUE_ID) {
-          // some values are smaller, filter rows with smaller id
-          return [&lower_bounds_id](const ValueID& value_id) { return value_id < lower_bounds_id; };
-        } else {
-          // all values are smaller
-          return ALWAYS_TRUE_SCAN_PREDICATE;
-        }
-      case ScanType::OpLessThanEquals:
-        upper_bounds_id = upper_bound(compare_value);
-        if (upper_bounds_id != INVALID_VALUE_ID) {
-          // some values are smaller or equal, filter rows with smaller id
-          return [&upper_bounds_id](const ValueID& value_id) { return value_id < upper_bounds_id; };
-        } else {
-          // all values are smaller
-          return ALWAYS_TRUE_SCAN_PREDICATE;
-        }
-      case ScanType::OpGreaterThan:
-        upper_bounds_id = upper_bound(compare_value);
-        if (upper_bounds_id != INVALID_VALUE_ID) {
-          // some values are bigger, filter rows with bigger or equal id
-          return [&upper_bounds_id](const ValueID& value_id) { return value_id >= upper_bounds_id; };
-        } else {
-          // all values are bigger
-          return ALWAYS_FALSE_SCAN_PREDICATE;
-        }
-      case ScanType::OpGreaterThanEquals:
-        lower_bounds_id = lower_bound(compare_value);
-        if (lower_bounds_id != INVALID_VALUE_ID) {
-          // some values are bigger or equal, filter rows with bigger or equal id
-          return [&lower_bounds_id](const ValueID& value_id) { return value_id >= lower_bounds_id; };
-        } else {
-          // all values are bigger
-          return ALWAYS_FALSE_SCAN_PREDICATE;
-        }
-      default:
-        throw std::domain_error("Unknown scan operation");
-    }
-  }
-
   void _compress_values(const std::vector<T>& column_values) {
     std::vector<uint32_t> lookup_indices(column_values.size());
     // initialized with many falses
@@ -238,15 +245,29 @@ class DictionarySegment : public BaseSegment {
   void _build_dictionary_and_attributes(const std::vector<T>& values, const std::vector<uint32_t>& indices,
                                         const std::vector<bool>& same_as_before, const uint32_t num_unique) {
     std::vector<IndexType> attributes(values.size());
-    _dictionary = std::make_shared<std::vector<T>>();
-    _dictionary->reserve(num_unique);
+    auto dictionary = std::make_shared<std::vector<T>>();
+    dictionary->reserve(num_unique);
 
     for (uint32_t position = 0; position < values.size(); position++) {
       uint32_t uncompressed_index = indices[position];
       if (!same_as_before[position]) {
-        _dictionary->push_back(values[uncompressed_index]);
+        dictionary->push_back(values[uncompressed_index]);
       }
-      attributes[uncompressed_index] = _dictionary->size() - 1;
+      attributes[uncompressed_index] = dictionary->size() - 1;
+    }
+    _dictionary = dictionary;
+
+    _attribute_vector = std::static_pointer_cast<BaseAttributeVector>(
+        std::make_shared<FixedSizeAttributeVector<IndexType>>(std::move(attributes)));
+  }
+
+  template <typename IndexType>
+  void _encode_with_dictionary(const std::vector<T>& values) {
+    std::vector<IndexType> attributes(values.size());
+    for (auto position = size_t{0}; position < values.size(); ++position) {
+      const auto value_id = find_value(values[position]);
+      Assert(value_id != INVALID_VALUE_ID, "Value is missing in the dictionary");
+      attributes[position] = static_cast<IndexType>(value_id);
     }
 
     _attribute_vector = std::static_pointer_cast<BaseAttributeVector>(
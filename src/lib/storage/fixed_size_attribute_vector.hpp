@@ -26,6 +26,9 @@ class FixedSizeAttributeVector : public BaseAttributeVector {
   // returns the number of values
   virtual size_t size() const { return _value_ids.size(); }
 
+  // returns all value ids, for typed loops that avoid the virtual get()
+  const std::vector<T>& value_ids() const { return _value_ids; }
+
   // returns the width of biggest value id in bytes
   virtual AttributeVectorWidth width() const { return sizeof(T); }
 
@@ -0,0 +1,229 @@
+#include "adaptive_radix_tree_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "adaptive_radix_tree_nodes.hpp"
+#include "resolve_type.hpp"
+#include "storage/base_typed_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// returns the bytes of the value in an order-preserving encoding
+template <typename T>
+std::string encode_key(T value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    DebugAssert(value.find('\0') == std::string::npos, "Strings in an AdaptiveRadixTreeIndex cannot contain '\\0'");
+    return value + '\0';
+  } else {
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr auto SIGN_BIT = Bits{1} << (sizeof(T) * 8 - 1);
+    auto bits = Bits{0};
+    if constexpr (std::is_floating_point_v<T>) {
+      // -0.0 equals 0.0. Negative numbers are ordered by their inverted bits, positive ones follow them.
+      if (value == 0) value = 0;
+      std::memcpy(&bits, &value, sizeof(T));
+      bits = (bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT;
+    } else {
+      // flipping the sign bit of a two's complement number orders negative numbers before positive ones
+      bits = static_cast<Bits>(value) ^ SIGN_BIT;
+    }
+
+    auto key = std::string(sizeof(T), '\0');
+    for (auto byte_id = size_t{0}; byte_id < sizeof(T); ++byte_id) {
+      key[byte_id] = static_cast<char>(bits >> ((sizeof(T) - 1 - byte_id) * 8));
+    }
+    return key;
+  }
+}
+
+}  // namespace
+
+AdaptiveRadixTreeIndex::AdaptiveRadixTreeIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments)
+    : BaseIndex(SegmentIndexType::AdaptiveRadixTree, indexed_segments) {
+  Assert(_indexed_segments.size() == 1, "AdaptiveRadixTreeIndex can only index a single segment");
+
+  auto keys = std::vector<std::string>{};
+  auto key_postings_begins = std::vector<ChunkOffset>{};
+  hana::for_each(data_types, [&](auto data_type) {
+    using Type = typename decltype(+hana::second(data_type))::type;
+    const auto segment = dynamic_cast<const BaseTypedSegment<Type>*>(_indexed_segments.front().get());
+    if (!segment) return;
+
+    _encode_key = [](const AllTypeVariant& value) { return encode_key(type_cast<Type>(value)); };
+    _is_string_segment = std::is_same_v<Type, std::string>;
+
+    // the postings are the offsets sorted by value, rows with equal values share a key
+    const auto row_count = static_cast<ChunkOffset>(segment->size());
+    auto values = std::vector<Type>(row_count);
+    segment->materialize(ChunkOffsetRange{0, row_count}, values.data());
+    _postings.resize(row_count);
+    std::iota(_postings.begin(), _postings.end(), ChunkOffset{0});
+    std::stable_sort(_postings.begin(), _postings.end(),
+                     [&](const ChunkOffset left, const ChunkOffset right) { return values[left] < values[right]; });
+
+    for (auto posting = ChunkOffset{0}; posting < row_count; ++posting) {
+      if (posting > 0 && !(values[_postings[posting - 1]] < values[_postings[posting]])) continue;
+      keys.push_back(encode_key(values[_postings[posting]]));
+      key_postings_begins.push_back(posting);
+    }
+    key_postings_begins.push_back(row_count);
+  });
+  Assert(_encode_key, "AdaptiveRadixTreeIndex can only index segments with values of a data type");
+
+  if (!keys.empty()) _root = _build(keys, key_postings_begins, 0, keys.size(), 0);
+}
+
+AdaptiveRadixTreeIndex::~AdaptiveRadixTreeIndex() = default;
+
+PositionBitmap AdaptiveRadixTreeIndex::prefix_lookup(const std::string& prefix) const {
+  Assert(_is_string_segment, "Prefix lookups are only supported on strings");
+
+  const auto postings = [&](const ARTNode& node) {
+    auto offsets = std::vector<ChunkOffset>(_postings.cbegin() + node.postings_begin,
+                                            _postings.cbegin() + node.postings_end);
+    return _to_bitmap(offsets);
+  };
+
+  // descends to the subtree whose keys all start with the prefix
+  const ARTNode* node = _root.get();
+  auto depth = size_t{0};
+  while (node) {
+    if (node->is_leaf()) {
+      return _row_key(_postings[node->postings_begin]).compare(0, prefix.size(), prefix) == 0 ? postings(*node)
+                                                                                              : PositionBitmap{};
+    }
+
+    for (auto byte_id = size_t{0}; byte_id < node->prefix.size(); ++byte_id, ++depth) {
+      if (depth == prefix.size()) return postings(*node);
+      if (node->prefix[byte_id] != prefix[depth]) return PositionBitmap{};
+    }
+    if (depth == prefix.size()) return postings(*node);
+
+    const auto byte = static_cast<uint8_t>(prefix[depth]);
+    auto child_byte = uint8_t{0};
+    node = node->lower_bound_child(byte, child_byte);
+    if (!node || child_byte != byte) return PositionBitmap{};
+    ++depth;
+  }
+  return PositionBitmap{};
+}
+
+size_t AdaptiveRadixTreeIndex::estimate_memory_usage() const {
+  return _postings.capacity() * sizeof(ChunkOffset) + (_root ? _root->estimate_memory_usage() : 0);
+}
+
+PositionBitmap AdaptiveRadixTreeIndex::_lookup(const ScanType scan_type,
+                                               const std::vector<AllTypeVariant>& search_values,
+                                               const std::optional<AllTypeVariant>& search_value2) const {
+  const auto key = _encode_key(search_values.front());
+  const auto postings_end = static_cast<ChunkOffset>(_postings.size());
+
+  auto begin = ChunkOffset{0};
+  auto end = postings_end;
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      begin = _bound(key, false);
+      end = _bound(key, true);
+      break;
+    case ScanType::OpLessThan:
+      end = _bound(key, false);
+      break;
+    case ScanType::OpLessThanEquals:
+      end = _bound(key, true);
+      break;
+    case ScanType::OpGreaterThan:
+      begin = _bound(key, true);
+      break;
+    case ScanType::OpGreaterThanEquals:
+      begin = _bound(key, false);
+      break;
+    case ScanType::OpBetween:
+      begin = _bound(key, false);
+      end = _bound(_encode_key(*search_value2), true);
+      break;
+    default:
+      Fail("Scan type is not supported by the AdaptiveRadixTreeIndex");
+  }
+
+  // an empty range of values (e.g., BETWEEN 5 AND 3) yields bounds in the wrong order
+  auto offsets = begin < end ? std::vector<ChunkOffset>(_postings.cbegin() + begin, _postings.cbegin() + end)
+                             : std::vector<ChunkOffset>{};
+  return _to_bitmap(offsets);
+}
+
+std::unique_ptr<ARTNode> AdaptiveRadixTreeIndex::_build(const std::vector<std::string>& keys,
+                                                        const std::vector<ChunkOffset>& key_postings_begins,
+                                                        const size_t key_begin, const size_t key_end,
+                                                        const size_t depth) {
+  if (key_end - key_begin == 1) {
+    return std::make_unique<ARTLeaf>(key_postings_begins[key_begin], key_postings_begins[key_end]);
+  }
+
+  // the keys are sorted, so the bytes that all of them share are those that the first and the last one share. Keys
+  // are distinct and none is a prefix of another, so they branch before either of them ends.
+  const auto& first_key = keys[key_begin];
+  const auto& last_key = keys[key_end - 1];
+  auto branch_depth = depth;
+  while (first_key[branch_depth] == last_key[branch_depth]) ++branch_depth;
+
+  auto children = ARTChildren{};
+  auto child_begin = key_begin;
+  while (child_begin < key_end) {
+    const auto byte = keys[child_begin][branch_depth];
+    auto child_end = child_begin + 1;
+    while (child_end < key_end && keys[child_end][branch_depth] == byte) ++child_end;
+    children.emplace_back(static_cast<uint8_t>(byte),
+                          _build(keys, key_postings_begins, child_begin, child_end, branch_depth + 1));
+    child_begin = child_end;
+  }
+
+  return make_art_inner_node(key_postings_begins[key_begin], key_postings_begins[key_end],
+                             first_key.substr(depth, branch_depth - depth), std::move(children));
+}
+
+ChunkOffset AdaptiveRadixTreeIndex::_bound(const std::string& key, const bool is_upper_bound) const {
+  const ARTNode* node = _root.get();
+  auto depth = size_t{0};
+  while (node) {
+    if (node->is_leaf()) {
+      const auto comparison = _row_key(_postings[node->postings_begin]).compare(key);
+      return comparison < 0 || (is_upper_bound && comparison == 0) ? node->postings_end : node->postings_begin;
+    }
+
+    // the whole subtree is greater or smaller than the key if its shared bytes differ from those of the key
+    for (auto byte_id = size_t{0}; byte_id < node->prefix.size(); ++byte_id, ++depth) {
+      if (depth == key.size()) return node->postings_begin;
+      const auto node_byte = static_cast<uint8_t>(node->prefix[byte_id]);
+      const auto key_byte = static_cast<uint8_t>(key[depth]);
+      if (node_byte != key_byte) return node_byte < key_byte ? node->postings_end : node->postings_begin;
+    }
+    if (depth == key.size()) return node->postings_begin;
+
+    const auto byte = static_cast<uint8_t>(key[depth]);
+    auto child_byte = uint8_t{0};
+    const auto child = node->lower_bound_child(byte, child_byte);
+    if (!child) return node->postings_end;
+    if (child_byte != byte) return child->postings_begin;
+    node = child;
+    ++depth;
+  }
+  return ChunkOffset{0};
+}
+
+std::string AdaptiveRadixTreeIndex::_row_key(const ChunkOffset chunk_offset) const {
+  return _encode_key((*_indexed_segments.front())[chunk_offset]);
+}
+
+}  // namespace opossum
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base_index.hpp"
+
+namespace opossum {
+
+class ARTNode;
+
+// An Adaptive Radix Tree (Leis et al., ICDE 2013) on a single segment of any type, for high-cardinality and string
+// columns. The values are encoded as binary-comparable keys, whose byte-wise order is the order of the values:
+// integers and floating point numbers are stored big-endian with their sign handled, strings are terminated by a zero
+// byte (so they must not contain one). The tree branches on one key byte per level, compresses paths without
+// branches, and stores each inner node in the smallest of four layouts for 4, 16, 48 or 256 children (see
+// adaptive_radix_tree_nodes.hpp).
+//
+// The tree is built once from the sorted keys. Its postings list the chunk offsets of all rows sorted by value, so
+// every subtree covers a contiguous range of them. Point and range lookups descend the tree to the bounds of the
+// qualifying range, prefix lookups on strings to the subtree of the prefix.
+class AdaptiveRadixTreeIndex : public BaseIndex {
+ public:
+  explicit AdaptiveRadixTreeIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments);
+  ~AdaptiveRadixTreeIndex() override;
+
+  // returns the offsets of the rows whose string starts with the prefix, e.g., for LIKE 'prefix%'
+  PositionBitmap prefix_lookup(const std::string& prefix) const;
+
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  PositionBitmap _lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                         const std::optional<AllTypeVariant>& search_value2) const override;
+
+  // builds the subtree of the distinct keys [key_begin, key_end), which share their first depth bytes.
+  // key_postings_begins holds the first posting of every key, followed by the end of the postings.
+  static std::unique_ptr<ARTNode> _build(const std::vector<std::string>& keys,
+                                         const std::vector<ChunkOffset>& key_postings_begins, const size_t key_begin,
+                                         const size_t key_end, const size_t depth);
+
+  // returns the first posting whose key is not smaller than (is_upper_bound: greater than) the key
+  ChunkOffset _bound(const std::string& key, const bool is_upper_bound) const;
+
+  // returns the key of the row
+  std::string _row_key(const ChunkOffset chunk_offset) const;
+
+  // encodes a value of the segment's type as binary-comparable key
+  std::function<std::string(const AllTypeVariant&)> _encode_key;
+  bool _is_string_segment = false;
+
+  std::vector<ChunkOffset> _postings;
+  // nullptr if the segment is empty
+  std::unique_ptr<ARTNode> _root;
+};
+
+}  // namespace opossum
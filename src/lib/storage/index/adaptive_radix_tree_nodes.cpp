@@ -0,0 +1,162 @@
+#include "adaptive_radix_tree_nodes.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+ARTNode::ARTNode(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end, std::string init_prefix)
+    : postings_begin{init_postings_begin}, postings_end{init_postings_end}, prefix{std::move(init_prefix)} {}
+
+bool ARTNode::is_leaf() const { return false; }
+
+std::unique_ptr<ARTNode> make_art_inner_node(const ChunkOffset postings_begin, const ChunkOffset postings_end,
+                                             std::string prefix, ARTChildren&& children) {
+  DebugAssert(children.size() > 1 && children.size() <= 256, "Inner nodes have between 2 and 256 children");
+  if (children.size() <= 4) {
+    return std::make_unique<ARTNode4>(postings_begin, postings_end, std::move(prefix), std::move(children));
+  }
+  if (children.size() <= 16) {
+    return std::make_unique<ARTNode16>(postings_begin, postings_end, std::move(prefix), std::move(children));
+  }
+  if (children.size() <= 48) {
+    return std::make_unique<ARTNode48>(postings_begin, postings_end, std::move(prefix), std::move(children));
+  }
+  return std::make_unique<ARTNode256>(postings_begin, postings_end, std::move(prefix), std::move(children));
+}
+
+ARTLeaf::ARTLeaf(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end)
+    : ARTNode(init_postings_begin, init_postings_end, std::string{}) {}
+
+bool ARTLeaf::is_leaf() const { return true; }
+
+const ARTNode* ARTLeaf::lower_bound_child(const uint8_t, uint8_t&) const { return nullptr; }
+
+size_t ARTLeaf::estimate_memory_usage() const { return sizeof(ARTLeaf); }
+
+ARTNode4::ARTNode4(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end,
+                   std::string init_prefix, ARTChildren&& children)
+    : ARTNode(init_postings_begin, init_postings_end, std::move(init_prefix)),
+      _child_count{static_cast<uint8_t>(children.size())} {
+  for (auto index = size_t{0}; index < children.size(); ++index) {
+    _keys[index] = children[index].first;
+    _children[index] = std::move(children[index].second);
+  }
+}
+
+const ARTNode* ARTNode4::lower_bound_child(const uint8_t byte, uint8_t& child_byte) const {
+  for (auto index = uint8_t{0}; index < _child_count; ++index) {
+    if (_keys[index] >= byte) {
+      child_byte = _keys[index];
+      return _children[index].get();
+    }
+  }
+  return nullptr;
+}
+
+size_t ARTNode4::estimate_memory_usage() const {
+  auto memory_usage = sizeof(ARTNode4) + prefix.capacity();
+  for (auto index = uint8_t{0}; index < _child_count; ++index) {
+    memory_usage += _children[index]->estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
+ARTNode16::ARTNode16(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end,
+                     std::string init_prefix, ARTChildren&& children)
+    : ARTNode(init_postings_begin, init_postings_end, std::move(init_prefix)),
+      _child_count{static_cast<uint8_t>(children.size())} {
+  _keys.fill(0);
+  for (auto index = size_t{0}; index < children.size(); ++index) {
+    _keys[index] = children[index].first;
+    _children[index] = std::move(children[index].second);
+  }
+}
+
+const ARTNode* ARTNode16::lower_bound_child(const uint8_t byte, uint8_t& child_byte) const {
+#ifdef __SSE2__
+  // SSE2 only compares signed bytes, a key is >= byte (unsigned) if the unsigned maximum of both is the key
+  const auto keys = _mm_load_si128(reinterpret_cast<const __m128i*>(_keys.data()));
+  const auto greater_equal = _mm_cmpeq_epi8(_mm_max_epu8(keys, _mm_set1_epi8(static_cast<char>(byte))), keys);
+  const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(greater_equal)) & ((uint32_t{1} << _child_count) - 1);
+  if (mask == 0) return nullptr;
+  const auto index = __builtin_ctz(mask);
+#else
+  const auto index = std::lower_bound(_keys.cbegin(), _keys.cbegin() + _child_count, byte) - _keys.cbegin();
+  if (index == _child_count) return nullptr;
+#endif
+  child_byte = _keys[index];
+  return _children[index].get();
+}
+
+size_t ARTNode16::estimate_memory_usage() const {
+  auto memory_usage = sizeof(ARTNode16) + prefix.capacity();
+  for (auto index = uint8_t{0}; index < _child_count; ++index) {
+    memory_usage += _children[index]->estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
+ARTNode48::ARTNode48(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end,
+                     std::string init_prefix, ARTChildren&& children)
+    : ARTNode(init_postings_begin, init_postings_end, std::move(init_prefix)) {
+  _child_slots.fill(EMPTY_SLOT);
+  for (auto index = size_t{0}; index < children.size(); ++index) {
+    _child_slots[children[index].first] = static_cast<uint8_t>(index);
+    _children[index] = std::move(children[index].second);
+  }
+}
+
+const ARTNode* ARTNode48::lower_bound_child(const uint8_t byte, uint8_t& child_byte) const {
+  for (auto key = size_t{byte}; key < _child_slots.size(); ++key) {
+    if (_child_slots[key] != EMPTY_SLOT) {
+      child_byte = static_cast<uint8_t>(key);
+      return _children[_child_slots[key]].get();
+    }
+  }
+  return nullptr;
+}
+
+size_t ARTNode48::estimate_memory_usage() const {
+  auto memory_usage = sizeof(ARTNode48) + prefix.capacity();
+  for (const auto& child : _children) {
+    if (child) memory_usage += child->estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
+ARTNode256::ARTNode256(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end,
+                       std::string init_prefix, ARTChildren&& children)
+    : ARTNode(init_postings_begin, init_postings_end, std::move(init_prefix)) {
+  for (auto& [key, child] : children) {
+    _children[key] = std::move(child);
+  }
+}
+
+const ARTNode* ARTNode256::lower_bound_child(const uint8_t byte, uint8_t& child_byte) const {
+  for (auto key = size_t{byte}; key < _children.size(); ++key) {
+    if (_children[key]) {
+      child_byte = static_cast<uint8_t>(key);
+      return _children[key].get();
+    }
+  }
+  return nullptr;
+}
+
+size_t ARTNode256::estimate_memory_usage() const {
+  auto memory_usage = sizeof(ARTNode256) + prefix.capacity();
+  for (const auto& child : _children) {
+    if (child) memory_usage += child->estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
+}  // namespace opossum
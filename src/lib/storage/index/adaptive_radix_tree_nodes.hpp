@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// The nodes of the AdaptiveRadixTreeIndex. The keys below a node share the bytes on the path from the root to it.
+// Each inner node stores the bytes of the path that all its keys share after those of its parent (path compression)
+// and its children by their next key byte, in one of four layouts chosen by the number of children. Every node covers
+// the contiguous range [postings_begin, postings_end) of the postings, which are sorted by key.
+class ARTNode : private Noncopyable {
+ public:
+  ARTNode(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end, std::string init_prefix);
+  virtual ~ARTNode() = default;
+
+  virtual bool is_leaf() const;
+
+  // returns the child with the smallest key byte >= byte and sets child_byte to its key byte, or returns nullptr if
+  // there is none
+  virtual const ARTNode* lower_bound_child(const uint8_t byte, uint8_t& child_byte) const = 0;
+
+  // returns the calculated memory usage of the node and its children
+  virtual size_t estimate_memory_usage() const = 0;
+
+  const ChunkOffset postings_begin;
+  const ChunkOffset postings_end;
+  const std::string prefix;
+};
+
+// the children of an inner node with their key bytes, sorted by them
+using ARTChildren = std::vector<std::pair<uint8_t, std::unique_ptr<ARTNode>>>;
+
+// creates the smallest inner node that can hold the children
+std::unique_ptr<ARTNode> make_art_inner_node(const ChunkOffset postings_begin, const ChunkOffset postings_end,
+                                             std::string prefix, ARTChildren&& children);
+
+// A single key, whose postings hold the rows with that key. The key itself is not stored, it is read from the indexed
+// segment at the first of these rows.
+class ARTLeaf final : public ARTNode {
+ public:
+  ARTLeaf(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end);
+
+  bool is_leaf() const override;
+  const ARTNode* lower_bound_child(const uint8_t byte, uint8_t& child_byte) const override;
+  size_t estimate_memory_usage() const override;
+};
+
+// up to 4 children, whose key bytes are searched linearly
+class ARTNode4 final : public ARTNode {
+ public:
+  ARTNode4(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end, std::string init_prefix,
+           ARTChildren&& children);
+
+  const ARTNode* lower_bound_child(const uint8_t byte, uint8_t& child_byte) const override;
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  uint8_t _child_count;
+  std::array<uint8_t, 4> _keys;
+  std::array<std::unique_ptr<ARTNode>, 4> _children;
+};
+
+// up to 16 children, whose key bytes are compared with the searched byte at once with SSE2 instructions
+class ARTNode16 final : public ARTNode {
+ public:
+  ARTNode16(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end, std::string init_prefix,
+            ARTChildren&& children);
+
+  const ARTNode* lower_bound_child(const uint8_t byte, uint8_t& child_byte) const override;
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  uint8_t _child_count;
+  alignas(16) std::array<uint8_t, 16> _keys;
+  std::array<std::unique_ptr<ARTNode>, 16> _children;
+};
+
+// up to 48 children, found through a slot for each possible key byte
+class ARTNode48 final : public ARTNode {
+ public:
+  ARTNode48(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end, std::string init_prefix,
+            ARTChildren&& children);
+
+  const ARTNode* lower_bound_child(const uint8_t byte, uint8_t& child_byte) const override;
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  static constexpr uint8_t EMPTY_SLOT = 48;
+
+  std::array<uint8_t, 256> _child_slots;
+  std::array<std::unique_ptr<ARTNode>, 48> _children;
+};
+
+// a child for each possible key byte
+class ARTNode256 final : public ARTNode {
+ public:
+  ARTNode256(const ChunkOffset init_postings_begin, const ChunkOffset init_postings_end, std::string init_prefix,
+             ARTChildren&& children);
+
+  const ARTNode* lower_bound_child(const uint8_t byte, uint8_t& child_byte) const override;
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  std::array<std::unique_ptr<ARTNode>, 256> _children;
+};
+
+}  // namespace opossum
@@ -0,0 +1,64 @@
+#include "base_index.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "storage/base_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+BaseIndex::BaseIndex(const SegmentIndexType type,
+                     const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments)
+    : _type{type}, _indexed_segments{indexed_segments} {
+  Assert(!_indexed_segments.empty(), "An index needs at least one segment");
+}
+
+SegmentIndexType BaseIndex::type() const { return _type; }
+
+const std::vector<std::shared_ptr<const BaseSegment>>& BaseIndex::indexed_segments() const {
+  return _indexed_segments;
+}
+
+bool BaseIndex::is_index_for(const std::vector<std::shared_ptr<const BaseSegment>>& segments) const {
+  return !segments.empty() && segments.size() <= _indexed_segments.size() &&
+         std::equal(segments.cbegin(), segments.cend(), _indexed_segments.cbegin());
+}
+
+bool BaseIndex::supports(const ScanType scan_type) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+    case ScanType::OpLessThan:
+    case ScanType::OpLessThanEquals:
+    case ScanType::OpGreaterThan:
+    case ScanType::OpGreaterThanEquals:
+    case ScanType::OpBetween:
+      return true;
+    default:
+      return false;
+  }
+}
+
+PositionBitmap BaseIndex::lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                                 const std::optional<AllTypeVariant>& search_value2) const {
+  Assert(supports(scan_type), "Scan type is not supported by indexes");
+  Assert(!search_values.empty() && search_values.size() <= _indexed_segments.size(),
+         "Lookups need one search value for each of the first indexed segments");
+  Assert((scan_type == ScanType::OpBetween) == search_value2.has_value(),
+         "A second search value has to be given for and only for OpBetween");
+  return _lookup(scan_type, search_values, search_value2);
+}
+
+PositionBitmap BaseIndex::_to_bitmap(std::vector<ChunkOffset>& offsets) {
+  if (!std::is_sorted(offsets.cbegin(), offsets.cend())) std::sort(offsets.begin(), offsets.end());
+
+  auto bitmap = PositionBitmap{};
+  for (const auto chunk_offset : offsets) {
+    bitmap.append(chunk_offset);
+  }
+  return bitmap;
+}
+
+}  // namespace opossum
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/position_bitmap.hpp"
+#include "type_cast.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+class BaseSegment;
+
+// BaseIndex is the abstract super class of all secondary indexes on the segments of a chunk. An index is created on
+// one or more segments (see Chunk::create_index) and returns the offsets of the rows whose indexed values satisfy a
+// predicate without scanning the segments.
+//
+// A lookup compares the first search_values.size() indexed segments with the search values: all but the last search
+// value have to be equal, the last one is compared with scan_type. OpEquals, OpLessThan, OpLessThanEquals,
+// OpGreaterThan, OpGreaterThanEquals and OpBetween, whose upper bound is search_value2, are supported.
+class BaseIndex : private Noncopyable {
+ public:
+  BaseIndex(const SegmentIndexType type, const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments);
+  virtual ~BaseIndex() = default;
+
+  SegmentIndexType type() const;
+
+  const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments() const;
+
+  // returns whether the index can look up the given segments, i.e., whether they are its first indexed segments
+  bool is_index_for(const std::vector<std::shared_ptr<const BaseSegment>>& segments) const;
+
+  static bool supports(const ScanType scan_type);
+
+  // returns the offsets of the rows that satisfy the predicate (see above). The search values have to be of the data
+  // types of the indexed segments.
+  PositionBitmap lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                        const std::optional<AllTypeVariant>& search_value2 = std::nullopt) const;
+
+  // returns the calculated memory usage, without the indexed segments
+  virtual size_t estimate_memory_usage() const = 0;
+
+ protected:
+  // implements lookup() on arguments that lookup() has already checked
+  virtual PositionBitmap _lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                                 const std::optional<AllTypeVariant>& search_value2) const = 0;
+
+  // returns the offsets, which may be unsorted, as a bitmap
+  static PositionBitmap _to_bitmap(std::vector<ChunkOffset>& offsets);
+
+  // calls functor with the first indexed segment cast to its DictionarySegment type, for indexes on value ids
+  template <typename Functor>
+  void _with_dictionary_segment(const Functor& functor) const {
+    auto is_resolved = false;
+    hana::for_each(data_types, [&](auto data_type) {
+      using Type = typename decltype(+hana::second(data_type))::type;
+      if (is_resolved) return;
+      if (const auto segment = dynamic_cast<const DictionarySegment<Type>*>(_indexed_segments.front().get())) {
+        is_resolved = true;
+        functor(*segment);
+      }
+    });
+    Assert(is_resolved, "The index can only index a DictionarySegment");
+  }
+
+  // returns the range [begin, end) of the value ids of the segment whose values satisfy the predicate
+  template <typename T>
+  static std::pair<ValueID, ValueID> _value_id_range(const DictionarySegment<T>& segment, const ScanType scan_type,
+                                                     const AllTypeVariant& search_value,
+                                                     const std::optional<AllTypeVariant>& search_value2) {
+    const auto typed_search_value = type_cast<T>(search_value);
+    const auto value_id_count = ValueID{static_cast<ValueID::base_type>(segment.unique_values_count())};
+    const auto value_id_or_end = [&](const ValueID value_id) {
+      return value_id == INVALID_VALUE_ID ? value_id_count : value_id;
+    };
+
+    switch (scan_type) {
+      case ScanType::OpEquals:
+        return segment.value_id_range(typed_search_value, typed_search_value);
+      case ScanType::OpLessThan:
+        return {ValueID{0}, value_id_or_end(segment.lower_bound(typed_search_value))};
+      case ScanType::OpLessThanEquals:
+        return {ValueID{0}, value_id_or_end(segment.upper_bound(typed_search_value))};
+      case ScanType::OpGreaterThan:
+        return {value_id_or_end(segment.upper_bound(typed_search_value)), value_id_count};
+      case ScanType::OpGreaterThanEquals:
+        return {value_id_or_end(segment.lower_bound(typed_search_value)), value_id_count};
+      case ScanType::OpBetween:
+        return segment.value_id_range(typed_search_value, type_cast<T>(*search_value2));
+      default:
+        break;
+    }
+    Fail("Scan type is not supported by indexes");
+    return {};
+  }
+
+  const SegmentIndexType _type;
+  const std::vector<std::shared_ptr<const BaseSegment>> _indexed_segments;
+};
+
+}  // namespace opossum
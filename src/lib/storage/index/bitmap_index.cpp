@@ -0,0 +1,65 @@
+#include "bitmap_index.hpp"
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+BitmapIndex::BitmapIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments)
+    : BaseIndex(SegmentIndexType::Bitmap, indexed_segments) {
+  Assert(_indexed_segments.size() == 1, "BitmapIndex can only index a single segment");
+
+  _with_dictionary_segment([&](const auto& segment) {
+    Assert(segment.unique_values_count() <= MAX_DISTINCT_VALUES, "BitmapIndex is only built for few distinct values");
+    _value_bitmaps.resize(segment.unique_values_count());
+
+    // the rows are visited in ascending order, as the bitmaps require
+    const auto row_count = static_cast<ChunkOffset>(segment.size());
+    segment.with_value_ids([&](const auto* const value_ids) {
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        _value_bitmaps[value_ids[chunk_offset]].append(chunk_offset);
+      }
+    });
+  });
+}
+
+PositionBitmap BitmapIndex::lookup_value_ids(const std::vector<ValueID>& value_ids) const {
+  if (value_ids.empty()) return PositionBitmap{};
+  DebugAssert(value_ids.back() < _value_bitmaps.size(), "Value id is not part of the dictionary");
+  return _unite(value_ids, 0, value_ids.size());
+}
+
+size_t BitmapIndex::estimate_memory_usage() const {
+  auto memory_usage = _value_bitmaps.capacity() * sizeof(PositionBitmap);
+  for (const auto& bitmap : _value_bitmaps) {
+    memory_usage += bitmap.estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
+PositionBitmap BitmapIndex::_lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                                    const std::optional<AllTypeVariant>& search_value2) const {
+  auto value_id_range = std::pair<ValueID, ValueID>{};
+  _with_dictionary_segment([&](const auto& segment) {
+    value_id_range = _value_id_range(segment, scan_type, search_values.front(), search_value2);
+  });
+
+  auto value_ids = std::vector<ValueID>{};
+  for (auto value_id = value_id_range.first; value_id < value_id_range.second; ++value_id) {
+    value_ids.push_back(value_id);
+  }
+  return lookup_value_ids(value_ids);
+}
+
+PositionBitmap BitmapIndex::_unite(const std::vector<ValueID>& value_ids, const size_t begin, const size_t end) const {
+  if (end - begin == 1) return _value_bitmaps[value_ids[begin]];
+
+  const auto middle = begin + (end - begin) / 2;
+  return _unite(value_ids, begin, middle).unite(_unite(value_ids, middle, end));
+}
+
+}  // namespace opossum
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "base_index.hpp"
+
+namespace opossum {
+
+// An index on a single DictionarySegment of a low-cardinality column that keeps, for every value id, a compressed
+// PositionBitmap of the rows with that value id. Any predicate that the dictionary translates into a set of value ids
+// is answered with bitmap algebra alone: the bitmaps of the qualifying value ids are united, and predicates on
+// several indexed columns of a chunk are combined by intersecting or uniting their results. This is what the
+// TableScan does for the chunks in which all of its predicates are on columns with a BitmapIndex, which covers
+// OpIn, OpNotEquals and OpLike as well.
+//
+// Every value id has a bitmap of its own, so the index is only built for segments with at most MAX_DISTINCT_VALUES
+// values. For those, the bitmaps together take about as much memory as the offsets in a GroupKeyIndex or less.
+class BitmapIndex : public BaseIndex {
+ public:
+  static constexpr size_t MAX_DISTINCT_VALUES = 1024;
+
+  explicit BitmapIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments);
+
+  // returns the rows of the given value ids, which have to be sorted and unique
+  PositionBitmap lookup_value_ids(const std::vector<ValueID>& value_ids) const;
+
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  PositionBitmap _lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                         const std::optional<AllTypeVariant>& search_value2) const override;
+
+  // returns the union of the bitmaps of value_ids[begin, end), which are united pairwise, so that every offset is
+  // copied O(log n) instead of O(n) times
+  PositionBitmap _unite(const std::vector<ValueID>& value_ids, const size_t begin, const size_t end) const;
+
+  std::vector<PositionBitmap> _value_bitmaps;
+};
+
+}  // namespace opossum
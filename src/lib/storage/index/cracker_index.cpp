@@ -0,0 +1,155 @@
+#include "cracker_index.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// the typed cracker column of a CrackerIndex
+class BaseCrackerColumn {
+ public:
+  virtual ~BaseCrackerColumn() = default;
+
+  // returns the offsets of the qualifying rows, which are in no particular order
+  virtual std::vector<ChunkOffset> lookup(const ScanType scan_type, const AllTypeVariant& search_value,
+                                          const std::optional<AllTypeVariant>& search_value2) = 0;
+
+  virtual size_t pivot_count() const = 0;
+
+  virtual size_t estimate_memory_usage() const = 0;
+};
+
+template <typename T>
+class CrackerColumn : public BaseCrackerColumn {
+ public:
+  explicit CrackerColumn(const std::vector<T>& values) {
+    _entries.reserve(values.size());
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+      _entries.emplace_back(values[chunk_offset], chunk_offset);
+    }
+  }
+
+  std::vector<ChunkOffset> lookup(const ScanType scan_type, const AllTypeVariant& search_value,
+                                  const std::optional<AllTypeVariant>& search_value2) override {
+    const auto value = type_cast<T>(search_value);
+    const auto size = _entries.size();
+
+    // the range [begin, end) of the cracker column that holds the qualifying rows
+    auto range = std::pair<size_t, size_t>{};
+    switch (scan_type) {
+      case ScanType::OpEquals:
+        range = {_crack(value, false), _crack(value, true)};
+        break;
+      case ScanType::OpLessThan:
+        range = {0, _crack(value, false)};
+        break;
+      case ScanType::OpLessThanEquals:
+        range = {0, _crack(value, true)};
+        break;
+      case ScanType::OpGreaterThan:
+        range = {_crack(value, true), size};
+        break;
+      case ScanType::OpGreaterThanEquals:
+        range = {_crack(value, false), size};
+        break;
+      case ScanType::OpBetween: {
+        const auto upper_value = type_cast<T>(*search_value2);
+        if (upper_value < value) return {};
+        range = {_crack(value, false), _crack(upper_value, true)};
+        break;
+      }
+      default:
+        Fail("Scan type is not supported by the CrackerIndex");
+    }
+
+    auto offsets = std::vector<ChunkOffset>{};
+    offsets.reserve(range.second - range.first);
+    for (auto position = range.first; position < range.second; ++position) {
+      offsets.push_back(_entries[position].second);
+    }
+    return offsets;
+  }
+
+  size_t pivot_count() const override { return _pivots.size(); }
+
+  size_t estimate_memory_usage() const override {
+    // a node of a red-black tree holds three pointers and the color besides its key and value
+    constexpr auto PIVOT_NODE_SIZE = sizeof(std::pair<const Pivot, size_t>) + 4 * sizeof(void*);
+    return _entries.capacity() * sizeof(std::pair<T, ChunkOffset>) + _pivots.size() * PIVOT_NODE_SIZE;
+  }
+
+ protected:
+  // a pivot splits the cracker column into the rows whose values are less than (or, for is_upper_bound, less than or
+  // equal to) the pivot's value and all others. Pivots on the same value are ordered lower bound first.
+  using Pivot = std::pair<T, bool>;
+
+  // partitions the piece of the cracker column that contains the pivot at the pivot, unless the column has been
+  // cracked there before, and returns the position of the first row that is not less than (or equal to) value
+  size_t _crack(const T& value, const bool is_upper_bound) {
+    const auto pivot = Pivot{value, is_upper_bound};
+    const auto next_pivot = _pivots.lower_bound(pivot);
+    if (next_pivot != _pivots.end() && next_pivot->first == pivot) return next_pivot->second;
+
+    // the piece between the neighbouring pivots
+    const auto piece_begin = next_pivot == _pivots.begin() ? size_t{0} : std::prev(next_pivot)->second;
+    const auto piece_end = next_pivot == _pivots.end() ? _entries.size() : next_pivot->second;
+    const auto split = std::partition(_entries.begin() + piece_begin, _entries.begin() + piece_end,
+                                      [&](const std::pair<T, ChunkOffset>& entry) {
+                                        return is_upper_bound ? !(value < entry.first) : entry.first < value;
+                                      });
+    const auto position = static_cast<size_t>(split - _entries.begin());
+    _pivots.emplace_hint(next_pivot, pivot, position);
+    return position;
+  }
+
+  std::vector<std::pair<T, ChunkOffset>> _entries;
+  std::map<Pivot, size_t> _pivots;
+};
+
+CrackerIndex::CrackerIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments)
+    : BaseIndex(SegmentIndexType::Cracking, indexed_segments) {
+  Assert(_indexed_segments.size() == 1, "CrackerIndex can only index a single segment");
+
+  hana::for_each(data_types, [&](auto data_type) {
+    using Type = typename decltype(+hana::second(data_type))::type;
+    if (_cracker_column) return;
+    if (const auto segment = dynamic_cast<const ValueSegment<Type>*>(_indexed_segments.front().get())) {
+      _cracker_column = std::make_unique<CrackerColumn<Type>>(segment->values());
+    }
+  });
+  Assert(_cracker_column, "CrackerIndex can only index a ValueSegment");
+}
+
+CrackerIndex::~CrackerIndex() = default;
+
+size_t CrackerIndex::pivot_count() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _cracker_column->pivot_count();
+}
+
+size_t CrackerIndex::estimate_memory_usage() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _cracker_column->estimate_memory_usage();
+}
+
+PositionBitmap CrackerIndex::_lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                                     const std::optional<AllTypeVariant>& search_value2) const {
+  auto offsets = std::vector<ChunkOffset>{};
+  {
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    offsets = _cracker_column->lookup(scan_type, search_values.front(), search_value2);
+  }
+  return _to_bitmap(offsets);
+}
+
+}  // namespace opossum
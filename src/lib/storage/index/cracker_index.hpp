@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "base_index.hpp"
+
+namespace opossum {
+
+class BaseCrackerColumn;
+
+// An adaptive index on a single ValueSegment that is not built upfront but by the lookups themselves (database
+// cracking). On creation, it only copies the values of the segment together with their offsets into the cracker
+// column. Every lookup partitions the pieces of the cracker column that contain its bounds at these bounds and records
+// them as pivots, so that the qualifying rows form a contiguous range of the cracker column. Later lookups only
+// partition the pieces they fall into, which get smaller with every query, so that frequent ranges are soon answered
+// without touching the values at all.
+//
+// Creating the index on a chunk's ValueSegment enables cracking for the column: TableScans with range predicates on
+// it look up the index instead of scanning the segment. Lookups reorganize the cracker column and are serialized.
+class CrackerIndex : public BaseIndex {
+ public:
+  explicit CrackerIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments);
+  ~CrackerIndex() override;
+
+  // returns the number of pivots at which the cracker column has been partitioned so far
+  size_t pivot_count() const;
+
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  PositionBitmap _lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                         const std::optional<AllTypeVariant>& search_value2) const override;
+
+  std::unique_ptr<BaseCrackerColumn> _cracker_column;
+  mutable std::mutex _mutex;
+};
+
+}  // namespace opossum
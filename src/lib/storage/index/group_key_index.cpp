@@ -0,0 +1,56 @@
+#include "group_key_index.hpp"
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+GroupKeyIndex::GroupKeyIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments)
+    : BaseIndex(SegmentIndexType::GroupKey, indexed_segments) {
+  Assert(_indexed_segments.size() == 1, "GroupKeyIndex can only index a single segment");
+
+  _with_dictionary_segment([&](const auto& segment) {
+    const auto row_count = static_cast<ChunkOffset>(segment.size());
+    _value_start_offsets.assign(segment.unique_values_count() + 1, ChunkOffset{0});
+    _postings.resize(row_count);
+
+    segment.with_value_ids([&](const auto* const value_ids) {
+      // counts the rows per value id, shifted by one, so that the prefix sums are the start offsets
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        ++_value_start_offsets[value_ids[chunk_offset] + 1];
+      }
+      for (auto value_id = size_t{1}; value_id < _value_start_offsets.size(); ++value_id) {
+        _value_start_offsets[value_id] += _value_start_offsets[value_id - 1];
+      }
+
+      auto next_postings = std::vector<ChunkOffset>(_value_start_offsets.cbegin(), _value_start_offsets.cend() - 1);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        _postings[next_postings[value_ids[chunk_offset]]++] = chunk_offset;
+      }
+    });
+  });
+}
+
+size_t GroupKeyIndex::estimate_memory_usage() const {
+  return (_value_start_offsets.capacity() + _postings.capacity()) * sizeof(ChunkOffset);
+}
+
+PositionBitmap GroupKeyIndex::_lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                                      const std::optional<AllTypeVariant>& search_value2) const {
+  // the range [begin, end) of value ids whose rows qualify
+  auto value_ids = std::pair<ValueID, ValueID>{};
+  _with_dictionary_segment([&](const auto& segment) {
+    value_ids = _value_id_range(segment, scan_type, search_values.front(), search_value2);
+  });
+
+  // the postings of a single value id are sorted already
+  auto offsets = std::vector<ChunkOffset>(_postings.cbegin() + _value_start_offsets[value_ids.first],
+                                          _postings.cbegin() + _value_start_offsets[value_ids.second]);
+  return _to_bitmap(offsets);
+}
+
+}  // namespace opossum
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "base_index.hpp"
+
+namespace opossum {
+
+// An index on a single DictionarySegment that groups the chunk offsets of the rows by their value ids. The postings
+// list holds the offsets of all rows with value id 0, then those with value id 1, and so on, each group in ascending
+// order. The value start offsets, indexed by value id, point to the first posting of each value id, followed by the
+// end of the postings.
+//
+// A lookup translates the search values to a range of value ids with the dictionary, like a scan of the segment, and
+// returns the postings of these value ids without reading the segment, so its cost only depends on the number of
+// matches. The index is built from the attribute vector with a counting sort.
+class GroupKeyIndex : public BaseIndex {
+ public:
+  explicit GroupKeyIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments);
+
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  PositionBitmap _lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                         const std::optional<AllTypeVariant>& search_value2) const override;
+
+  std::vector<ChunkOffset> _value_start_offsets;
+  std::vector<ChunkOffset> _postings;
+};
+
+}  // namespace opossum
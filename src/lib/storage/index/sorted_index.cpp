@@ -0,0 +1,179 @@
+#include "sorted_index.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/base_typed_segment.hpp"
+#include "storage/segment_accessor.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// the typed values of an indexed column of a SortedIndex
+class BaseSortedColumn {
+ public:
+  virtual ~BaseSortedColumn() = default;
+
+  // sorts the offsets stably by the values of their rows, which have to be in the order of the segment
+  virtual void sort(std::vector<ChunkOffset>& offsets) const = 0;
+
+  // puts the values in the order of the sorted offsets
+  virtual void arrange(const std::vector<ChunkOffset>& sorted_offsets) = 0;
+
+  // return the first position in [begin, end) whose value is not smaller than / greater than value. The values in
+  // the range have to be sorted.
+  virtual size_t lower_bound(const size_t begin, const size_t end, const AllTypeVariant& value) const = 0;
+  virtual size_t upper_bound(const size_t begin, const size_t end, const AllTypeVariant& value) const = 0;
+
+  virtual size_t estimate_memory_usage() const = 0;
+};
+
+template <typename T>
+class SortedColumn : public BaseSortedColumn {
+ public:
+  explicit SortedColumn(std::vector<T>&& values) : _values{std::move(values)} {}
+
+  void sort(std::vector<ChunkOffset>& offsets) const override {
+    std::stable_sort(offsets.begin(), offsets.end(),
+                     [&](const ChunkOffset left, const ChunkOffset right) { return _values[left] < _values[right]; });
+  }
+
+  void arrange(const std::vector<ChunkOffset>& sorted_offsets) override {
+    auto sorted_values = std::vector<T>{};
+    sorted_values.reserve(sorted_offsets.size());
+    for (const auto& chunk_offset : sorted_offsets) {
+      sorted_values.push_back(std::move(_values[chunk_offset]));
+    }
+    _values = std::move(sorted_values);
+  }
+
+  size_t lower_bound(const size_t begin, const size_t end, const AllTypeVariant& value) const override {
+    return std::lower_bound(_values.cbegin() + begin, _values.cbegin() + end, type_cast<T>(value)) - _values.cbegin();
+  }
+
+  size_t upper_bound(const size_t begin, const size_t end, const AllTypeVariant& value) const override {
+    return std::upper_bound(_values.cbegin() + begin, _values.cbegin() + end, type_cast<T>(value)) - _values.cbegin();
+  }
+
+  size_t estimate_memory_usage() const override { return _values.capacity() * sizeof(T); }
+
+ protected:
+  std::vector<T> _values;
+};
+
+SortedIndex::SortedIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments)
+    : BaseIndex(SegmentIndexType::Sorted, indexed_segments) {
+  const auto row_count = static_cast<ChunkOffset>(_indexed_segments.front()->size());
+  for (const auto& segment : _indexed_segments) {
+    Assert(segment->size() == row_count, "Indexed segments need the same number of rows");
+  }
+
+  // the values are read once for sorting, instead of for every comparison
+  for (const auto& segment : _indexed_segments) {
+    auto sorted_column = std::unique_ptr<BaseSortedColumn>{};
+    hana::for_each(data_types, [&](auto data_type) {
+      using Type = typename decltype(+hana::second(data_type))::type;
+      if (sorted_column || !dynamic_cast<const BaseTypedSegment<Type>*>(segment.get())) return;
+
+      auto values = std::vector<Type>(row_count);
+      materialize_values(*segment, ChunkOffsetRange{0, row_count}, values.data());
+      sorted_column = std::make_unique<SortedColumn<Type>>(std::move(values));
+    });
+    Assert(sorted_column, "SortedIndex can only index segments with values of a data type");
+    _sorted_columns.push_back(std::move(sorted_column));
+  }
+
+  // sorting stably by each column, from the last to the first, orders the rows by all columns
+  _sorted_offsets.resize(row_count);
+  std::iota(_sorted_offsets.begin(), _sorted_offsets.end(), ChunkOffset{0});
+  for (auto sorted_column = _sorted_columns.crbegin(); sorted_column != _sorted_columns.crend(); ++sorted_column) {
+    (*sorted_column)->sort(_sorted_offsets);
+  }
+  for (const auto& sorted_column : _sorted_columns) {
+    sorted_column->arrange(_sorted_offsets);
+  }
+}
+
+SortedIndex::~SortedIndex() = default;
+
+size_t SortedIndex::estimate_memory_usage() const {
+  auto memory_usage = _sorted_offsets.capacity() * sizeof(ChunkOffset);
+  for (const auto& sorted_column : _sorted_columns) {
+    memory_usage += sorted_column->estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
+PositionBitmap SortedIndex::_lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                                    const std::optional<AllTypeVariant>& search_value2) const {
+  // the values that have to be equal, which bound the range of all lookups
+  const auto prefix = std::vector<AllTypeVariant>(search_values.cbegin(), search_values.cend() - 1);
+
+  auto begin = size_t{0};
+  auto end = _sorted_offsets.size();
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      begin = _lower_bound(search_values);
+      end = _upper_bound(search_values);
+      break;
+    case ScanType::OpLessThan:
+      begin = _lower_bound(prefix);
+      end = _lower_bound(search_values);
+      break;
+    case ScanType::OpLessThanEquals:
+      begin = _lower_bound(prefix);
+      end = _upper_bound(search_values);
+      break;
+    case ScanType::OpGreaterThan:
+      begin = _upper_bound(search_values);
+      end = _upper_bound(prefix);
+      break;
+    case ScanType::OpGreaterThanEquals:
+      begin = _lower_bound(search_values);
+      end = _upper_bound(prefix);
+      break;
+    case ScanType::OpBetween: {
+      auto upper_values = search_values;
+      upper_values.back() = *search_value2;
+      begin = _lower_bound(search_values);
+      end = _upper_bound(upper_values);
+      break;
+    }
+    default:
+      Fail("Scan type is not supported by the SortedIndex");
+  }
+
+  // an empty range of values (e.g., BETWEEN 5 AND 3) yields bounds in the wrong order
+  if (!(begin < end)) return PositionBitmap{};
+  auto offsets = std::vector<ChunkOffset>(_sorted_offsets.cbegin() + begin, _sorted_offsets.cbegin() + end);
+  return _to_bitmap(offsets);
+}
+
+size_t SortedIndex::_lower_bound(const std::vector<AllTypeVariant>& key) const { return _bound(key, false); }
+
+size_t SortedIndex::_upper_bound(const std::vector<AllTypeVariant>& key) const { return _bound(key, true); }
+
+size_t SortedIndex::_bound(const std::vector<AllTypeVariant>& key, const bool is_upper_bound) const {
+  // the rows whose values are equal to the key so far, within which the next column is sorted
+  auto begin = size_t{0};
+  auto end = _sorted_offsets.size();
+  for (auto column_id = size_t{0}; column_id < key.size(); ++column_id) {
+    const auto& sorted_column = *_sorted_columns[column_id];
+    if (column_id + 1 == key.size()) {
+      return is_upper_bound ? sorted_column.upper_bound(begin, end, key[column_id])
+                            : sorted_column.lower_bound(begin, end, key[column_id]);
+    }
+    const auto equal_begin = sorted_column.lower_bound(begin, end, key[column_id]);
+    end = sorted_column.upper_bound(equal_begin, end, key[column_id]);
+    begin = equal_begin;
+  }
+  return is_upper_bound ? end : begin;
+}
+
+}  // namespace opossum
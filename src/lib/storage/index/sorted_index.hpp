@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "base_index.hpp"
+
+namespace opossum {
+
+class BaseSortedColumn;
+
+// An index on one or more segments of any type that lists the chunk offsets of all rows sorted by their indexed
+// values, compared column by column. Rows with equal values keep the order of their offsets. The values of each
+// indexed column are materialized once, in the order of the sorted offsets, so a lookup finds the range of qualifying
+// rows with typed binary searches: on the first column, then on the second column within the rows that are equal on
+// the first, and so on.
+class SortedIndex : public BaseIndex {
+ public:
+  explicit SortedIndex(const std::vector<std::shared_ptr<const BaseSegment>>& indexed_segments);
+  ~SortedIndex() override;
+
+  size_t estimate_memory_usage() const override;
+
+ protected:
+  PositionBitmap _lookup(const ScanType scan_type, const std::vector<AllTypeVariant>& search_values,
+                         const std::optional<AllTypeVariant>& search_value2) const override;
+
+  // return the position in the sorted offsets of the first row whose first key.size() values are not smaller than /
+  // greater than the key
+  size_t _lower_bound(const std::vector<AllTypeVariant>& key) const;
+  size_t _upper_bound(const std::vector<AllTypeVariant>& key) const;
+  size_t _bound(const std::vector<AllTypeVariant>& key, const bool is_upper_bound) const;
+
+  std::vector<ChunkOffset> _sorted_offsets;
+  std::vector<std::unique_ptr<BaseSortedColumn>> _sorted_columns;
+};
+
+}  // namespace opossum
@@ -0,0 +1,203 @@
+#include "position_bitmap.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+void PositionBitmap::append(const ChunkOffset chunk_offset) {
+  const auto key = static_cast<uint16_t>(chunk_offset >> 16);
+  const auto low_bits = static_cast<uint16_t>(chunk_offset & 0xFFFF);
+  DebugAssert(_containers.empty() || _containers.back().key < key ||
+                  (_containers.back().key == key && !_containers.back().contains(low_bits) &&
+                   (_containers.back().array.empty() || _containers.back().array.back() < low_bits)),
+              "Offsets have to be appended in ascending order");
+
+  if (_containers.empty() || _containers.back().key != key) {
+    _containers.push_back(Container{key});
+  }
+
+  auto& container = _containers.back();
+  ++container.cardinality;
+  ++_size;
+  if (container.bitmap.empty()) {
+    container.array.push_back(low_bits);
+    if (container.cardinality > ARRAY_CONTAINER_MAX_SIZE) container.normalize();
+  } else {
+    container.bitmap[low_bits / 64] |= uint64_t{1} << (low_bits % 64);
+  }
+}
+
+void PositionBitmap::append_range(const ChunkOffsetRange& range) {
+  for (auto chunk_offset = range.begin; chunk_offset < range.end; ++chunk_offset) {
+    append(chunk_offset);
+  }
+}
+
+bool PositionBitmap::contains(const ChunkOffset chunk_offset) const {
+  const auto key = static_cast<uint16_t>(chunk_offset >> 16);
+  const auto container = std::lower_bound(_containers.cbegin(), _containers.cend(), key,
+                                          [](const Container& container, uint16_t key) { return container.key < key; });
+  return container != _containers.cend() && container->key == key &&
+         container->contains(static_cast<uint16_t>(chunk_offset & 0xFFFF));
+}
+
+size_t PositionBitmap::size() const { return _size; }
+
+bool PositionBitmap::empty() const { return _size == 0; }
+
+ChunkOffset PositionBitmap::select(const size_t rank) const {
+  Assert(rank < _size, "Rank out of bounds");
+  auto remaining_rank = rank;
+  for (const auto& container : _containers) {
+    if (remaining_rank >= container.cardinality) {
+      remaining_rank -= container.cardinality;
+      continue;
+    }
+
+    const auto high_bits = static_cast<ChunkOffset>(container.key) << 16;
+    if (container.bitmap.empty()) return high_bits | container.array[remaining_rank];
+
+    for (auto word_index = size_t{0}; word_index < container.bitmap.size(); ++word_index) {
+      auto word = container.bitmap[word_index];
+      const auto word_cardinality = static_cast<size_t>(__builtin_popcountll(word));
+      if (remaining_rank >= word_cardinality) {
+        remaining_rank -= word_cardinality;
+        continue;
+      }
+      for (; remaining_rank > 0; --remaining_rank) word &= word - 1;
+      return high_bits | static_cast<ChunkOffset>(word_index * 64 + __builtin_ctzll(word));
+    }
+  }
+  Fail("Inconsistent cardinalities");
+  return ChunkOffset{0};
+}
+
+PositionBitmap PositionBitmap::intersect(const PositionBitmap& other) const {
+  auto result = PositionBitmap{};
+  auto left = _containers.cbegin();
+  auto right = other._containers.cbegin();
+  while (left != _containers.cend() && right != other._containers.cend()) {
+    if (left->key < right->key) {
+      ++left;
+    } else if (right->key < left->key) {
+      ++right;
+    } else {
+      result._append_container(_intersect(*left++, *right++));
+    }
+  }
+  return result;
+}
+
+PositionBitmap PositionBitmap::unite(const PositionBitmap& other) const {
+  auto result = PositionBitmap{};
+  auto left = _containers.cbegin();
+  auto right = other._containers.cbegin();
+  while (left != _containers.cend() || right != other._containers.cend()) {
+    if (right == other._containers.cend() || (left != _containers.cend() && left->key < right->key)) {
+      result._append_container(Container{*left++});
+    } else if (left == _containers.cend() || right->key < left->key) {
+      result._append_container(Container{*right++});
+    } else {
+      result._append_container(_unite(*left++, *right++));
+    }
+  }
+  return result;
+}
+
+size_t PositionBitmap::estimate_memory_usage() const {
+  auto memory_usage = _containers.capacity() * sizeof(Container);
+  for (const auto& container : _containers) {
+    memory_usage += container.array.capacity() * sizeof(uint16_t) + container.bitmap.capacity() * sizeof(uint64_t);
+  }
+  return memory_usage;
+}
+
+bool PositionBitmap::Container::contains(const uint16_t low_bits) const {
+  if (bitmap.empty()) return std::binary_search(array.cbegin(), array.cend(), low_bits);
+  return (bitmap[low_bits / 64] >> (low_bits % 64)) & 1;
+}
+
+void PositionBitmap::Container::normalize() {
+  if (bitmap.empty() && cardinality > ARRAY_CONTAINER_MAX_SIZE) {
+    bitmap.resize(BITMAP_CONTAINER_WORD_COUNT);
+    for (const auto low_bits : array) {
+      bitmap[low_bits / 64] |= uint64_t{1} << (low_bits % 64);
+    }
+    array = std::vector<uint16_t>{};
+  } else if (!bitmap.empty() && cardinality <= ARRAY_CONTAINER_MAX_SIZE) {
+    array.reserve(cardinality);
+    for (auto word_index = size_t{0}; word_index < bitmap.size(); ++word_index) {
+      for (auto word = bitmap[word_index]; word != 0; word &= word - 1) {
+        array.push_back(static_cast<uint16_t>(word_index * 64 + __builtin_ctzll(word)));
+      }
+    }
+    bitmap = std::vector<uint64_t>{};
+  }
+}
+
+PositionBitmap::Container PositionBitmap::_intersect(const Container& left, const Container& right) {
+  auto result = Container{left.key};
+
+  if (!left.bitmap.empty() && !right.bitmap.empty()) {
+    result.bitmap.resize(BITMAP_CONTAINER_WORD_COUNT);
+    for (auto word_index = size_t{0}; word_index < BITMAP_CONTAINER_WORD_COUNT; ++word_index) {
+      result.bitmap[word_index] = left.bitmap[word_index] & right.bitmap[word_index];
+      result.cardinality += __builtin_popcountll(result.bitmap[word_index]);
+    }
+    result.normalize();
+    return result;
+  }
+
+  if (left.bitmap.empty() && right.bitmap.empty()) {
+    std::set_intersection(left.array.cbegin(), left.array.cend(), right.array.cbegin(), right.array.cend(),
+                          std::back_inserter(result.array));
+  } else {
+    // the array is probed against the bitmap
+    const auto& array_container = left.bitmap.empty() ? left : right;
+    const auto& bitmap_container = left.bitmap.empty() ? right : left;
+    std::copy_if(array_container.array.cbegin(), array_container.array.cend(), std::back_inserter(result.array),
+                 [&](const uint16_t low_bits) { return bitmap_container.contains(low_bits); });
+  }
+  result.cardinality = static_cast<uint32_t>(result.array.size());
+  return result;
+}
+
+PositionBitmap::Container PositionBitmap::_unite(const Container& left, const Container& right) {
+  auto result = Container{left.key};
+
+  if (left.bitmap.empty() && right.bitmap.empty()) {
+    std::set_union(left.array.cbegin(), left.array.cend(), right.array.cbegin(), right.array.cend(),
+                   std::back_inserter(result.array));
+    result.cardinality = static_cast<uint32_t>(result.array.size());
+    result.normalize();
+    return result;
+  }
+
+  result.bitmap.resize(BITMAP_CONTAINER_WORD_COUNT);
+  for (const auto* container : {&left, &right}) {
+    if (container->bitmap.empty()) {
+      for (const auto low_bits : container->array) {
+        result.bitmap[low_bits / 64] |= uint64_t{1} << (low_bits % 64);
+      }
+    } else {
+      for (auto word_index = size_t{0}; word_index < BITMAP_CONTAINER_WORD_COUNT; ++word_index) {
+        result.bitmap[word_index] |= container->bitmap[word_index];
+      }
+    }
+  }
+  for (const auto word : result.bitmap) {
+    result.cardinality += __builtin_popcountll(word);
+  }
+  return result;
+}
+
+void PositionBitmap::_append_container(Container&& container) {
+  if (container.cardinality == 0) return;
+  _size += container.cardinality;
+  _containers.push_back(std::move(container));
+}
+
+}  // namespace opossum
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * A compressed set of offsets into a single chunk, organized like a roaring bitmap: the offsets are partitioned by
+ * their upper 16 bits into containers of up to 2^16 offsets each. Sparse containers store their offsets as a sorted
+ * array of 16-bit values, dense ones as a bitmap of 2^16 bits. Either way, a qualifying row takes at most two bytes
+ * instead of the eight bytes of a RowID in a PosList.
+ *
+ * Offsets are appended in ascending order, which is the order in which scans find them. Intersections and unions
+ * work container by container.
+ */
+class PositionBitmap {
+ public:
+  // containers with up to this many offsets store them as an array, which then takes at most as much memory as a
+  // bitmap container (8 KiB)
+  static constexpr size_t ARRAY_CONTAINER_MAX_SIZE = 4096;
+
+  // appends an offset, which has to be greater than all offsets added before
+  void append(const ChunkOffset chunk_offset);
+
+  // appends all offsets of the range
+  void append_range(const ChunkOffsetRange& range);
+
+  bool contains(const ChunkOffset chunk_offset) const;
+
+  // returns the number of offsets
+  size_t size() const;
+  bool empty() const;
+
+  // returns the offset at the given position in ascending order
+  ChunkOffset select(const size_t rank) const;
+
+  // calls functor for the offsets at the positions [rank_begin, rank_end) in ascending order
+  template <typename Functor>
+  void for_each(const Functor& functor, const size_t rank_begin = 0,
+                const size_t rank_end = std::numeric_limits<size_t>::max()) const {
+    auto rank = size_t{0};
+    for (const auto& container : _containers) {
+      if (rank >= rank_end) return;
+      if (rank + container.cardinality <= rank_begin) {
+        rank += container.cardinality;
+        continue;
+      }
+
+      const auto high_bits = static_cast<ChunkOffset>(container.key) << 16;
+      if (container.bitmap.empty()) {
+        const auto begin = rank_begin > rank ? rank_begin - rank : size_t{0};
+        const auto end = std::min(size_t{container.cardinality}, rank_end - rank);
+        for (auto index = begin; index < end; ++index) {
+          functor(high_bits | container.array[index]);
+        }
+        rank += container.cardinality;
+        continue;
+      }
+
+      for (auto word_index = size_t{0}; word_index < container.bitmap.size() && rank < rank_end; ++word_index) {
+        auto word = container.bitmap[word_index];
+        const auto word_cardinality = static_cast<size_t>(__builtin_popcountll(word));
+        if (rank + word_cardinality <= rank_begin) {
+          rank += word_cardinality;
+          continue;
+        }
+
+        // clears the lowest set bit in every iteration
+        for (; word != 0 && rank < rank_end; word &= word - 1, ++rank) {
+          if (rank < rank_begin) continue;
+          functor(high_bits | static_cast<ChunkOffset>(word_index * 64 + __builtin_ctzll(word)));
+        }
+      }
+    }
+  }
+
+  // returns the offsets contained in both bitmaps
+  PositionBitmap intersect(const PositionBitmap& other) const;
+
+  // returns the offsets contained in either bitmap
+  PositionBitmap unite(const PositionBitmap& other) const;
+
+  // returns the calculated memory usage
+  size_t estimate_memory_usage() const;
+
+ protected:
+  static constexpr size_t BITMAP_CONTAINER_WORD_COUNT = (size_t{1} << 16) / 64;
+
+  struct Container {
+    explicit Container(const uint16_t init_key) : key{init_key} {}
+
+    // the upper 16 bits of all offsets in the container
+    uint16_t key;
+    uint32_t cardinality = 0;
+    // the lower 16 bits of the offsets, sorted, unless the container is a bitmap
+    std::vector<uint16_t> array;
+    // one bit per possible offset, empty if the container is an array
+    std::vector<uint64_t> bitmap;
+
+    bool contains(const uint16_t low_bits) const;
+
+    // converts the container to the smaller of both representations
+    void normalize();
+  };
+
+  static Container _intersect(const Container& left, const Container& right);
+  static Container _unite(const Container& left, const Container& right);
+
+  void _append_container(Container&& container);
+
+  std::vector<Container> _containers;
+  size_t _size = 0;
+};
+
+// the rows of a single chunk given by a bitmap of their offsets
+struct ChunkRowBitmap {
+  ChunkID chunk_id;
+  std::shared_ptr<const PositionBitmap> offsets;
+};
+
+}  // namespace opossum
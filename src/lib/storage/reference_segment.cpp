@@ -1,5 +1,7 @@
 #include <storage/reference_segment.hpp>
 
+#include <algorithm>
+
 namespace opossum {
 
 ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table> referenced_table,
@@ -8,51 +10,178 @@ ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table> referenced
   _referenced_column_id{referenced_column_id},
   _pos{pos} {}
 
+ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table> referenced_table,
+                                   const ColumnID referenced_column_id, const ChunkRowRange& referenced_rows):
+  _referenced_table{referenced_table},
+  _referenced_column_id{referenced_column_id},
+  _referenced_rows{referenced_rows} {
+  DebugAssert(referenced_rows.offsets.begin <= referenced_rows.offsets.end, "Invalid range of referenced rows");
+}
+
+ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table> referenced_table,
+                                   const ColumnID referenced_column_id, const ChunkRowBitmap& referenced_bitmap):
+  _referenced_table{referenced_table},
+  _referenced_column_id{referenced_column_id},
+  _referenced_bitmap{referenced_bitmap} {
+  DebugAssert(referenced_bitmap.offsets, "Bitmap of referenced rows missing");
+}
+
 AllTypeVariant ReferenceSegment::operator[](const ChunkOffset chunk_offset) const {
+  if (_referenced_rows) {
+    Assert(chunk_offset < size(), "Chunk offset out of bounds");
+    const auto& segment = *referenced_table()->get_chunk(_referenced_rows->chunk_id).get_segment(_referenced_column_id);
+    return segment[_referenced_rows->offsets.begin + chunk_offset];
+  }
+
+  if (_referenced_bitmap) {
+    // selecting the offset would walk the bitmap on every access, the listed positions are built in a single pass
+    // and then kept
+    Assert(chunk_offset < size(), "Chunk offset out of bounds");
+    const auto& chunk = referenced_table()->get_chunk(_referenced_bitmap->chunk_id);
+    const auto& segment = *chunk.get_segment(_referenced_column_id);
+    return segment[pos_list()->at(chunk_offset).chunk_offset];
+  }
+
   const auto row_id = _pos->at(chunk_offset);
-  return referenced_table()->get_chunk(row_id.chunk_id).get_segment(_referenced_column_id)->operator[](chunk_offset);
+  if (row_id == NULL_ROW_ID) return NULL_VALUE;
+  return referenced_table()->get_chunk(row_id.chunk_id).get_segment(_referenced_column_id)->operator[](row_id.chunk_offset);
 }
 
-size_t ReferenceSegment::size() const { return _pos->size(); }
+size_t ReferenceSegment::size() const {
+  if (_referenced_rows) return _referenced_rows->offsets.end - _referenced_rows->offsets.begin;
+  if (_referenced_bitmap) return _referenced_bitmap->offsets->size();
+  return _pos->size();
+}
 
-const std::shared_ptr<const PosList> ReferenceSegment::pos_list() const { return _pos; }
+const std::shared_ptr<const PosList> ReferenceSegment::pos_list() const {
+  if (_referenced_rows) {
+    std::call_once(_pos_materialized, [&]() {
+      auto pos = std::make_shared<PosList>();
+      pos->reserve(size());
+      for (auto offset = _referenced_rows->offsets.begin; offset < _referenced_rows->offsets.end; ++offset) {
+        pos->push_back(RowID{_referenced_rows->chunk_id, offset});
+      }
+      pos->guarantee_single_chunk();
+      pos->guarantee_sorted();
+      _pos = pos;
+    });
+  } else if (_referenced_bitmap) {
+    std::call_once(_pos_materialized, [&]() {
+      auto pos = std::make_shared<PosList>();
+      pos->reserve(size());
+      _referenced_bitmap->offsets->for_each(
+          [&](const ChunkOffset chunk_offset) { pos->push_back(RowID{_referenced_bitmap->chunk_id, chunk_offset}); });
+      pos->guarantee_single_chunk();
+      pos->guarantee_sorted();
+      _pos = pos;
+    });
+  }
+  return _pos;
+}
 
 const std::shared_ptr<const Table> ReferenceSegment::referenced_table() const { return _referenced_table; }
 
 ColumnID ReferenceSegment::referenced_column_id() const { return _referenced_column_id; }
 
+const std::optional<ChunkRowRange>& ReferenceSegment::referenced_rows() const { return _referenced_rows; }
+
+const std::optional<ChunkRowBitmap>& ReferenceSegment::referenced_bitmap() const { return _referenced_bitmap; }
+
+std::optional<ChunkID> ReferenceSegment::referenced_chunk_id() const {
+  if (_referenced_rows) return _referenced_rows->chunk_id;
+  if (_referenced_bitmap) return _referenced_bitmap->chunk_id;
+  if (_pos->references_single_chunk() && !_pos->empty()) return _pos->front().chunk_id;
+  return std::nullopt;
+}
+
 size_t ReferenceSegment::estimate_memory_usage() const {
+  if (_referenced_rows) return sizeof(ChunkRowRange);
+  if (_referenced_bitmap) return _referenced_bitmap->offsets->estimate_memory_usage();
   return sizeof(RowID) * _pos->capacity();
 }
 
-void ReferenceSegment::segment_scan(const AllTypeVariant& compare_value, const ScanType scan_op, const std::function<void(RowID)> result_callback, ChunkID) const {
-  uint32_t chunk_count = _referenced_table->chunk_count();
-  std::vector<std::vector<ChunkOffset>> offset_filter_for_chunk(chunk_count);
-
-  for (const auto &item: *_pos) {
-    offset_filter_for_chunk[item.chunk_id].push_back(item.chunk_offset);
+void ReferenceSegment::for_each_referenced_chunk(const ChunkOffsetRange& row_range,
+                                                 const std::vector<ChunkOffset>* offset_filter,
+                                                 const ReferencedChunkCallback& callback) const {
+  DebugAssert(offset_filter || row_range.end <= size(), "Row range out of bounds");
+  const auto position_count = offset_filter ? offset_filter->size() : size_t{row_range.end - row_range.begin};
+  if (position_count == 0) return;
+
+  if (_referenced_rows) {
+    const auto first_offset = _referenced_rows->offsets.begin;
+    if (offset_filter) {
+      auto referenced_offset_filter = std::vector<ChunkOffset>(offset_filter->size());
+      std::transform(offset_filter->cbegin(), offset_filter->cend(), referenced_offset_filter.begin(),
+                     [&](const ChunkOffset offset) { return first_offset + offset; });
+      callback(_referenced_rows->chunk_id, ChunkOffsetRange{}, &referenced_offset_filter);
+    } else {
+      callback(_referenced_rows->chunk_id,
+               ChunkOffsetRange{first_offset + row_range.begin, first_offset + row_range.end}, nullptr);
+    }
+    return;
   }
 
-  for (uint32_t chunk_index = 0; chunk_index < chunk_count; chunk_index++) {
-    const auto &segment = referenced_table()->get_chunk(ChunkID(chunk_index)).get_segment(_referenced_column_id);
-    segment->segment_scan(compare_value, scan_op, result_callback, ChunkID(chunk_index), offset_filter_for_chunk[chunk_index]);
+  if (_referenced_bitmap && !offset_filter) {
+    auto chunk_offsets = std::vector<ChunkOffset>{};
+    chunk_offsets.reserve(position_count);
+    _referenced_bitmap->offsets->for_each(
+        [&](const ChunkOffset chunk_offset) { chunk_offsets.push_back(chunk_offset); }, row_range.begin,
+        row_range.end);
+    callback(_referenced_bitmap->chunk_id, ChunkOffsetRange{}, &chunk_offsets);
+    return;
   }
-}
 
+  // arbitrary offsets into a bitmap are looked up in the PosList, which is created for that once
+  const auto& pos = *pos_list();
+  const auto position = [&](const size_t index) -> const RowID& {
+    return pos[offset_filter ? (*offset_filter)[index] : row_range.begin + index];
+  };
+  const auto visit_chunk = [&](const ChunkID chunk_id, const std::vector<ChunkOffset>& chunk_offsets) {
+    callback(chunk_id, ChunkOffsetRange{}, &chunk_offsets);
+  };
+
+  std::vector<ChunkOffset> chunk_offsets;
+  chunk_offsets.reserve(position_count);
+
+  if (pos.references_single_chunk()) {
+    // all offsets can be passed on at once
+    for (auto index = size_t{0}; index < position_count; ++index) {
+      chunk_offsets.push_back(position(index).chunk_offset);
+    }
+    visit_chunk(position(0).chunk_id, chunk_offsets);
+    return;
+  }
 
-void ReferenceSegment::segment_scan(const AllTypeVariant& compare_value, const ScanType scan_op, const std::function<void(RowID)> result_callback, ChunkID, std::vector<ChunkOffset> offset_filter) const {
-  uint32_t chunk_count = _referenced_table->chunk_count();
-  std::vector<std::vector<ChunkOffset>> offset_filter_for_chunk(chunk_count);
+  if (pos.is_sorted()) {
+    // the positions of each chunk form a run, which is passed on as soon as it ends
+    auto run_chunk_id = position(0).chunk_id;
+    for (auto index = size_t{0}; index < position_count; ++index) {
+      const auto& row_id = position(index);
+      if (row_id == NULL_ROW_ID) continue;
+      if (row_id.chunk_id != run_chunk_id) {
+        if (!chunk_offsets.empty()) visit_chunk(run_chunk_id, chunk_offsets);
+        chunk_offsets.clear();
+        run_chunk_id = row_id.chunk_id;
+      }
+      chunk_offsets.push_back(row_id.chunk_offset);
+    }
+    if (!chunk_offsets.empty()) visit_chunk(run_chunk_id, chunk_offsets);
+    return;
+  }
 
-  for (const auto offset: offset_filter) {
-    const auto &item = (*_pos)[offset];
-    offset_filter_for_chunk[item.chunk_id].push_back(item.chunk_offset);
+  // without guarantees, the positions have to be grouped by chunk first
+  std::vector<std::vector<ChunkOffset>> offsets_per_chunk(_referenced_table->chunk_count());
+  for (auto index = size_t{0}; index < position_count; ++index) {
+    const auto& row_id = position(index);
+    if (row_id == NULL_ROW_ID) continue;
+    offsets_per_chunk[row_id.chunk_id].push_back(row_id.chunk_offset);
   }
 
-  for (uint32_t chunk_index = 0; chunk_index < chunk_count; chunk_index++) {
-    const auto &segment = referenced_table()->get_chunk(ChunkID(chunk_index)).get_segment(_referenced_column_id);
-    segment->segment_scan(compare_value, scan_op, result_callback, ChunkID(chunk_index), offset_filter_for_chunk[chunk_index]);
+  for (auto chunk_id = ChunkID{0}; chunk_id < offsets_per_chunk.size(); ++chunk_id) {
+    // chunks without any referenced position are skipped
+    if (offsets_per_chunk[chunk_id].empty()) continue;
+    visit_chunk(chunk_id, offsets_per_chunk[chunk_id]);
   }
 }
 
-}
+}  // namespace opossum
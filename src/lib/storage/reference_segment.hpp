@@ -1,14 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "base_segment.hpp"
+#include "base_typed_segment.hpp"
 #include "dictionary_segment.hpp"
+#include "position_bitmap.hpp"
 #include "table.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
@@ -17,11 +23,16 @@
 namespace opossum {
 
 // ReferenceSegment is a specific segment type that stores all its values as position list of a referenced segment
+// If it references a range of rows or a bitmap of rows in a single chunk, it only stores that range or bitmap. The
+// PosList is then only created when pos_list() is called, all other methods work on the range or bitmap directly.
 class ReferenceSegment : public BaseSegment {
  private:
   const std::shared_ptr<const Table> _referenced_table;
   const ColumnID _referenced_column_id;
-  const std::shared_ptr<const PosList> _pos;
+  const std::optional<ChunkRowRange> _referenced_rows;
+  const std::optional<ChunkRowBitmap> _referenced_bitmap;
+  mutable std::shared_ptr<const PosList> _pos;
+  mutable std::once_flag _pos_materialized;
 
  public:
   // creates a reference segment
@@ -30,26 +41,149 @@ class ReferenceSegment : public BaseSegment {
                    const ColumnID referenced_column_id,
                    const std::shared_ptr<const PosList> pos);
 
+  // creates a reference segment to all rows in referenced_rows
+  ReferenceSegment(const std::shared_ptr<const Table> referenced_table, const ColumnID referenced_column_id,
+                   const ChunkRowRange& referenced_rows);
+
+  // creates a reference segment to the rows of a chunk whose offsets are set in the bitmap
+  ReferenceSegment(const std::shared_ptr<const Table> referenced_table, const ColumnID referenced_column_id,
+                   const ChunkRowBitmap& referenced_bitmap);
+
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
 
   void append(const AllTypeVariant&) override { throw std::logic_error("ReferenceSegment is immutable"); }
 
   size_t size() const override;
 
+  // creates the PosList on the first call if the segment references a range or a bitmap of rows
   const std::shared_ptr<const PosList> pos_list() const;
   const std::shared_ptr<const Table> referenced_table() const;
 
   ColumnID referenced_column_id() const;
 
+  // returns the referenced rows if the segment was created with a range of rows instead of a PosList
+  const std::optional<ChunkRowRange>& referenced_rows() const;
+
+  // returns the referenced rows if the segment was created with a bitmap of rows instead of a PosList
+  const std::optional<ChunkRowBitmap>& referenced_bitmap() const;
+
+  // returns the chunk that all positions point into, if this is known without looking at the positions
+  std::optional<ChunkID> referenced_chunk_id() const;
+
   // returns the calculated memory usage
   virtual size_t estimate_memory_usage() const override;
 
-  // scans every value in this segment and calls the result_callback if the scan_op comparison with compare_value returns true
-  virtual void segment_scan(const AllTypeVariant& compare_value, const ScanType scan_op, const std::function<void(RowID)> result_callback, ChunkID chunk_id) const override;
+  // receives a referenced chunk and either a range of rows in it or, if given, the offsets of the rows in it
+  using ReferencedChunkCallback = std::function<void(ChunkID chunk_id, const ChunkOffsetRange& row_range,
+                                                     const std::vector<ChunkOffset>* offset_filter)>;
+
+  // groups the referenced positions (those in row_range, or those at offset_filter if given) by chunk and calls
+  // callback once for every referenced chunk with the offsets into that chunk. Chunks without any referenced position
+  // and NULL_ROW_IDs are skipped. If the PosList guarantees to be sorted or to reference a single chunk, no regrouping
+  // is needed.
+  // A range of referenced rows is passed on as a range.
+  // The offsets of a bitmap are listed only for the requested rows, the bitmap itself stays compressed.
+  void for_each_referenced_chunk(const ChunkOffsetRange& row_range, const std::vector<ChunkOffset>* offset_filter,
+                                 const ReferencedChunkCallback& callback) const;
+
+  // writes the values of the rows in row_range to output, T has to be the type of the referenced column.
+  // Consecutive positions into the same chunk are read with a single call to the typed referenced segment.
+  // T{} is written for NULL_ROW_IDs, which callers have to tell apart by the positions if they may occur.
+  template <typename T>
+  void materialize(const ChunkOffsetRange& row_range, T* output) const {
+    DebugAssert(row_range.begin <= row_range.end && row_range.end <= size(), "Row range out of bounds");
+    if (_referenced_rows) {
+      const auto begin = _referenced_rows->offsets.begin;
+      _typed_segment<T>(_referenced_rows->chunk_id)
+          .materialize(ChunkOffsetRange{begin + row_range.begin, begin + row_range.end}, output);
+      return;
+    }
+
+    if (_referenced_bitmap) {
+      std::vector<ChunkOffset> offsets;
+      offsets.reserve(row_range.end - row_range.begin);
+      _referenced_bitmap->offsets->for_each([&](const ChunkOffset chunk_offset) { offsets.push_back(chunk_offset); },
+                                            row_range.begin, row_range.end);
+      _typed_segment<T>(_referenced_bitmap->chunk_id).gather(offsets, output);
+      return;
+    }
+
+    const auto& pos = *_pos;
+    _gather_positions(row_range.end - row_range.begin,
+                      [&](const size_t index) { return pos[row_range.begin + index]; }, output);
+  }
+
+  // writes the values at the given offsets to output, T has to be the type of the referenced column
+  template <typename T>
+  void gather(const std::vector<ChunkOffset>& offsets, T* output) const {
+    if (_referenced_rows) {
+      std::vector<ChunkOffset> referenced_offsets(offsets.size());
+      std::transform(offsets.cbegin(), offsets.cend(), referenced_offsets.begin(),
+                     [&](const ChunkOffset chunk_offset) { return _referenced_rows->offsets.begin + chunk_offset; });
+      _typed_segment<T>(_referenced_rows->chunk_id).gather(referenced_offsets, output);
+      return;
+    }
+
+    if (_referenced_bitmap) {
+      std::vector<ChunkOffset> referenced_offsets(offsets.size());
+      const auto& bitmap = *_referenced_bitmap->offsets;
+      if (std::is_sorted(offsets.cbegin(), offsets.cend())) {
+        // ascending offsets (e.g., a batch of rows) are looked up in a single pass over the ranks they span
+        if (!offsets.empty()) {
+          auto next_index = size_t{0};
+          auto rank = size_t{offsets.front()};
+          bitmap.for_each(
+              [&](const ChunkOffset chunk_offset) {
+                for (; next_index < offsets.size() && offsets[next_index] == rank; ++next_index) {
+                  referenced_offsets[next_index] = chunk_offset;
+                }
+                ++rank;
+              },
+              offsets.front(), size_t{offsets.back()} + 1);
+        }
+      } else {
+        std::transform(offsets.cbegin(), offsets.cend(), referenced_offsets.begin(),
+                       [&](const ChunkOffset chunk_offset) { return bitmap.select(chunk_offset); });
+      }
+      _typed_segment<T>(_referenced_bitmap->chunk_id).gather(referenced_offsets, output);
+      return;
+    }
+
+    const auto& pos = *_pos;
+    _gather_positions(offsets.size(), [&](const size_t index) { return pos[offsets[index]]; }, output);
+  }
 
-  // same as above, but only using the values at offsets from offset_filter
-  virtual void segment_scan(const AllTypeVariant& compare_value, const ScanType scan_op, const std::function<void(RowID)> result_callback, ChunkID chunk_id, std::vector<ChunkOffset> offset_filter) const override;
+ protected:
+  template <typename T>
+  const BaseTypedSegment<T>& _typed_segment(const ChunkID chunk_id) const {
+    const auto segment = _referenced_table->get_chunk(chunk_id).get_segment(_referenced_column_id);
+    const auto typed_segment = dynamic_cast<const BaseTypedSegment<T>*>(segment.get());
+    Assert(typed_segment, "Referenced segment does not hold values of the requested type");
+    return *typed_segment;
+  }
 
+  // writes the values at position(0), ..., position(count - 1) to output, run by run of positions into the same chunk
+  template <typename T, typename PositionFunctor>
+  void _gather_positions(const size_t count, const PositionFunctor& position, T* output) const {
+    std::vector<ChunkOffset> offsets;
+    auto run_begin = size_t{0};
+    while (run_begin < count) {
+      const auto chunk_id = position(run_begin).chunk_id;
+      offsets.clear();
+      auto run_end = run_begin;
+      for (; run_end < count; ++run_end) {
+        const auto row_id = position(run_end);
+        if (row_id.chunk_id != chunk_id) break;
+        offsets.push_back(row_id.chunk_offset);
+      }
+      if (chunk_id == INVALID_CHUNK_ID) {
+        std::fill(output + run_begin, output + run_end, T{});
+      } else {
+        _typed_segment<T>(chunk_id).gather(offsets, output + run_begin);
+      }
+      run_begin = run_end;
+    }
+  }
 };
 
 }  // namespace opossum
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include "base_segment.hpp"
+#include "base_typed_segment.hpp"
+#include "reference_segment.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// Typed bulk access to any segment holding values of type T, directly (value and dictionary segments) or by
+// reference. Operators use these instead of operator[] or their own casts to the segment types, e.g.,
+//   std::vector<int> values(segment.size());
+//   materialize_values(segment, ChunkOffsetRange{0, static_cast<ChunkOffset>(segment.size())}, values.data());
+
+// writes the values of the rows in row_range of segment to output, which has to have room for all of them
+template <typename T>
+void materialize_values(const BaseSegment& segment, const ChunkOffsetRange& row_range, T* output) {
+  if (const auto typed_segment = dynamic_cast<const BaseTypedSegment<T>*>(&segment)) {
+    typed_segment->materialize(row_range, output);
+  } else if (const auto reference_segment = dynamic_cast<const ReferenceSegment*>(&segment)) {
+    reference_segment->materialize(row_range, output);
+  } else {
+    Fail("Segment does not hold values of the requested type");
+  }
+}
+
+// writes the values at the given offsets of segment to output, which has to have room for all of them
+template <typename T>
+void gather_values(const BaseSegment& segment, const std::vector<ChunkOffset>& offsets, T* output) {
+  if (const auto typed_segment = dynamic_cast<const BaseTypedSegment<T>*>(&segment)) {
+    typed_segment->gather(offsets, output);
+  } else if (const auto reference_segment = dynamic_cast<const ReferenceSegment*>(&segment)) {
+    reference_segment->gather(offsets, output);
+  } else {
+    Fail("Segment does not hold values of the requested type");
+  }
+}
+
+// data segments do not hold NULLs, only a ReferenceSegment with a PosList can reference NULL_ROW_ID. For such a
+// segment, this returns its PosList, and the rows for which it holds NULL_ROW_ID are NULL. Otherwise, it returns
+// nullptr.
+inline const PosList* nullable_positions(const BaseSegment& segment) {
+  const auto reference_segment = dynamic_cast<const ReferenceSegment*>(&segment);
+  if (!reference_segment || reference_segment->referenced_rows() || reference_segment->referenced_bitmap()) {
+    return nullptr;
+  }
+  return reference_segment->pos_list().get();
+}
+
+}  // namespace opossum
@@ -53,7 +53,8 @@ void Table::add_column(const std::string& name, const std::string& type) {
 }
 
 void Table::append(std::vector<AllTypeVariant> values) {
-  if (_chunks.back()->size() >= _max_chunk_size) {
+  // a maximum chunk size of 0 means that chunks are unbounded
+  if (_max_chunk_size > 0 && _chunks.back()->size() >= _max_chunk_size) {
     // create a new chunk if the current one is full
     _append_new_chunk();
   }
@@ -74,6 +75,14 @@ uint64_t Table::row_count() const {
 
 ChunkID Table::chunk_count() const { return ChunkID(_chunks.size()); }
 
+size_t Table::estimate_memory_usage() const {
+  auto memory_usage = size_t{0};
+  for (const auto& chunk : _chunks) {
+    memory_usage += chunk->estimate_memory_usage();
+  }
+  return memory_usage;
+}
+
 ColumnID Table::column_id_by_name(const std::string& column_name) const {
   auto search_index_iterator = std::find(_column_names.begin(), _column_names.end(), column_name);
   if (search_index_iterator == _column_names.end()) {
@@ -97,34 +106,58 @@ const std::string& Table::column_type(ColumnID column_id) const {
 }
 
 Chunk& Table::get_chunk(ChunkID chunk_id) {
-  DebugAssert(chunk_id < column_count(), "Chunk id out of bounds");
+  DebugAssert(chunk_id < chunk_count(), "Chunk id out of bounds");
   return *_chunks[chunk_id];
 }
 
 const Chunk& Table::get_chunk(ChunkID chunk_id) const {
-  DebugAssert(chunk_id < column_count(), "Chunk id out of bounds");
+  DebugAssert(chunk_id < chunk_count(), "Chunk id out of bounds");
   return *_chunks[chunk_id];
 }
 
-void Table::compress_chunk(ChunkID chunk_id) {
+void Table::compress_chunk(ChunkID chunk_id, const std::vector<ColumnID>& shared_dictionary_column_ids) {
   const auto& old_chunk = get_chunk(chunk_id);
 
   // new empty chunk
-  auto new_chunk = std::make_unique<Chunk>();
+  auto new_chunk = std::make_shared<Chunk>();
+
+  // columns that share a dictionary are compressed together
+  auto shared_dictionary_segments = std::vector<std::shared_ptr<BaseSegment>>(old_chunk.column_count());
+  if (!shared_dictionary_column_ids.empty()) {
+    const auto& column_type = _column_types[shared_dictionary_column_ids.front()];
+    resolve_data_type(column_type, [&](auto type) {
+      using Type = typename decltype(type)::type;
+
+      auto value_segments = std::vector<std::shared_ptr<BaseSegment>>{};
+      for (const auto& column_id : shared_dictionary_column_ids) {
+        Assert(column_id < old_chunk.column_count(), "Column id out of bounds");
+        Assert(_column_types[column_id] == column_type, "Only columns of the same type can share a dictionary");
+        value_segments.push_back(old_chunk.get_segment(column_id));
+      }
+
+      const auto dictionary = DictionarySegment<Type>::build_shared_dictionary(value_segments);
+      for (const auto& column_id : shared_dictionary_column_ids) {
+        shared_dictionary_segments[column_id] =
+            std::make_shared<DictionarySegment<Type>>(old_chunk.get_segment(column_id), dictionary);
+      }
+    });
+  }
 
   std::vector<std::thread> threads;
-  threads.reserve(old_chunk.size());
+  threads.reserve(old_chunk.column_count());
 
-  for (ColumnID column_id(0); column_id < old_chunk.size(); ++column_id) {
+  for (ColumnID column_id(0); column_id < old_chunk.column_count(); ++column_id) {
     const auto base_segment = old_chunk.get_segment(column_id);
     const auto segment_type = _column_types[column_id];
 
     std::shared_ptr<BaseSegment> compressed_segment;
 
-    //threads.push_back(std::thread([&compressed_segment, &base_segment, &segment_type]() {
+    if (shared_dictionary_segments[column_id]) {
+      compressed_segment = shared_dictionary_segments[column_id];
+    } else {
       // build dictionary compressed segment
       compressed_segment = make_shared_by_data_type<BaseSegment, DictionarySegment>(segment_type, base_segment);
-    //}));
+    }
 
     // add segment to chunk
     new_chunk->add_segment(compressed_segment);
@@ -135,7 +168,7 @@ void Table::compress_chunk(ChunkID chunk_id) {
   }*/
 
   // atomic chunk exchange
-  _chunks[chunk_id].reset(new_chunk.get());
+  _chunks[chunk_id] = new_chunk;
 }
 
 void Table::emplace_chunk(Chunk chunk) {
@@ -24,7 +24,7 @@ class Table : private Noncopyable {
  public:
   // creates a table
   // the parameter specifies the maximum chunk size, i.e., partition size
-  // default is the maximum chunk size minus 1. A table holds always at least one chunk
+  // default is the maximum chunk size minus 1, 0 means no limit. A table holds always at least one chunk
   explicit Table(const uint32_t chunk_size = std::numeric_limits<ChunkOffset>::max() - 1);
 
   // we need to explicitly set the move constructor to default when
@@ -43,6 +43,9 @@ class Table : private Noncopyable {
   // returns the number of chunks (cannot exceed ChunkID (uint32_t))
   ChunkID chunk_count() const;
 
+  // returns the calculated memory usage of all chunks, including their indexes
+  size_t estimate_memory_usage() const;
+
   // returns the chunk with the given id
   Chunk& get_chunk(ChunkID chunk_id);
   const Chunk& get_chunk(ChunkID chunk_id) const;
@@ -85,7 +88,8 @@ class Table : private Noncopyable {
   void create_new_chunk();
 
   // compresses a ValueSegment into a DictionarySegment
-  void compress_chunk(ChunkID chunk_id);
+  // the columns in shared_dictionary_column_ids get a common dictionary, so that their value ids can be compared
+  void compress_chunk(ChunkID chunk_id, const std::vector<ColumnID>& shared_dictionary_column_ids = {});
 
  protected:
   uint32_t _max_chunk_size;
@@ -1,5 +1,6 @@
 #include "value_segment.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -13,6 +14,9 @@
 
 namespace opossum {
 
+template <typename T>
+ValueSegment<T>::ValueSegment(std::vector<T>&& values) : _values{std::move(values)} {}
+
 template <typename T>
 AllTypeVariant ValueSegment<T>::operator[](const ChunkOffset chunk_offset) const {
   PerformanceWarning("operator[] used");
@@ -36,29 +40,26 @@ const std::vector<T>& ValueSegment<T>::values() const {
 }
 
 template <typename T>
-size_t ValueSegment<T>::estimate_memory_usage() const {
-  return _values.capacity() * sizeof(T);
+void ValueSegment<T>::materialize(const ChunkOffsetRange& row_range, T* output) const {
+  DebugAssert(row_range.begin <= row_range.end && row_range.end <= _values.size(), "Row range out of bounds");
+  std::copy(_values.cbegin() + row_range.begin, _values.cbegin() + row_range.end, output);
 }
 
 template <typename T>
-void ValueSegment<T>::segment_scan(const AllTypeVariant& compare_value, const ScanType scan_op, const std::function<void(RowID)> result_callback, ChunkID chunk_id) const {
-  const auto row_count = size();
-  const auto scan_predicate = _scan_predicate(type_cast<T>(compare_value), scan_op);
-  for(ChunkOffset row_index = 0; row_index < row_count; ++row_index) {
-    if(scan_predicate(_values[row_index])) {
-      result_callback(RowID{chunk_id, row_index});
+void ValueSegment<T>::gather(const std::vector<ChunkOffset>& offsets, T* output) const {
+  const auto offset_count = offsets.size();
+  for (auto index = size_t{0}; index < offset_count; ++index) {
+    if (index + ValueSegment::GATHER_PREFETCH_DISTANCE < offset_count) {
+      __builtin_prefetch(&_values[offsets[index + ValueSegment::GATHER_PREFETCH_DISTANCE]]);
     }
+    DebugAssert(offsets[index] < _values.size(), "Chunk offset out of bounds");
+    output[index] = _values[offsets[index]];
   }
 }
 
 template <typename T>
-void ValueSegment<T>::segment_scan(const AllTypeVariant& compare_value, const ScanType scan_op, const std::function<void(RowID)> result_callback, ChunkID chunk_id, std::vector<ChunkOffset> offset_filter) const {
-  const auto scan_predicate = _scan_predicate(type_cast<T>(compare_value), scan_op);
-  for(const ChunkOffset row_index: offset_filter) {
-    if(scan_predicate(_values[row_index])) {
-      result_callback(RowID{chunk_id, row_index});
-    }
-  }
+size_t ValueSegment<T>::estimate_memory_usage() const {
+  return _values.capacity() * sizeof(T);
 }
 
 EXPLICITLY_INSTANTIATE_DATA_TYPES(ValueSegment);
@@ -38,7 +38,9 @@ const T& get(const AllTypeVariant& value) {
 // Template specialization for everything but integral types
 template <typename T>
 std::enable_if_t<!std::is_integral<T>::value, T> type_cast(const AllTypeVariant& value) {
-  if (static_cast<size_t>(value.which()) == detail::index_of(types, hana::type_c<T>)) return get<T>(value);
+  if (static_cast<size_t>(value.which()) == detail::index_of(detail::variant_types, hana::type_c<T>)) {
+    return get<T>(value);
+  }
 
   return boost::lexical_cast<T>(value);
 }
@@ -46,7 +48,9 @@ std::enable_if_t<!std::is_integral<T>::value, T> type_cast(const AllTypeVariant&
 // Template specialization for integral types
 template <typename T>
 std::enable_if_t<std::is_integral<T>::value, T> type_cast(const AllTypeVariant& value) {
-  if (static_cast<size_t>(value.which()) == detail::index_of(types, hana::type_c<T>)) return get<T>(value);
+  if (static_cast<size_t>(value.which()) == detail::index_of(detail::variant_types, hana::type_c<T>)) {
+    return get<T>(value);
+  }
 
   try {
     return boost::lexical_cast<T>(value);
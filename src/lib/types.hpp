@@ -51,9 +51,80 @@ struct RowID {
   }
 };
 
-enum class ScanType { OpEquals, OpNotEquals, OpLessThan, OpLessThanEquals, OpGreaterThan, OpGreaterThanEquals };
+constexpr ChunkID INVALID_CHUNK_ID{std::numeric_limits<ChunkID::base_type>::max()};
+constexpr ChunkOffset INVALID_CHUNK_OFFSET{std::numeric_limits<ChunkOffset>::max()};
 
-using PosList = std::vector<RowID>;
+// references no row, e.g., the missing join partner of a row in an outer join. Segments referencing it return NULL.
+const RowID NULL_ROW_ID{INVALID_CHUNK_ID, INVALID_CHUNK_OFFSET};
+
+// OpBetween is inclusive on both ends and requires a second search value for the upper bound
+// OpIn matches all values contained in a list of search values
+// OpLike and OpILike (case-insensitive) match strings against a LIKE pattern given as search value
+enum class ScanType {
+  OpEquals,
+  OpNotEquals,
+  OpLessThan,
+  OpLessThanEquals,
+  OpGreaterThan,
+  OpGreaterThanEquals,
+  OpBetween,
+  OpIn,
+  OpLike,
+  OpILike
+};
+
+// Inner: all pairs of matching rows
+// Left: like Inner, rows of the left input without a match are paired with NULLs
+// Semi: the rows of the left input that have a match, each once
+// Anti: the rows of the left input that have no match
+enum class JoinMode { Inner, Left, Semi, Anti };
+
+// the aggregate functions of the Aggregate operator. They ignore NULLs, COUNT without a column counts all rows.
+enum class AggregateFunction { Min, Max, Sum, Avg, Count };
+
+// the direction in which the Sort operator orders the values of a column. NULLs are smaller than all other values.
+enum class OrderByMode { Ascending, Descending };
+
+// the operators of arithmetic expressions. Division and Modulo by zero yield NULL.
+enum class ArithmeticOperator { Addition, Subtraction, Multiplication, Division, Modulo };
+
+// the operators of logical expressions, which follow the three-valued logic of SQL
+enum class LogicalOperator { And, Or };
+
+// the kinds of secondary indexes on the segments of a chunk (see storage/index/)
+enum class SegmentIndexType { Sorted, GroupKey, AdaptiveRadixTree, Bitmap, Cracking };
+
+// A list of positions, usually the ones matched by an operator. It can carry guarantees about its content that allow
+// consumers like the ReferenceSegment to scan the referenced segments without regrouping the positions by chunk.
+// The guarantees are set by the producer and not verified, so they must only be given if they hold.
+class PosList : public std::vector<RowID> {
+ public:
+  using std::vector<RowID>::vector;
+
+  // all positions point into the same chunk, none is NULL_ROW_ID
+  void guarantee_single_chunk() { _references_single_chunk = true; }
+  bool references_single_chunk() const { return _references_single_chunk; }
+
+  // the positions are sorted by RowID, so all positions of a chunk form a contiguous run
+  void guarantee_sorted() { _is_sorted = true; }
+  bool is_sorted() const { return _is_sorted; }
+
+ protected:
+  bool _references_single_chunk = false;
+  bool _is_sorted = false;
+};
+
+// a contiguous range [begin, end) of rows within a chunk
+struct ChunkOffsetRange {
+  ChunkOffset begin;
+  ChunkOffset end;
+};
+
+// all rows in a range of one chunk, a compact replacement for a PosList that would list each of them
+struct ChunkRowRange {
+  ChunkID chunk_id;
+  ChunkOffsetRange offsets;
+};
 
 // Prevents unnecessary, potentially expensive, copies by deleting copy constructor and copy assignment operator.
 class Noncopyable {
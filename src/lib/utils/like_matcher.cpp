@@ -0,0 +1,155 @@
+#include "like_matcher.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+
+namespace opossum {
+
+namespace {
+
+char to_lower(const char character) { return static_cast<char>(std::tolower(static_cast<unsigned char>(character))); }
+
+template <bool CaseInsensitive>
+bool chars_equal(const char left, const char right) {
+  if constexpr (CaseInsensitive) {
+    return to_lower(left) == to_lower(right);
+  } else {
+    return left == right;
+  }
+}
+
+template <bool CaseInsensitive>
+bool strings_equal(const std::string_view left, const std::string_view right) {
+  if constexpr (CaseInsensitive) {
+    return left.size() == right.size() && std::equal(left.cbegin(), left.cend(), right.cbegin(), chars_equal<true>);
+  } else {
+    return left == right;
+  }
+}
+
+}  // namespace
+
+LikeMatcher::LikeMatcher(const std::string& pattern, const bool case_insensitive)
+    : _pattern{pattern}, _case_insensitive{case_insensitive} {
+  if (_case_insensitive) {
+    std::transform(_pattern.begin(), _pattern.end(), _pattern.begin(), to_lower);
+  }
+
+  const auto first_wildcard = _pattern.find_first_of("%_");
+  if (first_wildcard == std::string::npos) {
+    _pattern_type = PatternType::Exact;
+    _fixed_part = _pattern;
+    return;
+  }
+
+  // everything between the leading and the trailing % has to be free of wildcards to avoid the general matcher
+  const auto begin = _pattern.find_first_not_of('%');
+  const auto end = _pattern.find_last_not_of('%');
+  if (begin == std::string::npos) {
+    // the pattern consists only of %
+    _pattern_type = PatternType::Prefix;
+    return;
+  }
+
+  _fixed_part = _pattern.substr(begin, end - begin + 1);
+  if (_fixed_part.find_first_of("%_") != std::string::npos) {
+    _pattern_type = PatternType::General;
+    _fixed_part.clear();
+    return;
+  }
+
+  const auto leading_wildcard = begin > 0;
+  const auto trailing_wildcard = end + 1 < _pattern.size();
+  if (leading_wildcard && trailing_wildcard) {
+    _pattern_type = PatternType::Contains;
+  } else if (leading_wildcard) {
+    _pattern_type = PatternType::Suffix;
+  } else {
+    _pattern_type = PatternType::Prefix;
+  }
+}
+
+bool LikeMatcher::matches(const std::string_view value) const {
+  return _case_insensitive ? _matches<true>(value) : _matches<false>(value);
+}
+
+std::optional<std::string> LikeMatcher::prefix() const {
+  if (_pattern_type != PatternType::Prefix || _case_insensitive) return std::nullopt;
+  return _fixed_part;
+}
+
+template <bool CaseInsensitive>
+bool LikeMatcher::_matches(const std::string_view value) const {
+  const auto fixed_part = std::string_view{_fixed_part};
+  switch (_pattern_type) {
+    case PatternType::Exact:
+      return strings_equal<CaseInsensitive>(value, fixed_part);
+    case PatternType::Prefix:
+      return value.size() >= fixed_part.size() &&
+             strings_equal<CaseInsensitive>(value.substr(0, fixed_part.size()), fixed_part);
+    case PatternType::Suffix:
+      return value.size() >= fixed_part.size() &&
+             strings_equal<CaseInsensitive>(value.substr(value.size() - fixed_part.size()), fixed_part);
+    case PatternType::Contains:
+      return CaseInsensitive ? _contains_case_insensitive(value, fixed_part) : _contains(value, fixed_part);
+    case PatternType::General:
+      return _matches_general<CaseInsensitive>(value);
+  }
+  return false;
+}
+
+template <bool CaseInsensitive>
+bool LikeMatcher::_matches_general(const std::string_view value) const {
+  // iterative wildcard matching: on a mismatch, we backtrack to the last % and let it consume one more character
+  const auto pattern_size = _pattern.size();
+  auto value_position = size_t{0};
+  auto pattern_position = size_t{0};
+  auto last_wildcard_position = std::string::npos;
+  auto last_wildcard_match = size_t{0};
+
+  while (value_position < value.size()) {
+    if (pattern_position < pattern_size &&
+        (_pattern[pattern_position] == '_' ||
+         (_pattern[pattern_position] != '%' &&
+          chars_equal<CaseInsensitive>(_pattern[pattern_position], value[value_position])))) {
+      ++value_position;
+      ++pattern_position;
+    } else if (pattern_position < pattern_size && _pattern[pattern_position] == '%') {
+      last_wildcard_position = pattern_position++;
+      last_wildcard_match = value_position;
+    } else if (last_wildcard_position != std::string::npos) {
+      pattern_position = last_wildcard_position + 1;
+      value_position = ++last_wildcard_match;
+    } else {
+      return false;
+    }
+  }
+
+  while (pattern_position < pattern_size && _pattern[pattern_position] == '%') ++pattern_position;
+  return pattern_position == pattern_size;
+}
+
+bool LikeMatcher::_contains(const std::string_view haystack, const std::string_view needle) {
+  if (needle.empty()) return true;
+  if (haystack.size() < needle.size()) return false;
+
+  const auto* candidate = haystack.data();
+  const auto* const last_candidate = haystack.data() + (haystack.size() - needle.size());
+  while (candidate <= last_candidate) {
+    candidate = static_cast<const char*>(std::memchr(candidate, needle.front(), last_candidate - candidate + 1));
+    if (!candidate) return false;
+    if (std::memcmp(candidate + 1, needle.data() + 1, needle.size() - 1) == 0) return true;
+    ++candidate;
+  }
+  return false;
+}
+
+bool LikeMatcher::_contains_case_insensitive(const std::string_view haystack, const std::string_view needle) {
+  // the needle is already lower case, as the whole pattern is lowered on construction
+  return needle.empty() || std::search(haystack.cbegin(), haystack.cend(), needle.cbegin(), needle.cend(),
+                                       chars_equal<true>) != haystack.cend();
+}
+
+}  // namespace opossum
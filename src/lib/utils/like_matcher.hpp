@@ -0,0 +1,48 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace opossum {
+
+/**
+ * Matches strings against SQL LIKE patterns, where % matches any sequence of characters (including none) and _
+ * matches exactly one character. Case-insensitive matching (ILIKE) compares ASCII characters regardless of their case.
+ *
+ * The pattern is classified once on construction. The frequent forms 'abc', 'abc%', '%abc' and '%abc%' are matched by
+ * comparing the fixed part directly, only patterns with other wildcards take the general backtracking matcher.
+ */
+class LikeMatcher {
+ public:
+  LikeMatcher(const std::string& pattern, const bool case_insensitive);
+
+  bool matches(const std::string_view value) const;
+
+  // returns the common prefix of all matching values for case-sensitive patterns of the form 'abc%'
+  // in a sorted list, all matches then form a contiguous range that starts at lower_bound(prefix)
+  std::optional<std::string> prefix() const;
+
+ protected:
+  enum class PatternType { Exact, Prefix, Suffix, Contains, General };
+
+  template <bool CaseInsensitive>
+  bool _matches(const std::string_view value) const;
+
+  template <bool CaseInsensitive>
+  bool _matches_general(const std::string_view value) const;
+
+  // finds needle in haystack by searching its first character with memchr, which the C library implements with
+  // vectorized instructions, and only comparing the rest of the needle at these candidates
+  static bool _contains(const std::string_view haystack, const std::string_view needle);
+
+  static bool _contains_case_insensitive(const std::string_view haystack, const std::string_view needle);
+
+  std::string _pattern;
+  // the pattern without the leading and trailing %, unless it is of PatternType::General
+  std::string _fixed_part;
+  PatternType _pattern_type;
+  bool _case_insensitive;
+};
+
+}  // namespace opossum
@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/aggregate.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsAggregateTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto table = std::make_shared<Table>(4);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    table->add_column("c", "int");
+    table->add_column("d", "float");
+    table->append({1, "x", 10, 1.5f});
+    table->append({2, "y", 20, 2.5f});
+    table->append({1, "y", 30, -1.0f});
+    table->append({3, "x", 40, 4.0f});
+    table->append({2, "y", 50, 0.5f});
+    table->append({1, "x", 60, 3.0f});
+    table->append({3, "z", 70, 7.0f});
+    table->compress_chunk(ChunkID{0});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  // returns the rows of the table in ascending order
+  static std::vector<std::vector<AllTypeVariant>> sorted_rows(const Table& table) {
+    std::vector<std::vector<AllTypeVariant>> rows;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        rows.emplace_back();
+        for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+          rows.back().push_back((*chunk.get_segment(column_id))[chunk_offset]);
+        }
+      }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+  static std::shared_ptr<const Table> aggregate(const std::shared_ptr<const AbstractOperator>& in,
+                                                const std::vector<AggregateColumnDefinition>& aggregates,
+                                                const std::vector<ColumnID>& groupby_column_ids) {
+    auto aggregate = std::make_shared<Aggregate>(in, aggregates, groupby_column_ids);
+    aggregate->execute();
+    return aggregate->get_output();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsAggregateTest, AllFunctions) {
+  const auto output = aggregate(_table_wrapper,
+                                {{ColumnID{2}, AggregateFunction::Sum},
+                                 {std::nullopt, AggregateFunction::Count},
+                                 {ColumnID{3}, AggregateFunction::Min},
+                                 {ColumnID{3}, AggregateFunction::Max},
+                                 {ColumnID{2}, AggregateFunction::Avg}},
+                                {ColumnID{0}});
+
+  ASSERT_EQ(output->column_count(), 6u);
+  EXPECT_EQ(output->column_names(),
+            (std::vector<std::string>{"a", "SUM(c)", "COUNT(*)", "MIN(d)", "MAX(d)", "AVG(c)"}));
+  EXPECT_EQ(output->column_type(ColumnID{1}), "long");
+  EXPECT_EQ(output->column_type(ColumnID{2}), "long");
+  EXPECT_EQ(output->column_type(ColumnID{3}), "float");
+  EXPECT_EQ(output->column_type(ColumnID{5}), "double");
+
+  EXPECT_EQ(sorted_rows(*output),
+            (std::vector<std::vector<AllTypeVariant>>{{1, int64_t{100}, int64_t{3}, -1.0f, 3.0f, 100.0 / 3},
+                                                      {2, int64_t{70}, int64_t{2}, 0.5f, 2.5f, 35.0},
+                                                      {3, int64_t{110}, int64_t{2}, 4.0f, 7.0f, 55.0}}));
+}
+
+TEST_F(OperatorsAggregateTest, MultipleGroupByColumns) {
+  const auto output = aggregate(
+      _table_wrapper, {{ColumnID{1}, AggregateFunction::Max}, {ColumnID{3}, AggregateFunction::Sum}},
+      {ColumnID{1}, ColumnID{0}});
+  EXPECT_EQ(sorted_rows(*output), (std::vector<std::vector<AllTypeVariant>>{{"x", 1, "x", 4.5},
+                                                                            {"x", 3, "x", 4.0},
+                                                                            {"y", 1, "y", -1.0},
+                                                                            {"y", 2, "y", 3.0},
+                                                                            {"z", 3, "z", 7.0}}));
+
+  // only group-by columns, i.e., DISTINCT
+  EXPECT_EQ(aggregate(_table_wrapper, {}, {ColumnID{0}, ColumnID{1}})->row_count(), 5u);
+}
+
+TEST_F(OperatorsAggregateTest, WithoutGroupByColumns) {
+  const auto output = aggregate(_table_wrapper,
+                                {{ColumnID{1}, AggregateFunction::Min}, {ColumnID{2}, AggregateFunction::Sum}}, {});
+  EXPECT_EQ(sorted_rows(*output), (std::vector<std::vector<AllTypeVariant>>{{"x", int64_t{280}}}));
+
+  // without group-by columns, an empty input still results in one row, and in no row otherwise
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+  EXPECT_EQ(sorted_rows(*aggregate(scan, {{std::nullopt, AggregateFunction::Count}}, {})),
+            (std::vector<std::vector<AllTypeVariant>>{{int64_t{0}}}));
+  const auto grouped_output = aggregate(scan, {{std::nullopt, AggregateFunction::Count}}, {ColumnID{0}});
+  EXPECT_EQ(grouped_output->row_count(), 0u);
+  EXPECT_EQ(grouped_output->get_chunk(ChunkID{0}).column_count(), 2u);
+}
+
+TEST_F(OperatorsAggregateTest, AggregatesReferenceTables) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::OpNotEquals, "y");
+  scan->execute();
+  const auto output = aggregate(scan, {{ColumnID{2}, AggregateFunction::Sum}}, {ColumnID{1}});
+  EXPECT_EQ(sorted_rows(*output), (std::vector<std::vector<AllTypeVariant>>{{"x", int64_t{110}}, {"z", int64_t{70}}}));
+}
+
+TEST_F(OperatorsAggregateTest, SkipsNulls) {
+  auto right_table = std::make_shared<Table>();
+  right_table->add_column("e", "int");
+  right_table->add_column("f", "int");
+  right_table->append({1, 100});
+  right_table->append({2, 200});
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+
+  // the rows with a = 3 have no join partner, so e and f are NULL for them
+  auto join =
+      std::make_shared<JoinHash>(_table_wrapper, right, JoinMode::Left, std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+
+  const auto output = aggregate(join,
+                                {{std::nullopt, AggregateFunction::Count},
+                                 {ColumnID{5}, AggregateFunction::Count},
+                                 {ColumnID{5}, AggregateFunction::Max},
+                                 {ColumnID{5}, AggregateFunction::Sum}},
+                                {ColumnID{4}});
+  EXPECT_EQ(sorted_rows(*output),
+            (std::vector<std::vector<AllTypeVariant>>{{0, int64_t{2}, int64_t{0}, 0, int64_t{0}},
+                                                      {1, int64_t{3}, int64_t{3}, 100, int64_t{300}},
+                                                      {2, int64_t{2}, int64_t{2}, 200, int64_t{400}}}));
+}
+
+TEST_F(OperatorsAggregateTest, ManyGroups) {
+  // more groups than fit into a local hash table, spread over many chunks
+  const auto row_count = int32_t{200'000};
+  const auto group_count = int32_t{3 * Aggregate::LOCAL_GROUP_LIMIT};
+  auto table = std::make_shared<Table>(10'000);
+  table->add_column("a", "long");
+  table->add_column("b", "int");
+  for (auto row = int32_t{0}; row < row_count; ++row) {
+    table->append({int64_t{row} * 7'919 % group_count, row % 2});
+  }
+  table->compress_chunk(ChunkID{3});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto output =
+      aggregate(table_wrapper, {{std::nullopt, AggregateFunction::Count}, {ColumnID{1}, AggregateFunction::Sum}},
+                {ColumnID{0}});
+  ASSERT_EQ(output->row_count(), static_cast<uint64_t>(group_count));
+
+  auto total_count = int64_t{0};
+  auto total_sum = int64_t{0};
+  for (const auto& row : sorted_rows(*output)) {
+    total_count += type_cast<int64_t>(row[1]);
+    total_sum += type_cast<int64_t>(row[2]);
+  }
+  EXPECT_EQ(total_count, row_count);
+  EXPECT_EQ(total_sum, row_count / 2);
+}
+
+TEST_F(OperatorsAggregateTest, GroupsDictionarySegmentsByValueIds) {
+  // the same data, once in value and once in dictionary segments
+  const auto make_table = [](const bool compressed) {
+    auto table = std::make_shared<Table>(40'000);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    table->add_column("c", "long");
+    for (auto row = int32_t{0}; row < 80'000; ++row) {
+      table->append({row % 7, std::string(1, static_cast<char>('p' + row % 3)), int64_t{row}});
+    }
+    if (compressed) {
+      for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) table->compress_chunk(chunk_id);
+    }
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    return table_wrapper;
+  };
+  const auto value_table = make_table(false);
+  const auto dictionary_table = make_table(true);
+
+  const auto aggregates = std::vector<AggregateColumnDefinition>{{ColumnID{2}, AggregateFunction::Sum},
+                                                                  {std::nullopt, AggregateFunction::Count}};
+  const auto output = aggregate(dictionary_table, aggregates, {ColumnID{1}, ColumnID{0}});
+  EXPECT_EQ(output->row_count(), 21u);
+  EXPECT_EQ(sorted_rows(*output), sorted_rows(*aggregate(value_table, aggregates, {ColumnID{1}, ColumnID{0}})));
+
+  EXPECT_EQ(sorted_rows(*aggregate(dictionary_table, {}, {ColumnID{1}})),
+            (std::vector<std::vector<AllTypeVariant>>{{"p"}, {"q"}, {"r"}}));
+
+  // c has too many distinct values for the value ids to be combined, the groups are found by hashing instead
+  const auto hashed_output = aggregate(dictionary_table, aggregates, {ColumnID{0}, ColumnID{2}});
+  EXPECT_EQ(hashed_output->row_count(), 80'000u);
+  EXPECT_EQ(sorted_rows(*hashed_output), sorted_rows(*aggregate(value_table, aggregates, {ColumnID{0}, ColumnID{2}})));
+}
+
+TEST_F(OperatorsAggregateTest, RejectsInvalidAggregates) {
+  EXPECT_THROW(aggregate(_table_wrapper, {{ColumnID{1}, AggregateFunction::Sum}}, {}), std::logic_error);
+  EXPECT_THROW(aggregate(_table_wrapper, {{ColumnID{1}, AggregateFunction::Avg}}, {}), std::logic_error);
+  EXPECT_THROW(aggregate(_table_wrapper, {{std::nullopt, AggregateFunction::Min}}, {}), std::logic_error);
+  EXPECT_THROW(aggregate(_table_wrapper, {}, {ColumnID{4}}), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/index_scan.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/index/adaptive_radix_tree_index.hpp"
+#include "storage/index/bitmap_index.hpp"
+#include "storage/index/group_key_index.hpp"
+#include "storage/index/sorted_index.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsIndexScanTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // 100 rows in chunks of 40, a = row % 20 and b = row / 50
+    _table = std::make_shared<Table>(40);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    for (auto row = 0; row < 100; ++row) {
+      _table->append({row % 20, std::to_string(row / 50)});
+    }
+    _table->compress_chunk(ChunkID{1});
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  // returns the rows of the table, sorted
+  static std::vector<std::vector<AllTypeVariant>> sorted_rows(const Table& table) {
+    std::vector<std::vector<AllTypeVariant>> rows;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        rows.emplace_back();
+        for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+          rows.back().push_back((*chunk.get_segment(column_id))[chunk_offset]);
+        }
+      }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+  // checks that the IndexScan returns the rows of the equivalent TableScan
+  void check_index_scan(const std::shared_ptr<const AbstractOperator>& in, const ScanType scan_type,
+                        const AllTypeVariant& search_value,
+                        const std::optional<AllTypeVariant>& search_value2 = std::nullopt) {
+    auto index_scan = std::make_shared<IndexScan>(in, std::vector<ColumnID>{ColumnID{0}}, scan_type,
+                                                  std::vector<AllTypeVariant>{search_value}, search_value2);
+    index_scan->execute();
+    auto table_scan = std::make_shared<TableScan>(in, ColumnID{0}, scan_type, search_value, search_value2);
+    table_scan->execute();
+    EXPECT_EQ(sorted_rows(*index_scan->get_output()), sorted_rows(*table_scan->get_output()));
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsIndexScanTest, LooksUpIndexedChunks) {
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    _table->get_chunk(chunk_id).create_index<SortedIndex>({ColumnID{0}});
+  }
+
+  auto index_scan = std::make_shared<IndexScan>(_table_wrapper, std::vector<ColumnID>{ColumnID{0}},
+                                                ScanType::OpEquals, std::vector<AllTypeVariant>{7});
+  index_scan->execute();
+  const auto output = index_scan->get_output();
+  EXPECT_EQ(sorted_rows(*output), (std::vector<std::vector<AllTypeVariant>>{{7, "0"}, {7, "0"}, {7, "0"}, {7, "1"},
+                                                                            {7, "1"}}));
+  // the looked up rows are referenced through the bitmaps of the lookups, a scan would list them in a PosList
+  ASSERT_EQ(output->chunk_count(), 3u);
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{1}).get_segment(ColumnID{1}));
+  ASSERT_TRUE(segment);
+  EXPECT_TRUE(segment->referenced_bitmap());
+
+  check_index_scan(_table_wrapper, ScanType::OpLessThan, 3);
+  check_index_scan(_table_wrapper, ScanType::OpLessThanEquals, 3);
+  check_index_scan(_table_wrapper, ScanType::OpGreaterThan, 17);
+  check_index_scan(_table_wrapper, ScanType::OpGreaterThanEquals, 0);
+  check_index_scan(_table_wrapper, ScanType::OpBetween, 4, 6);
+  check_index_scan(_table_wrapper, ScanType::OpEquals, 20);
+  // the search values are converted to the type of the column
+  check_index_scan(_table_wrapper, ScanType::OpLessThan, 2.5);
+  check_index_scan(_table_wrapper, ScanType::OpEquals, int64_t{19});
+}
+
+TEST_F(OperatorsIndexScanTest, FallsBackToTableScan) {
+  // the second chunk has no index, and indexes do not support OpNotEquals
+  _table->get_chunk(ChunkID{0}).create_index<SortedIndex>({ColumnID{0}});
+  _table->get_chunk(ChunkID{2}).create_index<SortedIndex>({ColumnID{0}, ColumnID{1}});
+  check_index_scan(_table_wrapper, ScanType::OpEquals, 7);
+  check_index_scan(_table_wrapper, ScanType::OpBetween, 4, 16);
+  check_index_scan(_table_wrapper, ScanType::OpNotEquals, 7);
+
+  // reference tables hold no indexes
+  auto table_scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::OpEquals, "1");
+  table_scan->execute();
+  check_index_scan(table_scan, ScanType::OpGreaterThan, 12);
+}
+
+TEST_F(OperatorsIndexScanTest, LooksUpGroupKeyIndexes) {
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    if (chunk_id != ChunkID{1}) _table->compress_chunk(chunk_id);
+    _table->get_chunk(chunk_id).create_index<GroupKeyIndex>({ColumnID{0}});
+  }
+
+  check_index_scan(_table_wrapper, ScanType::OpEquals, 7);
+  check_index_scan(_table_wrapper, ScanType::OpLessThan, 3);
+  check_index_scan(_table_wrapper, ScanType::OpGreaterThanEquals, 17);
+  check_index_scan(_table_wrapper, ScanType::OpBetween, 4.5, 9);
+}
+
+TEST_F(OperatorsIndexScanTest, LooksUpAdaptiveRadixTreeIndexes) {
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    _table->get_chunk(chunk_id).create_index<AdaptiveRadixTreeIndex>({ColumnID{0}});
+  }
+
+  check_index_scan(_table_wrapper, ScanType::OpEquals, 7);
+  check_index_scan(_table_wrapper, ScanType::OpLessThanEquals, -1);
+  check_index_scan(_table_wrapper, ScanType::OpGreaterThan, 17);
+  check_index_scan(_table_wrapper, ScanType::OpBetween, 4, 9);
+}
+
+TEST_F(OperatorsIndexScanTest, LooksUpBitmapIndexes) {
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    if (chunk_id != ChunkID{1}) _table->compress_chunk(chunk_id);
+    _table->get_chunk(chunk_id).create_index<BitmapIndex>({ColumnID{0}});
+  }
+
+  check_index_scan(_table_wrapper, ScanType::OpEquals, 7);
+  check_index_scan(_table_wrapper, ScanType::OpLessThan, 3);
+  check_index_scan(_table_wrapper, ScanType::OpGreaterThanEquals, 17);
+  check_index_scan(_table_wrapper, ScanType::OpBetween, 4.5, 9);
+}
+
+TEST_F(OperatorsIndexScanTest, LooksUpMultipleColumns) {
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    _table->get_chunk(chunk_id).create_index<SortedIndex>({ColumnID{1}, ColumnID{0}});
+  }
+
+  // b = '1' AND a < 3, and b = '0' AND a = 25, which matches no row
+  auto index_scan = std::make_shared<IndexScan>(_table_wrapper, std::vector<ColumnID>{ColumnID{1}, ColumnID{0}},
+                                                ScanType::OpLessThan, std::vector<AllTypeVariant>{"1", 3});
+  index_scan->execute();
+  EXPECT_EQ(sorted_rows(*index_scan->get_output()),
+            (std::vector<std::vector<AllTypeVariant>>{{0, "1"}, {0, "1"}, {1, "1"}, {1, "1"}, {2, "1"}, {2, "1"}}));
+
+  auto empty_index_scan = std::make_shared<IndexScan>(_table_wrapper, std::vector<ColumnID>{ColumnID{1}, ColumnID{0}},
+                                                      ScanType::OpEquals, std::vector<AllTypeVariant>{"0", 25});
+  empty_index_scan->execute();
+  const auto output = empty_index_scan->get_output();
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->chunk_count(), 1u);
+  EXPECT_EQ(output->column_count(), 2u);
+}
+
+}  // namespace opossum
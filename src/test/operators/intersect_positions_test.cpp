@@ -0,0 +1,88 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/intersect_positions.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsIntersectPositionsTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto table = std::make_shared<Table>(4);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    for (auto value = 0; value < 10; ++value) {
+      table->append({value, std::to_string(value % 3)});
+    }
+    table->compress_chunk(ChunkID{1});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<TableScan> scan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
+                                  const ScanType scan_type, const AllTypeVariant& value) {
+    auto table_scan = std::make_shared<TableScan>(in, column_id, scan_type, value);
+    table_scan->execute();
+    return table_scan;
+  }
+
+  std::shared_ptr<const Table> intersect_positions(const std::shared_ptr<const AbstractOperator>& left,
+                                                   const std::shared_ptr<const AbstractOperator>& right) {
+    auto intersect_positions = std::make_shared<IntersectPositions>(left, right);
+    intersect_positions->execute();
+    return intersect_positions->get_output();
+  }
+
+  // returns the values of the column in the order of the table
+  static std::vector<AllTypeVariant> column_values(const Table& table, const ColumnID column_id) {
+    std::vector<AllTypeVariant> values;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        values.push_back((*chunk.get_segment(column_id))[chunk_offset]);
+      }
+    }
+    return values;
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsIntersectPositionsTest, IntersectsScans) {
+  // a < 7 AND b = '0', the second scan on top of another one
+  const auto output =
+      intersect_positions(scan(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 7),
+                          scan(scan(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1), ColumnID{1},
+                               ScanType::OpEquals, "0"));
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{3, 6}));
+  EXPECT_EQ(column_values(*output, ColumnID{1}), (std::vector<AllTypeVariant>{"0", "0"}));
+  EXPECT_EQ(output->chunk_count(), 2u);
+}
+
+TEST_F(OperatorsIntersectPositionsTest, IntersectsUnsortedPositions) {
+  auto sort = std::make_shared<Sort>(_table_wrapper, std::vector<SortColumnDefinition>{
+                                                         SortColumnDefinition{ColumnID{1}, OrderByMode::Descending}});
+  sort->execute();
+  const auto output = intersect_positions(sort, scan(sort, ColumnID{0}, ScanType::OpGreaterThanEquals, 2));
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST_F(OperatorsIntersectPositionsTest, ReturnsEmptyTable) {
+  const auto output = intersect_positions(scan(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 3),
+                                          scan(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 6));
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->chunk_count(), 1u);
+  EXPECT_EQ(output->column_count(), 2u);
+}
+
+}  // namespace opossum
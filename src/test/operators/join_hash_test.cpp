@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsJoinHashTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // keys 1 and 3 occur twice on the left, 3 and 4 twice on the right, 5 and 7 only on one side
+    auto left_table = std::make_shared<Table>(3);
+    left_table->add_column("a", "int");
+    left_table->add_column("b", "string");
+    for (const auto& [a, b] : std::vector<std::pair<int32_t, std::string>>{
+             {1, "one"}, {3, "three"}, {5, "five"}, {1, "uno"}, {3, "tres"}, {2, "two"}}) {
+      left_table->append({a, b});
+    }
+    left_table->compress_chunk(ChunkID{0});
+    _left = std::make_shared<TableWrapper>(left_table);
+    _left->execute();
+
+    auto right_table = std::make_shared<Table>(2);
+    right_table->add_column("c", "int");
+    right_table->add_column("d", "int");
+    for (const auto& [c, d] : std::vector<std::pair<int32_t, int32_t>>{{3, 30}, {4, 40}, {1, 10}, {3, 31}, {7, 70},
+                                                                       {4, 41}, {2, 20}}) {
+      right_table->append({c, d});
+    }
+    right_table->compress_chunk(ChunkID{1});
+    _right = std::make_shared<TableWrapper>(right_table);
+    _right->execute();
+  }
+
+  // returns the rows of the table in ascending order
+  static std::vector<std::vector<AllTypeVariant>> sorted_rows(const Table& table) {
+    std::vector<std::vector<AllTypeVariant>> rows;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        rows.emplace_back();
+        for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+          rows.back().push_back((*chunk.get_segment(column_id))[chunk_offset]);
+        }
+      }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+  std::shared_ptr<const Table> join(const std::shared_ptr<const AbstractOperator>& left,
+                                    const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
+                                    const std::pair<ColumnID, ColumnID>& column_ids = {ColumnID{0}, ColumnID{0}}) {
+    auto join = std::make_shared<JoinHash>(left, right, mode, column_ids);
+    join->execute();
+    return join->get_output();
+  }
+
+  std::shared_ptr<TableWrapper> _left, _right;
+};
+
+TEST_F(OperatorsJoinHashTest, InnerJoin) {
+  const auto output = join(_left, _right, JoinMode::Inner);
+  ASSERT_EQ(output->column_count(), 4u);
+  EXPECT_EQ(output->column_name(ColumnID{3}), "d");
+  EXPECT_EQ(sorted_rows(*output), (std::vector<std::vector<AllTypeVariant>>{{1, "one", 1, 10},
+                                                                            {1, "uno", 1, 10},
+                                                                            {2, "two", 2, 20},
+                                                                            {3, "three", 3, 30},
+                                                                            {3, "three", 3, 31},
+                                                                            {3, "tres", 3, 30},
+                                                                            {3, "tres", 3, 31}}));
+}
+
+TEST_F(OperatorsJoinHashTest, LeftOuterJoin) {
+  const auto output = join(_left, _right, JoinMode::Left);
+  const auto rows = sorted_rows(*output);
+  ASSERT_EQ(rows.size(), 8u);
+
+  const auto unmatched_row =
+      std::find_if(rows.cbegin(), rows.cend(), [](const auto& row) { return row[0] == AllTypeVariant{5}; });
+  ASSERT_NE(unmatched_row, rows.cend());
+  EXPECT_EQ((*unmatched_row)[1], AllTypeVariant{"five"});
+  EXPECT_TRUE(variant_is_null((*unmatched_row)[2]));
+  EXPECT_TRUE(variant_is_null((*unmatched_row)[3]));
+}
+
+TEST_F(OperatorsJoinHashTest, SemiAndAntiJoin) {
+  const auto semi_output = join(_left, _right, JoinMode::Semi);
+  ASSERT_EQ(semi_output->column_count(), 2u);
+  EXPECT_EQ(sorted_rows(*semi_output), (std::vector<std::vector<AllTypeVariant>>{
+                                           {1, "one"}, {1, "uno"}, {2, "two"}, {3, "three"}, {3, "tres"}}));
+
+  const auto anti_output = join(_left, _right, JoinMode::Anti);
+  EXPECT_EQ(sorted_rows(*anti_output), (std::vector<std::vector<AllTypeVariant>>{{5, "five"}}));
+
+  // the right input determines the keys that exist
+  const auto reverse_anti_output = join(_right, _left, JoinMode::Anti);
+  EXPECT_EQ(sorted_rows(*reverse_anti_output), (std::vector<std::vector<AllTypeVariant>>{{4, 40}, {4, 41}, {7, 70}}));
+}
+
+TEST_F(OperatorsJoinHashTest, JoinsReferenceTables) {
+  auto scan = std::make_shared<TableScan>(_right, ColumnID{1}, ScanType::OpNotEquals, 31);
+  scan->execute();
+
+  const auto output = join(_left, scan, JoinMode::Inner, {ColumnID{0}, ColumnID{0}});
+  EXPECT_EQ(output->row_count(), 5u);
+
+  // the output references the data tables, not the scan result
+  const auto right_segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{2}));
+  EXPECT_EQ(right_segment->referenced_table(), _right->get_output());
+
+  // rows without a join partner of a left outer join do not match in a further join
+  const auto left_output = std::make_shared<TableWrapper>(join(_left, _right, JoinMode::Left));
+  left_output->execute();
+  auto right_keys = std::make_shared<TableWrapper>(_right->get_output());
+  right_keys->execute();
+  const auto chained_output = join(left_output, right_keys, JoinMode::Anti, {ColumnID{2}, ColumnID{0}});
+  EXPECT_EQ(sorted_rows(*chained_output),
+            (std::vector<std::vector<AllTypeVariant>>{{5, "five", NULL_VALUE, NULL_VALUE}}));
+}
+
+TEST_F(OperatorsJoinHashTest, JoinsPartitionedInputs) {
+  // enough rows for the right input to be radix-partitioned
+  const auto row_count = int32_t{100'000};
+  auto left_table = std::make_shared<Table>(10'000);
+  left_table->add_column("a", "long");
+  auto right_table = std::make_shared<Table>(30'000);
+  right_table->add_column("b", "long");
+  for (auto value = int32_t{0}; value < row_count; ++value) {
+    left_table->append({int64_t{value} * 3});
+    right_table->append({int64_t{value} * 2});
+  }
+  auto left = std::make_shared<TableWrapper>(left_table);
+  left->execute();
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+
+  EXPECT_GT(JoinHash::radix_bits(right_table->row_count(), sizeof(int64_t) + sizeof(RowID)), 0u);
+
+  // multiples of 6 below 200'000
+  const auto output = join(left, right, JoinMode::Inner);
+  EXPECT_EQ(output->row_count(), 33'334u);
+  EXPECT_GT(output->chunk_count(), 1u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); chunk_offset += 1'000) {
+      EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[chunk_offset], (*chunk.get_segment(ColumnID{1}))[chunk_offset]);
+    }
+  }
+
+  EXPECT_EQ(join(left, right, JoinMode::Anti)->row_count(), static_cast<uint64_t>(row_count - 33'334));
+}
+
+TEST_F(OperatorsJoinHashTest, RequiresSameDataTypes) {
+  auto string_join =
+      std::make_shared<JoinHash>(_left, _right, JoinMode::Inner, std::make_pair(ColumnID{1}, ColumnID{0}));
+  EXPECT_THROW(string_join->execute(), std::logic_error);
+
+  // no value of a occurs in d, the result still has all columns
+  const auto output = join(_left, _right, JoinMode::Inner, {ColumnID{0}, ColumnID{1}});
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).column_count(), 4u);
+}
+
+}  // namespace opossum
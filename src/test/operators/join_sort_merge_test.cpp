@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/join_sort_merge.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/thread_pool.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsJoinSortMergeTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto left_table = std::make_shared<Table>(3);
+    left_table->add_column("a", "int");
+    left_table->add_column("b", "string");
+    for (const auto& [a, b] : std::vector<std::pair<int32_t, std::string>>{
+             {1, "one"}, {3, "three"}, {5, "five"}, {1, "uno"}, {3, "tres"}, {2, "two"}, {9, "nine"}}) {
+      left_table->append({a, b});
+    }
+    left_table->compress_chunk(ChunkID{0});
+    _left = std::make_shared<TableWrapper>(left_table);
+    _left->execute();
+
+    auto right_table = std::make_shared<Table>(2);
+    right_table->add_column("c", "int");
+    right_table->add_column("d", "int");
+    for (const auto& [c, d] : std::vector<std::pair<int32_t, int32_t>>{{3, 30}, {4, 40}, {1, 10}, {3, 31}, {7, 70},
+                                                                       {4, 41}, {2, 20}}) {
+      right_table->append({c, d});
+    }
+    right_table->compress_chunk(ChunkID{1});
+    _right = std::make_shared<TableWrapper>(right_table);
+    _right->execute();
+  }
+
+  // returns the rows of the table in ascending order
+  static std::vector<std::vector<AllTypeVariant>> sorted_rows(const Table& table) {
+    std::vector<std::vector<AllTypeVariant>> rows;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        rows.emplace_back();
+        for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+          rows.back().push_back((*chunk.get_segment(column_id))[chunk_offset]);
+        }
+      }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+  // joins the rows of both tables in nested loops
+  static std::vector<std::vector<AllTypeVariant>> expected_rows(const Table& left, const Table& right,
+                                                                const JoinMode mode, const ScanType scan_type) {
+    const auto compare = [&](const int32_t lhs, const int32_t rhs) {
+      switch (scan_type) {
+        case ScanType::OpEquals:
+          return lhs == rhs;
+        case ScanType::OpNotEquals:
+          return lhs != rhs;
+        case ScanType::OpLessThan:
+          return lhs < rhs;
+        case ScanType::OpLessThanEquals:
+          return lhs <= rhs;
+        case ScanType::OpGreaterThan:
+          return lhs > rhs;
+        default:
+          return lhs >= rhs;
+      }
+    };
+
+    std::vector<std::vector<AllTypeVariant>> rows;
+    for (const auto& left_row : sorted_rows(left)) {
+      auto has_match = false;
+      for (const auto& right_row : sorted_rows(right)) {
+        if (!compare(type_cast<int32_t>(left_row[0]), type_cast<int32_t>(right_row[0]))) continue;
+        has_match = true;
+        if (mode == JoinMode::Inner || mode == JoinMode::Left) {
+          rows.push_back(left_row);
+          rows.back().insert(rows.back().end(), right_row.cbegin(), right_row.cend());
+        }
+      }
+      if ((mode == JoinMode::Semi && has_match) || (mode == JoinMode::Anti && !has_match)) rows.push_back(left_row);
+      if (mode == JoinMode::Left && !has_match) {
+        rows.push_back(left_row);
+        rows.back().resize(left_row.size() + right.column_count(), NULL_VALUE);
+      }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+  std::shared_ptr<const Table> join(const std::shared_ptr<const AbstractOperator>& left,
+                                    const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
+                                    const ScanType scan_type,
+                                    const std::pair<ColumnID, ColumnID>& column_ids = {ColumnID{0}, ColumnID{0}}) {
+    auto join = std::make_shared<JoinSortMerge>(left, right, mode, column_ids, scan_type);
+    join->execute();
+    return join->get_output();
+  }
+
+  std::shared_ptr<TableWrapper> _left, _right;
+};
+
+TEST_F(OperatorsJoinSortMergeTest, InnerEquiJoin) {
+  const auto output = join(_left, _right, JoinMode::Inner, ScanType::OpEquals);
+  ASSERT_EQ(output->column_count(), 4u);
+  EXPECT_EQ(output->column_name(ColumnID{3}), "d");
+  EXPECT_EQ(sorted_rows(*output), (std::vector<std::vector<AllTypeVariant>>{{1, "one", 1, 10},
+                                                                            {1, "uno", 1, 10},
+                                                                            {2, "two", 2, 20},
+                                                                            {3, "three", 3, 30},
+                                                                            {3, "three", 3, 31},
+                                                                            {3, "tres", 3, 30},
+                                                                            {3, "tres", 3, 31}}));
+}
+
+TEST_F(OperatorsJoinSortMergeTest, AllPredicatesAndModes) {
+  for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                               ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals}) {
+    for (const auto mode : {JoinMode::Inner, JoinMode::Left, JoinMode::Semi, JoinMode::Anti}) {
+      EXPECT_EQ(sorted_rows(*join(_left, _right, mode, scan_type)),
+                expected_rows(*_left->get_output(), *_right->get_output(), mode, scan_type))
+          << "scan type " << static_cast<int>(scan_type) << ", mode " << static_cast<int>(mode);
+    }
+  }
+}
+
+TEST_F(OperatorsJoinSortMergeTest, NullKeysNeverMatch) {
+  // the rows 5 and 9 of the left input have no partner on the right, so c is NULL for them
+  const auto left_output = std::make_shared<TableWrapper>(join(_left, _right, JoinMode::Left, ScanType::OpEquals));
+  left_output->execute();
+
+  const auto output = join(left_output, _right, JoinMode::Anti, ScanType::OpNotEquals, {ColumnID{2}, ColumnID{0}});
+  EXPECT_EQ(sorted_rows(*output), (std::vector<std::vector<AllTypeVariant>>{{5, "five", NULL_VALUE, NULL_VALUE},
+                                                                            {9, "nine", NULL_VALUE, NULL_VALUE}}));
+  EXPECT_EQ(join(left_output, _right, JoinMode::Inner, ScanType::OpLessThan, {ColumnID{2}, ColumnID{0}})->row_count(),
+            29u);
+}
+
+TEST_F(OperatorsJoinSortMergeTest, JoinsLargeInputs) {
+  // the right input is sorted already, the left one is not and needs to be range-partitioned
+  const auto row_count = int32_t{100'000};
+  auto left_table = std::make_shared<Table>(10'000);
+  left_table->add_column("a", "long");
+  auto right_table = std::make_shared<Table>(30'000);
+  right_table->add_column("b", "long");
+  for (auto value = int32_t{0}; value < row_count; ++value) {
+    left_table->append({int64_t{value} * 7'919 % row_count * 3});
+    right_table->append({int64_t{value} * 2});
+  }
+  auto left = std::make_shared<TableWrapper>(left_table);
+  left->execute();
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+
+  EXPECT_EQ(JoinSortMerge::partition_count(left_table->row_count()),
+            std::min(size_t{10}, ThreadPool::get().worker_count()));
+
+  // multiples of 6 below 200'000
+  const auto output = join(left, right, JoinMode::Inner, ScanType::OpEquals);
+  EXPECT_EQ(output->row_count(), 33'334u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); chunk_offset += 1'000) {
+      EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[chunk_offset], (*chunk.get_segment(ColumnID{1}))[chunk_offset]);
+    }
+  }
+
+  auto hash_join = std::make_shared<JoinHash>(left, right, JoinMode::Anti, std::make_pair(ColumnID{0}, ColumnID{0}));
+  hash_join->execute();
+  EXPECT_EQ(join(left, right, JoinMode::Anti, ScanType::OpEquals)->row_count(), hash_join->get_output()->row_count());
+
+  // all values of a below 199'998 are smaller than some value of b
+  EXPECT_EQ(join(left, right, JoinMode::Semi, ScanType::OpLessThan)->row_count(), 66'666u);
+  EXPECT_EQ(join(left, right, JoinMode::Anti, ScanType::OpLessThanEquals)->row_count(), 33'333u);
+
+  // both inputs are sorted
+  EXPECT_EQ(join(right, right, JoinMode::Semi, ScanType::OpGreaterThan)->row_count(),
+            static_cast<uint64_t>(row_count - 1));
+}
+
+TEST_F(OperatorsJoinSortMergeTest, RejectsInvalidJoins) {
+  auto string_join = std::make_shared<JoinSortMerge>(_left, _right, JoinMode::Inner,
+                                                     std::make_pair(ColumnID{1}, ColumnID{0}), ScanType::OpLessThan);
+  EXPECT_THROW(string_join->execute(), std::logic_error);
+
+  EXPECT_THROW(std::make_shared<JoinSortMerge>(_left, _right, JoinMode::Inner,
+                                               std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::OpLike),
+               std::logic_error);
+
+  // no value of a is greater than all of d, the result still has all columns
+  const auto output = join(_left, _right, JoinMode::Inner, ScanType::OpGreaterThan, {ColumnID{0}, ColumnID{1}});
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).column_count(), 4u);
+}
+
+}  // namespace opossum
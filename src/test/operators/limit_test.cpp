@@ -0,0 +1,123 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/limit.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsLimitTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto table = std::make_shared<Table>(3);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    for (auto value = 0; value < 8; ++value) {
+      table->append({value, std::to_string(value)});
+    }
+    table->compress_chunk(ChunkID{1});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  // returns the values of the column in the order of the table
+  static std::vector<AllTypeVariant> column_values(const Table& table, const ColumnID column_id) {
+    std::vector<AllTypeVariant> values;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        values.push_back((*chunk.get_segment(column_id))[chunk_offset]);
+      }
+    }
+    return values;
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsLimitTest, LimitsDataTable) {
+  auto limit = std::make_shared<Limit>(_table_wrapper, 5);
+  limit->execute();
+  const auto output = limit->get_output();
+
+  EXPECT_EQ(output->column_names(), (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(output->chunk_count(), 2u);
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(column_values(*output, ColumnID{1}), (std::vector<AllTypeVariant>{"0", "1", "2", "3", "4"}));
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{1}).get_segment(ColumnID{1}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table_wrapper->get_output());
+}
+
+TEST_F(OperatorsLimitTest, LimitsReferenceTable) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 1);
+  scan->execute();
+  auto limit = std::make_shared<Limit>(scan, 4);
+  limit->execute();
+  const auto output = limit->get_output();
+
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{1, 2, 3, 4}));
+  // whole chunks of the input are forwarded
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).get_segment(ColumnID{1}),
+            scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{1}));
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table_wrapper->get_output());
+}
+
+TEST_F(OperatorsLimitTest, ReturnsAllOrNoRows) {
+  auto limit = std::make_shared<Limit>(_table_wrapper, 100);
+  limit->execute();
+  EXPECT_EQ(column_values(*limit->get_output(), ColumnID{0}), (std::vector<AllTypeVariant>{0, 1, 2, 3, 4, 5, 6, 7}));
+
+  auto empty_limit = std::make_shared<Limit>(_table_wrapper, 0);
+  empty_limit->execute();
+  const auto output = empty_limit->get_output();
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->chunk_count(), 1u);
+  EXPECT_EQ(output->column_count(), 2u);
+}
+
+TEST_F(OperatorsLimitTest, StopsScanEarly) {
+  auto table = std::make_shared<Table>(4);
+  table->add_column("a", "int");
+  for (auto value = 0; value < 4000; ++value) {
+    table->append({value % 7});
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto full_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 2);
+  full_scan->execute();
+  auto full_limit = std::make_shared<Limit>(full_scan, 10);
+  full_limit->execute();
+
+  // the input is only limited on request, as the Limit may not be its only consumer
+  auto shared_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 2);
+  auto shared_limit = std::make_shared<Limit>(shared_scan, 10);
+  EXPECT_FALSE(shared_scan->output_row_limit());
+
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 2);
+  auto limit = std::make_shared<Limit>(scan, 10, Limit::StopInputEarly::Yes);
+  EXPECT_EQ(scan->output_row_limit(), 10u);
+  EXPECT_FALSE(full_scan->output_row_limit());
+  scan->execute();
+  limit->execute();
+
+  EXPECT_LT(scan->get_output()->row_count(), full_scan->get_output()->row_count());
+  EXPECT_EQ(column_values(*limit->get_output(), ColumnID{0}), column_values(*full_limit->get_output(), ColumnID{0}));
+  EXPECT_EQ(limit->get_output()->row_count(), 10u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expressions.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsProjectionTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto table = std::make_shared<Table>(2);
+    table->add_column("a", "int");
+    table->add_column("b", "float");
+    table->add_column("c", "string");
+    table->add_column("d", "long");
+    table->append({4, 0.5f, "x", int64_t{10}});
+    table->append({-3, 0.25f, "y", int64_t{0}});
+    table->append({7, 1.0f, "3", int64_t{-4}});
+    table->append({0, 0.0f, "x", int64_t{5}});
+    table->append({2, 2.0f, "z", int64_t{2}});
+    table->compress_chunk(ChunkID{1});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  static std::shared_ptr<AbstractExpression> column(const ColumnID column_id) {
+    return std::make_shared<ColumnExpression>(column_id);
+  }
+
+  static std::shared_ptr<AbstractExpression> value(const AllTypeVariant& value) {
+    return std::make_shared<ValueExpression>(value);
+  }
+
+  static std::shared_ptr<AbstractExpression> arithmetic(const ArithmeticOperator arithmetic_operator,
+                                                        const std::shared_ptr<AbstractExpression>& left,
+                                                        const std::shared_ptr<AbstractExpression>& right) {
+    return std::make_shared<ArithmeticExpression>(arithmetic_operator, left, right);
+  }
+
+  static std::shared_ptr<AbstractExpression> comparison(const ScanType scan_type,
+                                                        const std::shared_ptr<AbstractExpression>& left,
+                                                        const std::shared_ptr<AbstractExpression>& right) {
+    return std::make_shared<ComparisonExpression>(scan_type, left, right);
+  }
+
+  static std::shared_ptr<const Table> project(const std::shared_ptr<const AbstractOperator>& in,
+                                              const std::vector<ProjectionColumnDefinition>& columns) {
+    auto projection = std::make_shared<Projection>(in, columns);
+    projection->execute();
+    return projection->get_output();
+  }
+
+  // returns the values of the column in the order of the table
+  static std::vector<AllTypeVariant> column_values(const Table& table, const ColumnID column_id) {
+    std::vector<AllTypeVariant> values;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        values.push_back((*chunk.get_segment(column_id))[chunk_offset]);
+      }
+    }
+    return values;
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsProjectionTest, ComputesArithmetic) {
+  // a * (1 - b) AS revenue, d + a, d / a and a % 3
+  const auto revenue =
+      arithmetic(ArithmeticOperator::Multiplication, column(ColumnID{0}),
+                 arithmetic(ArithmeticOperator::Subtraction, value(1), column(ColumnID{1})));
+  const auto output = project(_table_wrapper, {{revenue, "revenue"},
+                                               {arithmetic(ArithmeticOperator::Addition, column(ColumnID{3}),
+                                                           column(ColumnID{0}))},
+                                               {arithmetic(ArithmeticOperator::Division, column(ColumnID{3}),
+                                                           column(ColumnID{0}))},
+                                               {arithmetic(ArithmeticOperator::Modulo, column(ColumnID{0}),
+                                                           value(3))}});
+
+  EXPECT_EQ(output->column_names(), (std::vector<std::string>{"revenue", "d + a", "d / a", "a % 3"}));
+  EXPECT_EQ(output->column_type(ColumnID{0}), "float");
+  EXPECT_EQ(output->column_type(ColumnID{1}), "long");
+  EXPECT_EQ(output->chunk_count(), 3u);
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{2.0f, -2.25f, 0.0f, 0.0f, -2.0f}));
+  EXPECT_EQ(column_values(*output, ColumnID{1}),
+            (std::vector<AllTypeVariant>{int64_t{14}, int64_t{-3}, int64_t{3}, int64_t{5}, int64_t{4}}));
+  // division by zero is NULL
+  EXPECT_EQ(column_values(*output, ColumnID{2}),
+            (std::vector<AllTypeVariant>{int64_t{2}, int64_t{0}, int64_t{0}, NULL_VALUE, int64_t{1}}));
+  EXPECT_EQ(column_values(*output, ColumnID{3}), (std::vector<AllTypeVariant>{1, 0, 1, 0, 2}));
+}
+
+TEST_F(OperatorsProjectionTest, ComputesComparisonsCaseAndCasts) {
+  // a condition, CASE expressions with and without ELSE, and casts between strings and numbers
+  const auto condition = std::make_shared<LogicalExpression>(
+      LogicalOperator::And, comparison(ScanType::OpGreaterThan, column(ColumnID{0}), value(0)),
+      comparison(ScanType::OpNotEquals, column(ColumnID{2}), value("x")));
+  const auto case_expression = std::make_shared<CaseExpression>(condition, column(ColumnID{1}), value(0));
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::OpEquals, "3");
+  scan->execute();
+
+  const auto output = project(_table_wrapper, {{condition},
+                                               {case_expression},
+                                               {std::make_shared<CastExpression>(column(ColumnID{0}), "string")},
+                                               {std::make_shared<CaseExpression>(
+                                                   comparison(ScanType::OpLessThan, column(ColumnID{3}), value(3)),
+                                                   column(ColumnID{2}))}});
+  EXPECT_EQ(output->column_names(),
+            (std::vector<std::string>{"(a > 0) AND (c != 'x')", "CASE WHEN (a > 0) AND (c != 'x') THEN b ELSE 0 END",
+                                      "CAST(a AS string)", "CASE WHEN d < 3 THEN c END"}));
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{0, 0, 1, 0, 1}));
+  EXPECT_EQ(output->column_type(ColumnID{1}), "float");
+  EXPECT_EQ(column_values(*output, ColumnID{1}), (std::vector<AllTypeVariant>{0.0f, 0.0f, 1.0f, 0.0f, 2.0f}));
+  EXPECT_EQ(column_values(*output, ColumnID{2}), (std::vector<AllTypeVariant>{"4", "-3", "7", "0", "2"}));
+  EXPECT_EQ(column_values(*output, ColumnID{3}), (std::vector<AllTypeVariant>{NULL_VALUE, "y", "3", NULL_VALUE, "z"}));
+
+  const auto cast_output =
+      project(scan, {{arithmetic(ArithmeticOperator::Addition,
+                                 std::make_shared<CastExpression>(column(ColumnID{2}), "double"), value(0.5))}});
+  EXPECT_EQ(column_values(*cast_output, ColumnID{0}), (std::vector<AllTypeVariant>{3.5}));
+  EXPECT_THROW(project(_table_wrapper, {{std::make_shared<CastExpression>(column(ColumnID{2}), "int")}}),
+               std::exception);
+}
+
+TEST_F(OperatorsProjectionTest, ForwardsColumns) {
+  const auto output = project(_table_wrapper, {{column(ColumnID{2})}, {column(ColumnID{0}), "e"}});
+  EXPECT_EQ(output->column_names(), (std::vector<std::string>{"c", "e"}));
+  EXPECT_EQ(column_values(*output, ColumnID{1}), (std::vector<AllTypeVariant>{4, -3, 7, 0, 2}));
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{1}).get_segment(ColumnID{0}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table_wrapper->get_output());
+
+  // ReferenceSegments of the input are forwarded as they are
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 0);
+  scan->execute();
+  const auto scan_output = project(scan, {{column(ColumnID{3})}, {column(ColumnID{0})}});
+  EXPECT_EQ(scan_output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}),
+            scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{3}));
+  EXPECT_EQ(column_values(*scan_output, ColumnID{1}), (std::vector<AllTypeVariant>{4, 7, 2}));
+}
+
+TEST_F(OperatorsProjectionTest, ForwardsColumnsNextToComputedColumns) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 0);
+  scan->execute();
+  const auto output = project(scan, {{column(ColumnID{3})},
+                                     {arithmetic(ArithmeticOperator::Subtraction, column(ColumnID{0}), value(1))},
+                                     {column(ColumnID{2})}});
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{int64_t{10}, int64_t{-4}, int64_t{2}}));
+  EXPECT_EQ(column_values(*output, ColumnID{1}), (std::vector<AllTypeVariant>{3, 6, 1}));
+  EXPECT_EQ(column_values(*output, ColumnID{2}), (std::vector<AllTypeVariant>{"x", "3", "z"}));
+
+  // the forwarded columns are the scan's ReferenceSegments, which reference the scanned table at the scan's positions
+  const auto& scan_chunk = scan->get_output()->get_chunk(ChunkID{0});
+  const auto& chunk = output->get_chunk(ChunkID{0});
+  for (const auto& [column_id, scan_column_id] : {std::pair{ColumnID{0}, ColumnID{3}}, {ColumnID{2}, ColumnID{2}}}) {
+    const auto segment = std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(column_id));
+    const auto scan_segment = std::dynamic_pointer_cast<ReferenceSegment>(scan_chunk.get_segment(scan_column_id));
+    ASSERT_TRUE(segment);
+    EXPECT_EQ(segment, scan_segment);
+    EXPECT_EQ(segment->referenced_table(), _table_wrapper->get_output());
+    EXPECT_EQ(segment->pos_list(), scan_segment->pos_list());
+  }
+  const auto computed_segment = std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(ColumnID{1}));
+  ASSERT_TRUE(computed_segment);
+  EXPECT_NE(computed_segment->referenced_table(), _table_wrapper->get_output());
+}
+
+TEST_F(OperatorsProjectionTest, IsScannedByTableScan) {
+  const auto output_wrapper = [](const std::shared_ptr<const Table>& table) {
+    auto wrapper = std::make_shared<TableWrapper>(table);
+    wrapper->execute();
+    return wrapper;
+  };
+  const auto scanned_values = [&](const std::shared_ptr<const Table>& table,
+                                  const std::vector<ScanPredicate>& predicates, const ColumnID column_id) {
+    auto scan = std::make_shared<TableScan>(output_wrapper(table), predicates);
+    scan->execute();
+    return column_values(*scan->get_output(), column_id);
+  };
+
+  // forwarded columns of a data table and computed columns
+  const auto output = project(_table_wrapper, {{column(ColumnID{0})},
+                                               {arithmetic(ArithmeticOperator::Multiplication, column(ColumnID{0}),
+                                                           value(2))},
+                                               {column(ColumnID{2})}});
+  EXPECT_EQ(scanned_values(output, {{ColumnID{1}, ScanType::OpGreaterThanEquals, 4}}, ColumnID{2}),
+            (std::vector<AllTypeVariant>{"x", "3", "z"}));
+  EXPECT_EQ(scanned_values(output, {{ColumnID{0}, ScanType::OpLessThan, 5}, {ColumnID{2}, ScanType::OpEquals, "x"}},
+                           ColumnID{1}),
+            (std::vector<AllTypeVariant>{8, 0}));
+
+  // the right side of a left join is NULL for rows without a join partner
+  auto right_table = std::make_shared<Table>();
+  right_table->add_column("e", "int");
+  right_table->append({4});
+  right_table->append({7});
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+  auto join =
+      std::make_shared<JoinHash>(_table_wrapper, right, JoinMode::Left, std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+  const auto null_output =
+      project(join, {{column(ColumnID{0})}, {arithmetic(ArithmeticOperator::Addition, column(ColumnID{4}), value(1))}});
+  auto values = scanned_values(null_output, {{ColumnID{1}, ScanType::OpGreaterThan, 0}}, ColumnID{0});
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(values, (std::vector<AllTypeVariant>{4, 7}));
+  values = scanned_values(null_output, {{ColumnID{0}, ScanType::OpGreaterThan, 0}}, ColumnID{1});
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(values, (std::vector<AllTypeVariant>{NULL_VALUE, 5, 8}));
+
+  // the join itself references two tables
+  values = scanned_values(join->get_output(), {{ColumnID{4}, ScanType::OpNotEquals, 4}}, ColumnID{0});
+  EXPECT_EQ(values, (std::vector<AllTypeVariant>{7}));
+}
+
+TEST_F(OperatorsProjectionTest, PropagatesNulls) {
+  auto right_table = std::make_shared<Table>();
+  right_table->add_column("e", "int");
+  right_table->append({4});
+  right_table->append({7});
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+  auto join =
+      std::make_shared<JoinHash>(_table_wrapper, right, JoinMode::Left, std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+
+  const auto is_seven = comparison(ScanType::OpEquals, column(ColumnID{4}), value(7));
+  const auto output =
+      project(join, {{column(ColumnID{0})},
+                     {arithmetic(ArithmeticOperator::Multiplication, column(ColumnID{4}), value(int64_t{2}))},
+                     {std::make_shared<LogicalExpression>(LogicalOperator::Or, is_seven, value(1))},
+                     {std::make_shared<LogicalExpression>(LogicalOperator::And, is_seven, value(1))},
+                     {std::make_shared<CaseExpression>(is_seven, value("seven"), value("other"))},
+                     {value(NULL_VALUE)}});
+
+  auto expected_rows = std::vector<std::vector<AllTypeVariant>>{{4, int64_t{8}, 1, 0, "other", NULL_VALUE},
+                                                                {-3, NULL_VALUE, 1, NULL_VALUE, "other", NULL_VALUE},
+                                                                {7, int64_t{14}, 1, 1, "seven", NULL_VALUE},
+                                                                {0, NULL_VALUE, 1, NULL_VALUE, "other", NULL_VALUE},
+                                                                {2, NULL_VALUE, 1, NULL_VALUE, "other", NULL_VALUE}};
+  std::sort(expected_rows.begin(), expected_rows.end());
+  auto rows = std::vector<std::vector<AllTypeVariant>>(output->row_count());
+  for (auto column_id = ColumnID{0}; column_id < output->column_count(); ++column_id) {
+    const auto values = column_values(*output, column_id);
+    for (auto row = size_t{0}; row < values.size(); ++row) rows[row].push_back(values[row]);
+  }
+  std::sort(rows.begin(), rows.end());
+  EXPECT_EQ(rows, expected_rows);
+}
+
+TEST_F(OperatorsProjectionTest, RejectsInvalidExpressions) {
+  EXPECT_THROW(project(_table_wrapper, {{column(ColumnID{4})}}), std::logic_error);
+  EXPECT_THROW(project(_table_wrapper, {{arithmetic(ArithmeticOperator::Addition, column(ColumnID{2}), value(1))}}),
+               std::logic_error);
+  EXPECT_THROW(project(_table_wrapper, {{comparison(ScanType::OpEquals, column(ColumnID{2}), value(1))}}),
+               std::logic_error);
+  EXPECT_THROW(comparison(ScanType::OpLike, column(ColumnID{2}), value("x%")), std::logic_error);
+  EXPECT_THROW(std::make_shared<CastExpression>(column(ColumnID{2}), "bool"), std::logic_error);
+}
+
+}  // namespace opossum
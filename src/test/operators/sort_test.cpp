@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsSortTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto table = std::make_shared<Table>(3);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    table->add_column("c", "double");
+    table->add_column("d", "long");
+    table->append({3, "y", 1.5, int64_t{-7}});
+    table->append({-1, "x", -2.5, int64_t{100}});
+    table->append({3, "x", 0.0, int64_t{-100}});
+    table->append({7, "z", -0.5, int64_t{5}});
+    table->append({-1, "y", 8.0, int64_t{0}});
+    table->append({0, "x", -2.5, int64_t{-7}});
+    table->append({3, "y", 1.0, int64_t{1}});
+    table->compress_chunk(ChunkID{1});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  // returns the values of the column in the order of the table
+  static std::vector<AllTypeVariant> column_values(const Table& table, const ColumnID column_id) {
+    std::vector<AllTypeVariant> values;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        values.push_back((*chunk.get_segment(column_id))[chunk_offset]);
+      }
+    }
+    return values;
+  }
+
+  static std::shared_ptr<const Table> sort(
+      const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+      const Sort::ForceMaterialization force_materialization = Sort::ForceMaterialization::No,
+      const size_t memory_limit = Sort::DEFAULT_MEMORY_LIMIT) {
+    auto sort = std::make_shared<Sort>(in, sort_definitions, force_materialization, memory_limit);
+    sort->execute();
+    return sort->get_output();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsSortTest, SortsNumericColumns) {
+  const auto by_a = sort(_table_wrapper, {SortColumnDefinition{ColumnID{0}}});
+  EXPECT_EQ(column_values(*by_a, ColumnID{0}), (std::vector<AllTypeVariant>{-1, -1, 0, 3, 3, 3, 7}));
+  // equal rows keep their order
+  EXPECT_EQ(column_values(*by_a, ColumnID{2}), (std::vector<AllTypeVariant>{-2.5, 8.0, -2.5, 1.5, 0.0, 1.0, -0.5}));
+  EXPECT_EQ(by_a->chunk_count(), 3u);
+
+  const auto by_c = sort(_table_wrapper, {SortColumnDefinition{ColumnID{2}, OrderByMode::Descending}});
+  EXPECT_EQ(column_values(*by_c, ColumnID{2}), (std::vector<AllTypeVariant>{8.0, 1.5, 1.0, 0.0, -0.5, -2.5, -2.5}));
+  EXPECT_EQ(column_values(*by_c, ColumnID{0}), (std::vector<AllTypeVariant>{-1, 3, 3, 3, 7, -1, 0}));
+
+  const auto by_d = sort(_table_wrapper, {SortColumnDefinition{ColumnID{3}}});
+  EXPECT_EQ(column_values(*by_d, ColumnID{3}),
+            (std::vector<AllTypeVariant>{int64_t{-100}, int64_t{-7}, int64_t{-7}, int64_t{0}, int64_t{1}, int64_t{5},
+                                         int64_t{100}}));
+}
+
+TEST_F(OperatorsSortTest, SortsMultipleColumns) {
+  const auto output = sort(_table_wrapper, {SortColumnDefinition{ColumnID{1}, OrderByMode::Descending},
+                                            SortColumnDefinition{ColumnID{0}}, SortColumnDefinition{ColumnID{2}}});
+  EXPECT_EQ(column_values(*output, ColumnID{1}), (std::vector<AllTypeVariant>{"z", "y", "y", "y", "x", "x", "x"}));
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{7, -1, 3, 3, -1, 0, 3}));
+  EXPECT_EQ(column_values(*output, ColumnID{2}), (std::vector<AllTypeVariant>{-0.5, 8.0, 1.0, 1.5, -2.5, -2.5, 0.0}));
+
+  // the output references the input table
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table_wrapper->get_output());
+}
+
+TEST_F(OperatorsSortTest, SortsReferenceTablesAndNulls) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 0);
+  scan->execute();
+  const auto scan_output = sort(scan, {SortColumnDefinition{ColumnID{1}}, SortColumnDefinition{ColumnID{3}}});
+  EXPECT_EQ(column_values(*scan_output, ColumnID{3}),
+            (std::vector<AllTypeVariant>{int64_t{-100}, int64_t{-7}, int64_t{-7}, int64_t{1}, int64_t{5}}));
+
+  auto right_table = std::make_shared<Table>();
+  right_table->add_column("e", "int");
+  right_table->append({3});
+  right_table->append({-1});
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+  auto join =
+      std::make_shared<JoinHash>(_table_wrapper, right, JoinMode::Left, std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+
+  // NULLs are smaller than all other values
+  const auto ascending_output = sort(join, {SortColumnDefinition{ColumnID{4}}});
+  EXPECT_EQ(column_values(*ascending_output, ColumnID{4}),
+            (std::vector<AllTypeVariant>{NULL_VALUE, NULL_VALUE, -1, -1, 3, 3, 3}));
+  const auto descending_output = sort(join, {SortColumnDefinition{ColumnID{4}, OrderByMode::Descending}});
+  EXPECT_EQ(column_values(*descending_output, ColumnID{4}),
+            (std::vector<AllTypeVariant>{3, 3, 3, -1, -1, NULL_VALUE, NULL_VALUE}));
+}
+
+TEST_F(OperatorsSortTest, MaterializesOutput) {
+  const auto output = sort(_table_wrapper, {SortColumnDefinition{ColumnID{3}, OrderByMode::Descending}},
+                           Sort::ForceMaterialization::Yes);
+  const auto segment =
+      std::dynamic_pointer_cast<ValueSegment<std::string>>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{1}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->values(), (std::vector<std::string>{"x", "z", "y"}));
+
+  // NULLs from an outer join cannot be materialized, such an output stays referenced
+  auto right_table = std::make_shared<Table>();
+  right_table->add_column("e", "int");
+  right_table->append({3});
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+  auto join =
+      std::make_shared<JoinHash>(_table_wrapper, right, JoinMode::Left, std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+  const auto null_output = sort(join, {SortColumnDefinition{ColumnID{4}}}, Sort::ForceMaterialization::Yes);
+  EXPECT_EQ(column_values(*null_output, ColumnID{4}),
+            (std::vector<AllTypeVariant>{NULL_VALUE, NULL_VALUE, NULL_VALUE, NULL_VALUE, 3, 3, 3}));
+  EXPECT_TRUE(std::dynamic_pointer_cast<ReferenceSegment>(null_output->get_chunk(ChunkID{0}).get_segment(ColumnID{4})));
+
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+  const auto empty_output = sort(scan, {SortColumnDefinition{ColumnID{0}}});
+  EXPECT_EQ(empty_output->row_count(), 0u);
+  EXPECT_EQ(empty_output->get_chunk(ChunkID{0}).column_count(), 4u);
+}
+
+TEST_F(OperatorsSortTest, SortsLargeInputs) {
+  const auto row_count = int32_t{200'000};
+  auto table = std::make_shared<Table>(50'000);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  std::vector<std::pair<std::string, int32_t>> expected_rows;
+  for (auto row = int32_t{0}; row < row_count; ++row) {
+    const auto a = static_cast<int32_t>(int64_t{row} * 7'919 % 1'000 - 500);
+    const auto b = std::to_string(int64_t{row} * 104'729 % 12'345);
+    table->append({a, b});
+    expected_rows.emplace_back(b, a);
+  }
+  table->compress_chunk(ChunkID{0});
+  table->compress_chunk(ChunkID{2});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  std::stable_sort(expected_rows.begin(), expected_rows.end(),
+                   [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  std::vector<AllTypeVariant> expected_a;
+  std::vector<AllTypeVariant> expected_b;
+  for (const auto& [b, a] : expected_rows) {
+    expected_a.emplace_back(a);
+    expected_b.emplace_back(b);
+  }
+
+  // strings in value segments are merge-sorted
+  const auto output = sort(table_wrapper, {SortColumnDefinition{ColumnID{1}}});
+  EXPECT_EQ(column_values(*output, ColumnID{1}), expected_b);
+  EXPECT_EQ(column_values(*output, ColumnID{0}), expected_a);
+
+  // strings in dictionary segments are radix-sorted by their ranks
+  table->compress_chunk(ChunkID{1});
+  table->compress_chunk(ChunkID{3});
+  const auto dictionary_output = sort(table_wrapper, {SortColumnDefinition{ColumnID{1}}});
+  EXPECT_EQ(column_values(*dictionary_output, ColumnID{1}), expected_b);
+  EXPECT_EQ(column_values(*dictionary_output, ColumnID{0}), expected_a);
+
+  const auto numeric_output = sort(table_wrapper, {SortColumnDefinition{ColumnID{0}, OrderByMode::Descending}});
+  const auto numeric_values = column_values(*numeric_output, ColumnID{0});
+  EXPECT_TRUE(std::is_sorted(numeric_values.crbegin(), numeric_values.crend()));
+}
+
+TEST_F(OperatorsSortTest, SpillsRuns) {
+  const auto sort_definitions = std::vector<SortColumnDefinition>{
+      SortColumnDefinition{ColumnID{1}}, SortColumnDefinition{ColumnID{2}, OrderByMode::Descending}};
+  const auto expected_output = sort(_table_wrapper, sort_definitions);
+
+  // every chunk forms a run of its own
+  const auto spilled_output = sort(_table_wrapper, sort_definitions, Sort::ForceMaterialization::No, 200);
+  for (auto column_id = ColumnID{0}; column_id < 4; ++column_id) {
+    EXPECT_EQ(column_values(*spilled_output, column_id), column_values(*expected_output, column_id));
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,104 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/table_scan/column_vs_value_table_scan_impl.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsColumnVsValueTableScanImplTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(4);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    for (const auto& [a, b] : std::vector<std::pair<int, std::string>>{
+             {5, "apple"}, {3, "banana"}, {5, "apricot"}, {1, "cherry"}, {9, "avocado"}, {3, "date"}}) {
+      _table->append({a, b});
+    }
+
+    // chunk 0 is dictionary-encoded, chunk 1 keeps its value segments
+    _table->compress_chunk(ChunkID{0});
+  }
+
+  PosList scan(const ScanPredicate& predicate, const ChunkID chunk_id,
+               const std::vector<ChunkOffset>* offset_filter = nullptr) {
+    auto matches = PosList{};
+    const auto& chunk = _table->get_chunk(chunk_id);
+    if (predicate.column_id == ColumnID{0}) {
+      ColumnVsValueTableScanImpl<int>{ColumnID{0}, predicate}.scan_chunk(
+          chunk, chunk_id, ChunkOffsetRange{0, chunk.size()}, offset_filter, matches);
+    } else {
+      ColumnVsValueTableScanImpl<std::string>{ColumnID{1}, predicate}.scan_chunk(
+          chunk, chunk_id, ChunkOffsetRange{0, chunk.size()}, offset_filter, matches);
+    }
+    return matches;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(OperatorsColumnVsValueTableScanImplTest, ScansSegmentsOfBothEncodings) {
+  const auto predicate = ScanPredicate{ColumnID{0}, ScanType::OpGreaterThan, 3};
+  EXPECT_EQ(scan(predicate, ChunkID{0}), PosList({RowID{ChunkID{0}, 0}, RowID{ChunkID{0}, 2}}));
+  EXPECT_EQ(scan(predicate, ChunkID{1}), PosList({RowID{ChunkID{1}, 0}}));
+
+  const auto not_equals = ScanPredicate{ColumnID{0}, ScanType::OpNotEquals, 5};
+  EXPECT_EQ(scan(not_equals, ChunkID{0}), PosList({RowID{ChunkID{0}, 1}, RowID{ChunkID{0}, 3}}));
+
+  const auto between = ScanPredicate{ColumnID{0}, ScanType::OpBetween, 2, 5};
+  EXPECT_EQ(scan(between, ChunkID{0}), PosList({RowID{ChunkID{0}, 0}, RowID{ChunkID{0}, 1}, RowID{ChunkID{0}, 2}}));
+  EXPECT_EQ(scan(between, ChunkID{1}), PosList({RowID{ChunkID{1}, 1}}));
+}
+
+TEST_F(OperatorsColumnVsValueTableScanImplTest, ScansOnlyFilteredOffsets) {
+  const auto offset_filter = std::vector<ChunkOffset>{3, 1};
+  const auto predicate = ScanPredicate{ColumnID{0}, ScanType::OpLessThan, 4};
+  EXPECT_EQ(scan(predicate, ChunkID{0}, &offset_filter), PosList({RowID{ChunkID{0}, 3}, RowID{ChunkID{0}, 1}}));
+
+  const auto second_row = std::vector<ChunkOffset>{1};
+  const auto in = ScanPredicate{ColumnID{1}, ScanType::OpIn, AllTypeVariant{}, std::nullopt, {"date", "fig"}};
+  EXPECT_EQ(scan(in, ChunkID{1}, &second_row), PosList({RowID{ChunkID{1}, 1}}));
+}
+
+TEST_F(OperatorsColumnVsValueTableScanImplTest, ScansLikePatterns) {
+  const auto prefix = ScanPredicate{ColumnID{1}, ScanType::OpLike, "ap%"};
+  EXPECT_EQ(scan(prefix, ChunkID{0}), PosList({RowID{ChunkID{0}, 0}, RowID{ChunkID{0}, 2}}));
+
+  const auto general = ScanPredicate{ColumnID{1}, ScanType::OpILike, "%A_O%"};
+  EXPECT_EQ(scan(general, ChunkID{1}), PosList({RowID{ChunkID{1}, 0}}));
+
+  // the pattern is checked once, when the scan is set up
+  EXPECT_THROW((ColumnVsValueTableScanImpl<int>{ColumnID{0}, ScanPredicate{ColumnID{0}, ScanType::OpLike, "1%"}}),
+               std::logic_error);
+}
+
+TEST_F(OperatorsColumnVsValueTableScanImplTest, CountsQualifyingValuesOfDictionaries) {
+  const auto& dictionary_chunk = _table->get_chunk(ChunkID{0});
+  const auto& value_chunk = _table->get_chunk(ChunkID{1});
+
+  // the dictionary of a holds 1, 3 and 5
+  const auto less_than =
+      ColumnVsValueTableScanImpl<int>{ColumnID{0}, ScanPredicate{ColumnID{0}, ScanType::OpLessThan, 5}};
+  EXPECT_EQ(less_than.count_qualifying_values(dictionary_chunk),
+            std::make_optional(std::make_pair(size_t{2}, size_t{3})));
+  EXPECT_EQ(less_than.count_qualifying_values(value_chunk), std::nullopt);
+
+  const auto in = ColumnVsValueTableScanImpl<int>{
+      ColumnID{0}, ScanPredicate{ColumnID{0}, ScanType::OpIn, AllTypeVariant{}, std::nullopt, {1, 2, 5, 5}}};
+  EXPECT_EQ(in.count_qualifying_values(dictionary_chunk), std::make_optional(std::make_pair(size_t{2}, size_t{3})));
+
+  // general LIKE patterns would have to be matched against the whole dictionary, so they are not counted
+  const auto like =
+      ColumnVsValueTableScanImpl<std::string>{ColumnID{1}, ScanPredicate{ColumnID{1}, ScanType::OpLike, "%a%"}};
+  EXPECT_EQ(like.count_qualifying_values(dictionary_chunk), std::nullopt);
+}
+
+}  // namespace opossum
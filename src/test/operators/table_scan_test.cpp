@@ -3,6 +3,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -13,6 +14,8 @@
 #include "operators/print.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/index/bitmap_index.hpp"
+#include "storage/index/cracker_index.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -73,6 +76,31 @@ class OperatorsTableScanTest : public BaseTest {
     return table_wrapper;
   }
 
+  // scans both tables, which have the same rows, and checks that the outputs hold the same rows in the same chunks
+  void EXPECT_SAME_SCAN_RESULT(const std::shared_ptr<TableWrapper>& table_wrapper,
+                               const std::shared_ptr<TableWrapper>& expected_table_wrapper,
+                               const std::vector<ScanPredicate>& predicates) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, predicates);
+    scan->execute();
+    auto expected_scan = std::make_shared<TableScan>(expected_table_wrapper, predicates);
+    expected_scan->execute();
+    const auto& output = *scan->get_output();
+    const auto& expected_output = *expected_scan->get_output();
+    ASSERT_EQ(output.row_count(), expected_output.row_count());
+    ASSERT_EQ(output.chunk_count(), expected_output.chunk_count());
+    for (auto chunk_id = ChunkID{0}; chunk_id < output.chunk_count(); ++chunk_id) {
+      const auto& chunk = output.get_chunk(chunk_id);
+      const auto& expected_chunk = expected_output.get_chunk(chunk_id);
+      ASSERT_EQ(chunk.size(), expected_chunk.size());
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        for (auto column_id = ColumnID{0}; column_id < output.column_count(); ++column_id) {
+          EXPECT_EQ((*chunk.get_segment(column_id))[chunk_offset],
+                    (*expected_chunk.get_segment(column_id))[chunk_offset]);
+        }
+      }
+    }
+  }
+
   void ASSERT_COLUMN_EQ(std::shared_ptr<const Table> table, const ColumnID& column_id,
                         std::vector<AllTypeVariant> expected) {
     for (auto chunk_id = ChunkID{0u}; chunk_id < table->chunk_count(); ++chunk_id) {
@@ -98,6 +126,27 @@ class OperatorsTableScanTest : public BaseTest {
     ASSERT_EQ(expected.size(), 0u);
   }
 
+  std::shared_ptr<TableWrapper> get_table_op_strings(const bool compressed) {
+    auto table = std::make_shared<Table>(3);
+    table->add_column("a", "string");
+    table->add_column("b", "int");
+
+    const auto values = std::vector<std::string>{"apple", "Apricot", "banana", "apple pie", "pineapple", "cherry"};
+    for (auto index = size_t{0}; index < values.size(); ++index) {
+      table->append({values[index], static_cast<int32_t>(index)});
+    }
+
+    if (compressed) {
+      table->compress_chunk(ChunkID(0));
+      table->compress_chunk(ChunkID(1));
+    }
+
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+
+    return table_wrapper;
+  }
+
   std::shared_ptr<TableWrapper> _table_wrapper, _table_wrapper_even_dict;
 };
 
@@ -267,4 +316,461 @@ TEST_F(OperatorsTableScanTest, ScanOnWideDictionarySegment) {
   EXPECT_EQ(scan_2->get_output()->row_count(), static_cast<size_t>(37));
 }
 
+TEST_F(OperatorsTableScanTest, ScanBetween) {
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_filtered.tbl", 2);
+
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpBetween, 1000, 1234);
+  scan->execute();
+
+  EXPECT_TABLE_EQ(scan->get_output(), expected_result);
+}
+
+TEST_F(OperatorsTableScanTest, ScanBetweenOnDictColumn) {
+  std::map<std::pair<int, int>, std::vector<AllTypeVariant>> tests;
+  tests[{4, 8}] = {104, 106, 108};
+  tests[{3, 9}] = {104, 106, 108};
+  tests[{-10, 0}] = {100};
+  tests[{24, 30}] = {124};
+  tests[{-10, 30}] = {100, 102, 104, 106, 108, 110, 112, 114, 116, 118, 120, 122, 124};
+  tests[{5, 5}] = {};
+  tests[{8, 4}] = {};
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<TableScan>(_table_wrapper_even_dict, ColumnID{0}, ScanType::OpBetween,
+                                            test.first.first, test.first.second);
+    scan->execute();
+
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, test.second);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanBetweenRequiresUpperBound) {
+  EXPECT_THROW(std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpBetween, 1000), std::logic_error);
+  EXPECT_THROW(std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpEquals, 1000, 1234),
+               std::logic_error);
+}
+
+TEST_F(OperatorsTableScanTest, ScanMultiplePredicates) {
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_filtered.tbl", 2);
+
+  const auto predicates = std::vector<ScanPredicate>{{ColumnID{0}, ScanType::OpGreaterThanEquals, 1234},
+                                                     {ColumnID{1}, ScanType::OpLessThan, 457.9}};
+  auto scan = std::make_shared<TableScan>(_table_wrapper, predicates);
+  scan->execute();
+
+  EXPECT_TABLE_EQ(scan->get_output(), expected_result);
+}
+
+TEST_F(OperatorsTableScanTest, ScanMultiplePredicatesOnDictColumns) {
+  // predicates are evaluated in the order of their estimated selectivity per chunk, not in the given order
+  const auto predicates = std::vector<ScanPredicate>{{ColumnID{1}, ScanType::OpBetween, 100, 120},
+                                                     {ColumnID{0}, ScanType::OpNotEquals, 6},
+                                                     {ColumnID{0}, ScanType::OpLessThan, 12}};
+  auto scan = std::make_shared<TableScan>(_table_wrapper_even_dict, predicates);
+  scan->execute();
+  ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, {100, 102, 104, 108, 110});
+
+  const auto no_match_predicates = std::vector<ScanPredicate>{{ColumnID{0}, ScanType::OpGreaterThan, 10},
+                                                              {ColumnID{1}, ScanType::OpEquals, 101}};
+  auto no_match_scan = std::make_shared<TableScan>(_table_wrapper_even_dict, no_match_predicates);
+  no_match_scan->execute();
+  EXPECT_EQ(no_match_scan->get_output()->row_count(), 0u);
+}
+
+TEST_F(OperatorsTableScanTest, ScanMultiplePredicatesOnReferencedDictColumns) {
+  auto scan_1 = std::make_shared<TableScan>(_table_wrapper_even_dict, ColumnID{1}, ScanType::OpLessThan, 116);
+  scan_1->execute();
+
+  const auto predicates = std::vector<ScanPredicate>{{ColumnID{0}, ScanType::OpBetween, 2, 12},
+                                                     {ColumnID{1}, ScanType::OpNotEquals, 108}};
+  auto scan_2 = std::make_shared<TableScan>(scan_1, predicates);
+  scan_2->execute();
+
+  ASSERT_COLUMN_EQ(scan_2->get_output(), ColumnID{1}, {102, 104, 106, 110, 112});
+}
+
+TEST_F(OperatorsTableScanTest, ScanIn) {
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_filtered.tbl", 2);
+
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, std::vector<AllTypeVariant>{1234, 99, 1234});
+  scan->execute();
+
+  EXPECT_TABLE_EQ(scan->get_output(), expected_result);
+}
+
+TEST_F(OperatorsTableScanTest, ScanInOnDictColumn) {
+  std::map<std::vector<AllTypeVariant>, std::vector<AllTypeVariant>> tests;
+  tests[{4, 10, 24}] = {104, 110, 124};
+  tests[{4, 5, 7, 4}] = {104};
+  tests[{1, 3, 5}] = {};
+  tests[{}] = {};
+  // a list that covers the whole dictionary of a chunk
+  tests[{0, 2, 4, 6, 8}] = {100, 102, 104, 106, 108};
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<TableScan>(_table_wrapper_even_dict, ColumnID{0}, test.first);
+    scan->execute();
+
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, test.second);
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanInWithLongList) {
+  // more than a few values are probed through a hash set
+  auto in_values = std::vector<AllTypeVariant>{};
+  for (auto value = 1; value <= 1000; value += 3) in_values.emplace_back(value);
+
+  auto table_wrapper = get_table_op_part_dict();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, in_values);
+  scan->execute();
+
+  ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{0}, {1, 4, 7, 10, 13, 16, 19});
+}
+
+TEST_F(OperatorsTableScanTest, ScanInOnReferencedColumn) {
+  auto scan_1 = std::make_shared<TableScan>(_table_wrapper_even_dict, ColumnID{1}, ScanType::OpLessThan, 116);
+  scan_1->execute();
+
+  const auto predicates = std::vector<ScanPredicate>{
+      {ColumnID{0}, ScanType::OpIn, AllTypeVariant{}, std::nullopt, {2, 8, 14, 20}},
+      {ColumnID{1}, ScanType::OpGreaterThan, 100}};
+  auto scan_2 = std::make_shared<TableScan>(scan_1, predicates);
+  scan_2->execute();
+
+  ASSERT_COLUMN_EQ(scan_2->get_output(), ColumnID{1}, {102, 108, 114});
+}
+
+TEST_F(OperatorsTableScanTest, ScanLike) {
+  std::map<std::pair<ScanType, std::string>, std::vector<AllTypeVariant>> tests;
+  tests[{ScanType::OpLike, "ap%"}] = {0, 3};
+  tests[{ScanType::OpILike, "ap%"}] = {0, 1, 3};
+  tests[{ScanType::OpLike, "%apple%"}] = {0, 3, 4};
+  tests[{ScanType::OpLike, "%e"}] = {0, 3, 4};
+  tests[{ScanType::OpLike, "b_n%a"}] = {2};
+  tests[{ScanType::OpILike, "APPLE"}] = {0};
+  tests[{ScanType::OpLike, "%"}] = {0, 1, 2, 3, 4, 5};
+  tests[{ScanType::OpLike, "z%"}] = {};
+
+  for (const auto compressed : {false, true}) {
+    const auto table_wrapper = get_table_op_strings(compressed);
+    for (const auto& test : tests) {
+      auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, test.first.first, test.first.second);
+      scan->execute();
+
+      ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, test.second);
+    }
+  }
+}
+
+TEST_F(OperatorsTableScanTest, ScanLikeOnReferencedColumn) {
+  auto scan_1 = std::make_shared<TableScan>(get_table_op_strings(true), ColumnID{1}, ScanType::OpGreaterThan, 0);
+  scan_1->execute();
+
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{0}, ScanType::OpILike, "%PLE%");
+  scan_2->execute();
+
+  ASSERT_COLUMN_EQ(scan_2->get_output(), ColumnID{1}, {3, 4});
+}
+
+TEST_F(OperatorsTableScanTest, ScanLikeOnNonStringColumn) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpLike, "1%");
+  EXPECT_THROW(scan->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsTableScanTest, ScanSplitsLargeChunksIntoMorsels) {
+  // the first chunk is split into several morsels, the result has to keep the positional order nevertheless
+  const auto row_count = static_cast<int32_t>(TableScan::MORSEL_SIZE) * 3 + 17;
+  auto table = std::make_shared<Table>(row_count - 5);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  for (auto value = int32_t{0}; value < row_count; ++value) {
+    table->append({value % 7, value});
+  }
+  table->compress_chunk(ChunkID{1});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  for (const auto& column_id : {ColumnID{0}, ColumnID{1}}) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, column_id, ScanType::OpGreaterThanEquals, 0);
+    scan->execute();
+
+    const auto output = scan->get_output();
+    ASSERT_EQ(output->chunk_count(), ChunkID{2});
+    EXPECT_EQ(output->row_count(), static_cast<uint64_t>(row_count));
+
+    auto expected_row_id = RowID{ChunkID{0}, ChunkOffset{0}};
+    for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      const auto& reference_segment =
+          std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(chunk_id).get_segment(ColumnID{0}));
+      for (const auto& row_id : *reference_segment->pos_list()) {
+        if (row_id.chunk_id != expected_row_id.chunk_id) expected_row_id = RowID{row_id.chunk_id, ChunkOffset{0}};
+        ASSERT_EQ(row_id, expected_row_id);
+        ++expected_row_id.chunk_offset;
+      }
+    }
+  }
+
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 3);
+  scan->execute();
+  EXPECT_EQ(scan->get_output()->row_count(), static_cast<uint64_t>((row_count + 3) / 7));
+}
+
+TEST_F(OperatorsTableScanTest, ScanMatchingAllRowsOfDictColumn) {
+  // chunk 0 holds 0 to 8, chunk 1 10 to 18 (both dictionary-encoded) and chunk 2 20 to 24
+  auto scan_1 = std::make_shared<TableScan>(_table_wrapper_even_dict, ColumnID{0}, ScanType::OpGreaterThanEquals, 10);
+  scan_1->execute();
+
+  // chunk 0 has no qualifying rows and yields no output chunk
+  const auto output = scan_1->get_output();
+  ASSERT_EQ(output->chunk_count(), ChunkID{2});
+  const auto reference_segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{1}));
+  ASSERT_TRUE(reference_segment->referenced_rows());
+  EXPECT_EQ(reference_segment->referenced_rows()->chunk_id, ChunkID{1});
+  ASSERT_COLUMN_EQ(output, ColumnID{1}, {110, 112, 114, 116, 118, 120, 122, 124});
+
+  // a second scan that all referenced rows satisfy passes on the input segments
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{1}, ScanType::OpLessThan, 200);
+  scan_2->execute();
+  EXPECT_EQ(scan_2->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}),
+            output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+
+  // a scan on the referenced rows that only partially qualify lists the positions again
+  auto scan_3 = std::make_shared<TableScan>(scan_1, ColumnID{0}, ScanType::OpNotEquals, 22);
+  scan_3->execute();
+  ASSERT_COLUMN_EQ(scan_3->get_output(), ColumnID{0}, {10, 12, 14, 16, 18, 20, 24});
+}
+
+TEST_F(OperatorsTableScanTest, ScanKeepsDensePositionsInBitmap) {
+  // chunk 0 is split into two morsels, chunk 1 is dictionary-encoded
+  const auto row_count = static_cast<int32_t>(TableScan::MORSEL_SIZE) + 1000;
+  auto table = std::make_shared<Table>(row_count - 100);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  for (auto value = int32_t{0}; value < row_count; ++value) {
+    table->append({value % 3, value});
+  }
+  table->compress_chunk(ChunkID{1});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // a third of all rows qualifies, which is kept as a bitmap
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 1);
+  scan->execute();
+  const auto output = scan->get_output();
+  ASSERT_EQ(output->chunk_count(), ChunkID{2});
+  EXPECT_EQ(output->row_count(), static_cast<uint64_t>(row_count / 3));
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto reference_segment =
+        std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(chunk_id).get_segment(ColumnID{0}));
+    ASSERT_TRUE(reference_segment->referenced_bitmap());
+    EXPECT_EQ(reference_segment->referenced_bitmap()->chunk_id, chunk_id);
+    EXPECT_EQ((*reference_segment)[5], AllTypeVariant{1});
+    EXPECT_LT(reference_segment->estimate_memory_usage(), reference_segment->size() * sizeof(RowID));
+  }
+  const auto first_segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  EXPECT_EQ(first_segment->pos_list()->at(2), (RowID{ChunkID{0}, 7}));
+
+  // scans on the bitmap read the referenced rows in morsels as well
+  auto scan_2 = std::make_shared<TableScan>(scan, ColumnID{0}, ScanType::OpEquals, 1);
+  scan_2->execute();
+  EXPECT_EQ(scan_2->get_output()->row_count(), static_cast<uint64_t>(row_count / 3));
+  auto scan_3 = std::make_shared<TableScan>(scan, ColumnID{0}, ScanType::OpNotEquals, 1);
+  scan_3->execute();
+  EXPECT_EQ(scan_3->get_output()->row_count(), 0u);
+
+  // sparse results stay PosLists
+  auto sparse_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpLessThan, 100);
+  sparse_scan->execute();
+  const auto sparse_segment = std::dynamic_pointer_cast<ReferenceSegment>(
+      sparse_scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  EXPECT_FALSE(sparse_segment->referenced_bitmap());
+  EXPECT_EQ(sparse_segment->size(), 100u);
+}
+
+TEST_F(OperatorsTableScanTest, ScanCoalescesSparseResults) {
+  // 30 chunks of 100 rows, in each of which 5 rows qualify
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  for (auto value = int32_t{0}; value < 3000; ++value) {
+    table->append({value % 20, value});
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 0);
+  scan->execute();
+  const auto output = scan->get_output();
+  ASSERT_EQ(output->chunk_count(), ChunkID{2});
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).size(), 100u);
+  EXPECT_EQ(output->get_chunk(ChunkID{1}).size(), 50u);
+
+  // the columns share the positions, which span several chunks but are still sorted
+  const auto& first_chunk = output->get_chunk(ChunkID{0});
+  const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(first_chunk.get_segment(ColumnID{0}));
+  EXPECT_EQ(reference_segment->pos_list(),
+            std::dynamic_pointer_cast<ReferenceSegment>(first_chunk.get_segment(ColumnID{1}))->pos_list());
+  EXPECT_FALSE(reference_segment->pos_list()->references_single_chunk());
+  EXPECT_TRUE(reference_segment->pos_list()->is_sorted());
+  EXPECT_EQ(reference_segment->pos_list()->capacity(), 100u);
+  EXPECT_EQ((*first_chunk.get_segment(ColumnID{1}))[99], AllTypeVariant{1980});
+
+  // if nothing qualifies, the result holds a single empty chunk
+  auto empty_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 20);
+  empty_scan->execute();
+  ASSERT_EQ(empty_scan->get_output()->chunk_count(), ChunkID{1});
+  EXPECT_EQ(empty_scan->get_output()->get_chunk(ChunkID{0}).column_count(), 2u);
+  EXPECT_EQ(empty_scan->get_output()->row_count(), 0u);
+}
+
+TEST_F(OperatorsTableScanTest, ScanLooksUpBitmapIndexes) {
+  // two tables with the same rows, of which the second one has BitmapIndexes on both columns of chunks 0 and 1 and
+  // on column a of chunk 2. Chunk 3 is not compressed.
+  const auto make_table = [](const bool indexed) {
+    auto table = std::make_shared<Table>(100);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    for (auto value = int32_t{0}; value < 400; ++value) {
+      table->append({value % 20, std::to_string(value % 7)});
+    }
+    for (auto chunk_id = ChunkID{0}; chunk_id < ChunkID{3}; ++chunk_id) {
+      table->compress_chunk(chunk_id);
+      if (!indexed) continue;
+      table->get_chunk(chunk_id).create_index<BitmapIndex>({ColumnID{0}});
+      if (chunk_id < ChunkID{2}) table->get_chunk(chunk_id).create_index<BitmapIndex>({ColumnID{1}});
+    }
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    return table_wrapper;
+  };
+  const auto table_wrapper = make_table(false);
+  const auto indexed_table_wrapper = make_table(true);
+
+  const auto check_scan = [&](const std::vector<ScanPredicate>& predicates) {
+    EXPECT_SAME_SCAN_RESULT(indexed_table_wrapper, table_wrapper, predicates);
+  };
+
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpEquals, 7}});
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpLessThan, 20}});
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpGreaterThan, 19}});
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpIn, AllTypeVariant{}, std::nullopt, {3, 5, 11, 42}}});
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpBetween, 4, 9},
+              ScanPredicate{ColumnID{1}, ScanType::OpNotEquals, "3"}});
+  check_scan({ScanPredicate{ColumnID{1}, ScanType::OpLike, "%2%"},
+              ScanPredicate{ColumnID{0}, ScanType::OpIn, AllTypeVariant{}, std::nullopt, {2, 9, 16}}});
+
+  // a column comparison cannot be looked up, the chunks are scanned instead
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpGreaterThan, 1},
+              ScanPredicate{ColumnID{0}, ScanType::OpEquals, AllTypeVariant{}, std::nullopt, {}, ColumnID{0}}});
+}
+
+TEST_F(OperatorsTableScanTest, ScanCracksValueSegments) {
+  // two tables with the same rows, of which the second one cracks column a in chunks 0 and 1
+  const auto make_table = [](const bool cracked) {
+    auto table = std::make_shared<Table>(1000);
+    table->add_column("a", "int");
+    table->add_column("b", "int");
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> distribution{0, 999};
+    for (auto row = int32_t{0}; row < 3000; ++row) {
+      table->append({distribution(generator), row});
+    }
+    if (cracked) {
+      table->get_chunk(ChunkID{0}).create_index<CrackerIndex>({ColumnID{0}});
+      table->get_chunk(ChunkID{1}).create_index<CrackerIndex>({ColumnID{0}});
+    }
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    return table_wrapper;
+  };
+  const auto table_wrapper = make_table(false);
+  const auto cracked_table_wrapper = make_table(true);
+  const auto index = std::static_pointer_cast<const CrackerIndex>(
+      cracked_table_wrapper->get_output()->get_chunk(ChunkID{0}).get_index(SegmentIndexType::Cracking, {ColumnID{0}}));
+  ASSERT_TRUE(index);
+  const auto check_scan = [&](const std::vector<ScanPredicate>& predicates) {
+    EXPECT_SAME_SCAN_RESULT(cracked_table_wrapper, table_wrapper, predicates);
+  };
+
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpBetween, 100, 199}});
+  EXPECT_EQ(index->pivot_count(), 2u);
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpLessThan, 150}});
+  EXPECT_EQ(index->pivot_count(), 3u);
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpEquals, 500},
+              ScanPredicate{ColumnID{0}, ScanType::OpGreaterThan, 7}});
+  EXPECT_EQ(index->pivot_count(), 6u);
+
+  // repeated queries do not crack the column further
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpBetween, 100, 199}});
+  EXPECT_EQ(index->pivot_count(), 6u);
+
+  // predicates that the index does not support and predicates on other columns are scanned
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpNotEquals, 500}});
+  check_scan({ScanPredicate{ColumnID{0}, ScanType::OpLessThan, 300},
+              ScanPredicate{ColumnID{1}, ScanType::OpLessThan, 500}});
+  EXPECT_EQ(index->pivot_count(), 6u);
+}
+
+TEST_F(OperatorsTableScanTest, ScanColumnComparison) {
+  const auto make_table = [](const std::vector<ColumnID>& shared_dictionary_column_ids, const bool compressed) {
+    auto table = std::make_shared<Table>(4);
+    table->add_column("a", "int");
+    table->add_column("b", "int");
+    table->add_column("c", "float");
+    table->add_column("d", "string");
+    for (auto row = int32_t{0}; row < 10; ++row) {
+      table->append({row, 9 - row, row * 0.5f, std::to_string(row)});
+    }
+    if (compressed) {
+      for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+        table->compress_chunk(chunk_id, shared_dictionary_column_ids);
+      }
+    }
+
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    return table_wrapper;
+  };
+
+  const auto table_wrappers = {make_table({}, false), make_table({}, true), make_table({ColumnID{0}, ColumnID{1}}, true)};
+  for (const auto& table_wrapper : table_wrappers) {
+    auto scan_less = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, ColumnID{1});
+    scan_less->execute();
+    ASSERT_COLUMN_EQ(scan_less->get_output(), ColumnID{0}, {0, 1, 2, 3, 4});
+
+    auto scan_equals = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, ColumnID{1});
+    scan_equals->execute();
+    EXPECT_EQ(scan_equals->get_output()->row_count(), 0u);
+
+    // int and float columns can be compared with each other
+    auto scan_mixed = std::make_shared<TableScan>(table_wrapper, ColumnID{2}, ScanType::OpGreaterThanEquals,
+                                                  ColumnID{1});
+    scan_mixed->execute();
+    ASSERT_COLUMN_EQ(scan_mixed->get_output(), ColumnID{0}, {6, 7, 8, 9});
+
+    // on reference tables, and together with other predicates
+    auto scan_value = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+    scan_value->execute();
+    auto scan_reference = std::make_shared<TableScan>(scan_value, ColumnID{1}, ScanType::OpGreaterThanEquals,
+                                                      ColumnID{0});
+    scan_reference->execute();
+    ASSERT_COLUMN_EQ(scan_reference->get_output(), ColumnID{0}, {2, 3, 4});
+
+    auto scan_combined = std::make_shared<TableScan>(
+        scan_value, std::vector<ScanPredicate>{
+                        ScanPredicate{ColumnID{0}, ScanType::OpNotEquals, 3},
+                        ScanPredicate{ColumnID{0}, ScanType::OpLessThanEquals, AllTypeVariant{}, std::nullopt, {},
+                                      ColumnID{1}}});
+    scan_combined->execute();
+    ASSERT_COLUMN_EQ(scan_combined->get_output(), ColumnID{0}, {2, 4});
+
+    auto scan_string = std::make_shared<TableScan>(table_wrapper, ColumnID{3}, ScanType::OpEquals, ColumnID{0});
+    EXPECT_THROW(scan_string->execute(), std::logic_error);
+  }
+
+  EXPECT_THROW(TableScan(_table_wrapper, ColumnID{0}, ScanType::OpLike, ColumnID{1}), std::logic_error);
+}
+
 }  // namespace opossum
@@ -0,0 +1,144 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto table = std::make_shared<Table>(3);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    table->add_column("c", "double");
+    table->append({3, "y", 1.5});
+    table->append({-1, "x", -2.5});
+    table->append({3, "x", 0.0});
+    table->append({7, "z", -0.5});
+    table->append({-1, "y", 8.0});
+    table->append({0, "x", -2.5});
+    table->append({3, "y", 1.0});
+    table->compress_chunk(ChunkID{1});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  // returns the rows of the table in the order of the table
+  static std::vector<std::vector<AllTypeVariant>> rows(const Table& table) {
+    std::vector<std::vector<AllTypeVariant>> rows;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        rows.emplace_back();
+        for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+          rows.back().push_back((*chunk.get_segment(column_id))[chunk_offset]);
+        }
+      }
+    }
+    return rows;
+  }
+
+  // checks that the result equals the first k rows that Sort returns
+  static void expect_top_k(const std::shared_ptr<const AbstractOperator>& in,
+                           const std::vector<SortColumnDefinition>& sort_definitions, const size_t k) {
+    auto top_k = std::make_shared<TopK>(in, sort_definitions, k);
+    top_k->execute();
+    auto sort = std::make_shared<Sort>(in, sort_definitions);
+    sort->execute();
+
+    auto expected_rows = rows(*sort->get_output());
+    if (expected_rows.size() > k) expected_rows.resize(k);
+    EXPECT_EQ(rows(*top_k->get_output()), expected_rows);
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsTopKTest, ReturnsFirstRows) {
+  const auto sort_definitions = std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}}};
+  auto top_k = std::make_shared<TopK>(_table_wrapper, sort_definitions, 3);
+  top_k->execute();
+  EXPECT_EQ(rows(*top_k->get_output()),
+            (std::vector<std::vector<AllTypeVariant>>{{-1, "x", -2.5}, {-1, "y", 8.0}, {0, "x", -2.5}}));
+  EXPECT_EQ(top_k->get_output()->chunk_count(), 1u);
+
+  for (auto k = size_t{0}; k <= 8; ++k) {
+    expect_top_k(_table_wrapper, {SortColumnDefinition{ColumnID{0}, OrderByMode::Descending}}, k);
+    expect_top_k(_table_wrapper, {SortColumnDefinition{ColumnID{2}}}, k);
+  }
+}
+
+TEST_F(OperatorsTopKTest, SortsByMultipleColumns) {
+  for (auto k = size_t{1}; k <= 7; ++k) {
+    expect_top_k(_table_wrapper, {SortColumnDefinition{ColumnID{1}}, SortColumnDefinition{ColumnID{0}}}, k);
+    expect_top_k(_table_wrapper,
+                 {SortColumnDefinition{ColumnID{1}, OrderByMode::Descending},
+                  SortColumnDefinition{ColumnID{2}, OrderByMode::Descending}},
+                 k);
+  }
+}
+
+TEST_F(OperatorsTopKTest, HandlesReferenceTablesAndNulls) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpNotEquals, 7);
+  scan->execute();
+  expect_top_k(scan, {SortColumnDefinition{ColumnID{1}, OrderByMode::Descending}}, 2);
+
+  auto right_table = std::make_shared<Table>();
+  right_table->add_column("d", "int");
+  right_table->append({3});
+  right_table->append({-1});
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+  auto join =
+      std::make_shared<JoinHash>(_table_wrapper, right, JoinMode::Left, std::make_pair(ColumnID{0}, ColumnID{0}));
+  join->execute();
+
+  for (auto k = size_t{1}; k <= 7; ++k) {
+    expect_top_k(join, {SortColumnDefinition{ColumnID{3}}, SortColumnDefinition{ColumnID{2}}}, k);
+    expect_top_k(join, {SortColumnDefinition{ColumnID{3}, OrderByMode::Descending}}, k);
+    // NULLs in a later sort column
+    expect_top_k(join, {SortColumnDefinition{ColumnID{1}}, SortColumnDefinition{ColumnID{3}, OrderByMode::Descending},
+                        SortColumnDefinition{ColumnID{2}}},
+                 k);
+    expect_top_k(join, {SortColumnDefinition{ColumnID{1}, OrderByMode::Descending}, SortColumnDefinition{ColumnID{3}}},
+                 k);
+  }
+}
+
+TEST_F(OperatorsTopKTest, SkipsChunks) {
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  for (auto row = int32_t{0}; row < 100'000; ++row) {
+    table->append({static_cast<int32_t>(int64_t{row} * 7'919 % 50'000), std::to_string(row % 1'234)});
+  }
+  // most chunks are dictionary-encoded, so that they are skipped or filtered by their value ids
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    if (chunk_id % 10 != 0) table->compress_chunk(chunk_id);
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  expect_top_k(table_wrapper, {SortColumnDefinition{ColumnID{0}}, SortColumnDefinition{ColumnID{1}}}, 100);
+  expect_top_k(table_wrapper, {SortColumnDefinition{ColumnID{0}, OrderByMode::Descending}}, 1'000);
+  expect_top_k(table_wrapper, {SortColumnDefinition{ColumnID{1}, OrderByMode::Descending}}, 50);
+}
+
+TEST_F(OperatorsTopKTest, RejectsInvalidSortColumns) {
+  EXPECT_THROW(expect_top_k(_table_wrapper, {}, 1), std::logic_error);
+  EXPECT_THROW(expect_top_k(_table_wrapper, {SortColumnDefinition{ColumnID{3}}}, 1), std::logic_error);
+}
+
+}  // namespace opossum
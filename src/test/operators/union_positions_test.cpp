@@ -0,0 +1,112 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/union_positions.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsUnionPositionsTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto table = std::make_shared<Table>(4);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    for (auto value = 0; value < 10; ++value) {
+      table->append({value, std::to_string(value % 3)});
+    }
+    table->compress_chunk(ChunkID{1});
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<TableScan> scan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
+                                  const ScanType scan_type, const AllTypeVariant& value) {
+    auto table_scan = std::make_shared<TableScan>(in, column_id, scan_type, value);
+    table_scan->execute();
+    return table_scan;
+  }
+
+  std::shared_ptr<const Table> union_positions(const std::shared_ptr<const AbstractOperator>& left,
+                                               const std::shared_ptr<const AbstractOperator>& right) {
+    auto union_positions = std::make_shared<UnionPositions>(left, right);
+    union_positions->execute();
+    return union_positions->get_output();
+  }
+
+  // returns the values of the column in the order of the table
+  static std::vector<AllTypeVariant> column_values(const Table& table, const ColumnID column_id) {
+    std::vector<AllTypeVariant> values;
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& chunk = table.get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        values.push_back((*chunk.get_segment(column_id))[chunk_offset]);
+      }
+    }
+    return values;
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsUnionPositionsTest, UnitesScans) {
+  // a < 3 OR b = '0'
+  const auto output = union_positions(scan(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 3),
+                                      scan(_table_wrapper, ColumnID{1}, ScanType::OpEquals, "0"));
+  EXPECT_EQ(output->column_names(), (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{0, 1, 2, 3, 6, 9}));
+  EXPECT_EQ(column_values(*output, ColumnID{1}), (std::vector<AllTypeVariant>{"0", "1", "2", "0", "0", "0"}));
+
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0}).get_segment(ColumnID{1}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table_wrapper->get_output());
+  EXPECT_TRUE(segment->referenced_bitmap());
+}
+
+TEST_F(OperatorsUnionPositionsTest, DeduplicatesUnsortedPositions) {
+  // the output of the sort references all rows in descending order, each of them twice after the union with itself
+  auto sort = std::make_shared<Sort>(_table_wrapper, std::vector<SortColumnDefinition>{
+                                                         SortColumnDefinition{ColumnID{0}, OrderByMode::Descending}});
+  sort->execute();
+  const auto sorted_scan = scan(sort, ColumnID{0}, ScanType::OpGreaterThanEquals, 5);
+  const auto output = union_positions(sorted_scan, sorted_scan);
+  EXPECT_EQ(column_values(*output, ColumnID{0}), (std::vector<AllTypeVariant>{5, 6, 7, 8, 9}));
+
+  const auto all_rows = union_positions(sort, scan(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 7));
+  EXPECT_EQ(column_values(*all_rows, ColumnID{0}), (std::vector<AllTypeVariant>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  EXPECT_EQ(all_rows->chunk_count(), 3u);
+}
+
+TEST_F(OperatorsUnionPositionsTest, ReturnsEmptyTable) {
+  const auto output = union_positions(scan(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 0),
+                                      scan(_table_wrapper, ColumnID{1}, ScanType::OpEquals, "3"));
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->chunk_count(), 1u);
+  EXPECT_EQ(output->column_count(), 2u);
+}
+
+TEST_F(OperatorsUnionPositionsTest, RejectsInputsOnDifferentTables) {
+  auto other_table = std::make_shared<Table>();
+  other_table->add_column("a", "int");
+  other_table->add_column("b", "string");
+  other_table->append({1, "1"});
+  auto other_table_wrapper = std::make_shared<TableWrapper>(other_table);
+  other_table_wrapper->execute();
+
+  const auto scan_on_table = scan(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 3);
+  EXPECT_THROW(union_positions(scan_on_table, scan(other_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 3)),
+               std::logic_error);
+  EXPECT_THROW(union_positions(scan_on_table, _table_wrapper), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,53 @@
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "scheduler/thread_pool.hpp"
+
+namespace opossum {
+
+class ThreadPoolTest : public BaseTest {};
+
+TEST_F(ThreadPoolTest, ExecutesAllJobs) {
+  auto results = std::vector<int>(1000, 0);
+  auto jobs = std::vector<std::function<void()>>{};
+  for (auto index = size_t{0}; index < results.size(); ++index) {
+    jobs.emplace_back([&results, index]() { results[index] = static_cast<int>(index) * 2; });
+  }
+
+  ThreadPool::get().execute_and_wait(jobs);
+
+  for (auto index = size_t{0}; index < results.size(); ++index) {
+    EXPECT_EQ(results[index], static_cast<int>(index) * 2);
+  }
+}
+
+TEST_F(ThreadPoolTest, NestedBatches) {
+  // jobs that wait for their own batches must not block the pool
+  auto counter = std::atomic<size_t>{0};
+  auto outer_jobs = std::vector<std::function<void()>>{};
+  for (auto outer_index = 0; outer_index < 16; ++outer_index) {
+    outer_jobs.emplace_back([&counter]() {
+      auto inner_jobs = std::vector<std::function<void()>>(16, [&counter]() { ++counter; });
+      ThreadPool::get().execute_and_wait(inner_jobs);
+    });
+  }
+
+  ThreadPool::get().execute_and_wait(outer_jobs);
+  EXPECT_EQ(counter, 16u * 16u);
+}
+
+TEST_F(ThreadPoolTest, RethrowsExceptions) {
+  auto counter = std::atomic<size_t>{0};
+  auto jobs = std::vector<std::function<void()>>(8, [&counter]() { ++counter; });
+  jobs.emplace_back([]() { throw std::logic_error("job failed"); });
+
+  EXPECT_THROW(ThreadPool::get().execute_and_wait(jobs), std::logic_error);
+  EXPECT_EQ(counter, 8u);
+}
+
+}  // namespace opossum
@@ -6,6 +6,8 @@
 #include "../lib/resolve_type.hpp"
 #include "../lib/storage/base_segment.hpp"
 #include "../lib/storage/chunk.hpp"
+#include "../lib/storage/index/cracker_index.hpp"
+#include "../lib/storage/index/sorted_index.hpp"
 #include "../lib/types.hpp"
 
 namespace opossum {
@@ -58,6 +60,35 @@ TEST_F(StorageChunkTest, RetrieveSegment) {
   EXPECT_EQ(base_segment->size(), 4u);
 }
 
+TEST_F(StorageChunkTest, ManagesIndexes) {
+  c.add_segment(int_value_segment);
+  c.add_segment(string_value_segment);
+  const auto segment_memory_usage = c.estimate_memory_usage();
+
+  const auto index = c.create_index<SortedIndex>({ColumnID{0}, ColumnID{1}});
+  EXPECT_EQ(c.get_indexes({ColumnID{0}}), (std::vector<std::shared_ptr<const BaseIndex>>{index}));
+  EXPECT_TRUE(c.get_indexes({ColumnID{1}}).empty());
+  EXPECT_EQ(c.get_index(SegmentIndexType::Sorted, {ColumnID{0}, ColumnID{1}}), index);
+  EXPECT_FALSE(c.get_index(SegmentIndexType::Sorted, {ColumnID{0}}));
+  EXPECT_EQ(c.estimate_memory_usage(), segment_memory_usage + index->estimate_memory_usage());
+
+  c.remove_index(index);
+  EXPECT_TRUE(c.get_indexes({ColumnID{0}}).empty());
+  EXPECT_EQ(c.estimate_memory_usage(), segment_memory_usage);
+}
+
+TEST_F(StorageChunkTest, RejectsAppendsToIndexedChunk) {
+  c.add_segment(int_value_segment);
+  c.add_segment(string_value_segment);
+  const auto index = c.create_index<CrackerIndex>({ColumnID{0}});
+  EXPECT_THROW(c.append({2, "two"}), std::logic_error);
+  EXPECT_EQ(c.size(), 3u);
+
+  c.remove_index(index);
+  c.append({2, "two"});
+  EXPECT_EQ(c.size(), 4u);
+}
+
 TEST_F(StorageChunkTest, UnknownSegmentType) {
   // Exception will only be thrown in debug builds
   if (IS_DEBUG) {
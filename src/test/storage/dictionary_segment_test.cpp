@@ -1,5 +1,6 @@
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -110,4 +111,73 @@ TEST_F(StorageDictionarySegmentTest, LowerUpperBound) {
   EXPECT_EQ(dict_col->upper_bound(15), opossum::INVALID_VALUE_ID);
 }
 
+TEST_F(StorageDictionarySegmentTest, ValueIdRange) {
+  for (int i = 0; i <= 10; i += 2) vc_int->append(i);
+  auto col = opossum::make_shared_by_data_type<opossum::BaseSegment, opossum::DictionarySegment>("int", vc_int);
+  auto dict_col = std::dynamic_pointer_cast<opossum::DictionarySegment<int>>(col);
+
+  EXPECT_EQ(dict_col->value_id_range(4, 8), std::make_pair(opossum::ValueID{2}, opossum::ValueID{5}));
+  EXPECT_EQ(dict_col->value_id_range(3, 9), std::make_pair(opossum::ValueID{2}, opossum::ValueID{5}));
+  EXPECT_EQ(dict_col->value_id_range(-5, 20), std::make_pair(opossum::ValueID{0}, opossum::ValueID{6}));
+
+  // empty ranges
+  const auto [begin_1, end_1] = dict_col->value_id_range(5, 5);
+  EXPECT_EQ(begin_1, end_1);
+  const auto [begin_2, end_2] = dict_col->value_id_range(12, 20);
+  EXPECT_EQ(begin_2, end_2);
+  const auto [begin_3, end_3] = dict_col->value_id_range(8, 4);
+  EXPECT_EQ(begin_3, end_3);
+}
+
+TEST_F(StorageDictionarySegmentTest, SharedDictionary) {
+  for (int i = 0; i <= 10; i += 2) vc_int->append(i);
+  auto other_vc_int = std::make_shared<opossum::ValueSegment<int>>();
+  for (int i = 0; i <= 10; i += 5) other_vc_int->append(i);
+
+  const auto dictionary = opossum::DictionarySegment<int>::build_shared_dictionary({vc_int, other_vc_int});
+  EXPECT_EQ(*dictionary, std::vector<int>({0, 2, 4, 5, 6, 8, 10}));
+
+  const auto dict_col = opossum::DictionarySegment<int>(vc_int, dictionary);
+  const auto other_dict_col = opossum::DictionarySegment<int>(other_vc_int, dictionary);
+  EXPECT_EQ(dict_col.dictionary(), other_dict_col.dictionary());
+  EXPECT_EQ(dict_col.attribute_vector()->get(2), opossum::ValueID{2});
+  EXPECT_EQ(other_dict_col.attribute_vector()->get(1), opossum::ValueID{3});
+  EXPECT_EQ(other_dict_col.get(2), 10);
+
+  // the dictionary is shared by both segments and the local pointer, each segment counts a third of it
+  EXPECT_EQ(dictionary.use_count(), 3);
+  EXPECT_EQ(dict_col.estimate_memory_usage(),
+            dictionary->capacity() * sizeof(int) / 3 + dict_col.attribute_vector()->estimate_memory_usage());
+
+  auto missing_value_vc_int = std::make_shared<opossum::ValueSegment<int>>();
+  missing_value_vc_int->append(3);
+  EXPECT_THROW(opossum::DictionarySegment<int>(missing_value_vc_int, dictionary), std::logic_error);
+}
+
+TEST_F(StorageDictionarySegmentTest, MaterializesAndGathersValues) {
+  // 300 distinct values need 16 bit value ids
+  for (int i = 0; i < 600; ++i) vc_int->append(i % 300);
+  vc_str->append("Bill");
+  vc_str->append("Steve");
+  vc_str->append("Alexander");
+
+  const auto dict_col = opossum::DictionarySegment<int>(vc_int);
+  auto values = std::vector<int>(4);
+  dict_col.materialize(opossum::ChunkOffsetRange{298, 302}, values.data());
+  EXPECT_EQ(values, std::vector<int>({298, 299, 0, 1}));
+
+  auto offsets = std::vector<opossum::ChunkOffset>{};
+  for (auto offset = opossum::ChunkOffset{0}; offset < 600; offset += 7) offsets.push_back(offset);
+  values.resize(offsets.size());
+  dict_col.gather(offsets, values.data());
+  for (auto index = size_t{0}; index < offsets.size(); ++index) {
+    EXPECT_EQ(values[index], static_cast<int>(offsets[index] % 300));
+  }
+
+  const auto dict_str_col = opossum::DictionarySegment<std::string>(vc_str);
+  auto strings = std::vector<std::string>(2);
+  dict_str_col.gather({2, 0}, strings.data());
+  EXPECT_EQ(strings, std::vector<std::string>({"Alexander", "Bill"}));
+}
+
 // TODO(student): You should add some more tests here (full coverage would be appreciated) and possibly in other files.
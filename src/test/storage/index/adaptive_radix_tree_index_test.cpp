@@ -0,0 +1,64 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base_index_test.hpp"
+#include "gtest/gtest.h"
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/index/adaptive_radix_tree_index.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageAdaptiveRadixTreeIndexTest : public BaseIndexTest {};
+
+TEST_F(StorageAdaptiveRadixTreeIndexTest, LooksUpNumbers) {
+  // enough distinct values for all node sizes
+  std::mt19937 generator{17};
+  auto int_values = std::vector<int32_t>{};
+  auto long_values = std::vector<int64_t>{};
+  auto double_values = std::vector<double>{};
+  for (auto row = 0; row < 2000; ++row) {
+    int_values.push_back(std::uniform_int_distribution<int32_t>{-700, 700}(generator));
+    long_values.push_back(std::uniform_int_distribution<int64_t>{-(int64_t{1} << 40), int64_t{1} << 40}(generator));
+    double_values.push_back(std::uniform_real_distribution<double>{-100.0, 100.0}(generator));
+  }
+  double_values[3] = -0.0;
+  double_values[4] = 0.0;
+
+  check_lookups<AdaptiveRadixTreeIndex>(int_values, {-701, -700, -3, 0, 17, int_values[5], 700, 701});
+  check_lookups<AdaptiveRadixTreeIndex>(long_values, {long_values[0], -1, 0, long_values[7], long_values[9]});
+  check_lookups<AdaptiveRadixTreeIndex>(double_values,
+                                        {-100.5, double_values[1], -0.0, 0.0, 0.5, double_values[8]});
+  check_lookups<AdaptiveRadixTreeIndex, float>({2.5f, -1.0f, 2.5f, -3.25f, 0.0f}, {-3.25f, -1.0f, 0.0f, 1.0f, 2.5f});
+}
+
+TEST_F(StorageAdaptiveRadixTreeIndexTest, LooksUpStrings) {
+  const auto values = std::vector<std::string>{"customer#17", "customer#1", "customer#170", "", "custard", "cut",
+                                               "customer#17", "Customer#17", "customer#2", "\xff"};
+  check_lookups<AdaptiveRadixTreeIndex>(values,
+                                        {"", "custom", "customer#1", "customer#17", "customer#171", "cuz", "\xff"});
+
+  auto segment = std::make_shared<ValueSegment<std::string>>();
+  for (const auto& value : values) segment->append(value);
+  const auto index = AdaptiveRadixTreeIndex{{make_shared_by_data_type<BaseSegment, DictionarySegment>(
+      "string", std::static_pointer_cast<BaseSegment>(segment))}};
+  EXPECT_EQ(index.type(), SegmentIndexType::AdaptiveRadixTree);
+  EXPECT_EQ(offsets(index.prefix_lookup("customer#1")), (std::vector<ChunkOffset>{0, 1, 2, 6}));
+  EXPECT_EQ(offsets(index.prefix_lookup("cust")), (std::vector<ChunkOffset>{0, 1, 2, 4, 6, 8}));
+  EXPECT_EQ(offsets(index.prefix_lookup("cu")), (std::vector<ChunkOffset>{0, 1, 2, 4, 5, 6, 8}));
+  EXPECT_EQ(offsets(index.prefix_lookup("customer#170")), (std::vector<ChunkOffset>{2}));
+  EXPECT_EQ(offsets(index.prefix_lookup("customer#3")), (std::vector<ChunkOffset>{}));
+  EXPECT_EQ(offsets(index.prefix_lookup("")), (std::vector<ChunkOffset>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  EXPECT_GT(index.estimate_memory_usage(), values.size() * sizeof(ChunkOffset));
+
+  auto int_segment = std::make_shared<ValueSegment<int>>();
+  int_segment->append(1);
+  EXPECT_THROW(AdaptiveRadixTreeIndex{{int_segment}}.prefix_lookup("1"), std::logic_error);
+}
+
+}  // namespace opossum
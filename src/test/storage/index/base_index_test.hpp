@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../base_test.hpp"
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/position_bitmap.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// the fixture shared by the tests of the segment indexes (see storage/index/)
+class BaseIndexTest : public BaseTest {
+ protected:
+  // a segment of strings with repeated values, also encoded with the dictionary apple, delta, frank, hotel
+  void SetUp() override {
+    auto value_segment = std::make_shared<ValueSegment<std::string>>();
+    for (const auto& value : {"hotel", "delta", "frank", "delta", "apple", "frank", "delta"}) {
+      value_segment->append(value);
+    }
+    _value_segment = value_segment;
+    _dictionary_segment = make_shared_by_data_type<BaseSegment, DictionarySegment>("string", value_segment);
+  }
+
+  // returns the offsets in the bitmap
+  static std::vector<ChunkOffset> offsets(const PositionBitmap& bitmap) {
+    std::vector<ChunkOffset> offsets;
+    bitmap.for_each([&](const ChunkOffset chunk_offset) { offsets.push_back(chunk_offset); });
+    return offsets;
+  }
+
+  // checks the lookups of all scan types for every search value on an Index over a ValueSegment of the values
+  template <typename Index, typename T>
+  static void check_lookups(const std::vector<T>& values, const std::vector<T>& search_values) {
+    auto segment = std::make_shared<ValueSegment<T>>();
+    for (const auto& value : values) segment->append(value);
+    const auto index = Index{{segment}};
+
+    const auto expected_offsets = [&](const auto& predicate) {
+      std::vector<ChunkOffset> offsets;
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+        if (predicate(values[chunk_offset])) offsets.push_back(chunk_offset);
+      }
+      return offsets;
+    };
+    for (const auto& search_value : search_values) {
+      const auto& upper_value = search_values.back();
+      EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {search_value})),
+                expected_offsets([&](const T& value) { return value == search_value; }));
+      EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThan, {search_value})),
+                expected_offsets([&](const T& value) { return value < search_value; }));
+      EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThanEquals, {search_value})),
+                expected_offsets([&](const T& value) { return value <= search_value; }));
+      EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThan, {search_value})),
+                expected_offsets([&](const T& value) { return value > search_value; }));
+      EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThanEquals, {search_value})),
+                expected_offsets([&](const T& value) { return value >= search_value; }));
+      EXPECT_EQ(offsets(index.lookup(ScanType::OpBetween, {search_value}, upper_value)),
+                expected_offsets([&](const T& value) { return search_value <= value && value <= upper_value; }));
+    }
+  }
+
+  std::shared_ptr<const BaseSegment> _value_segment;
+  std::shared_ptr<const BaseSegment> _dictionary_segment;
+};
+
+}  // namespace opossum
@@ -0,0 +1,53 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_index_test.hpp"
+#include "gtest/gtest.h"
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/index/bitmap_index.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageBitmapIndexTest : public BaseIndexTest {};
+
+TEST_F(StorageBitmapIndexTest, LooksUpValues) {
+  const auto index = BitmapIndex{{_dictionary_segment}};
+  EXPECT_EQ(index.type(), SegmentIndexType::Bitmap);
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {"delta"})), (std::vector<ChunkOffset>{1, 3, 6}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {"echo"})), (std::vector<ChunkOffset>{}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThan, {"frank"})), (std::vector<ChunkOffset>{1, 3, 4, 6}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThanEquals, {"a"})), (std::vector<ChunkOffset>{}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThan, {"frank"})), (std::vector<ChunkOffset>{0}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThanEquals, {"echo"})), (std::vector<ChunkOffset>{0, 2, 5}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpBetween, {"b"}, "g")), (std::vector<ChunkOffset>{1, 2, 3, 5, 6}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpBetween, {"g"}, "b")), (std::vector<ChunkOffset>{}));
+}
+
+TEST_F(StorageBitmapIndexTest, LooksUpValueIDs) {
+  // the dictionary is apple, delta, frank, hotel
+  const auto index = BitmapIndex{{_dictionary_segment}};
+  EXPECT_EQ(offsets(index.lookup_value_ids({})), (std::vector<ChunkOffset>{}));
+  EXPECT_EQ(offsets(index.lookup_value_ids({ValueID{3}})), (std::vector<ChunkOffset>{0}));
+  EXPECT_EQ(offsets(index.lookup_value_ids({ValueID{0}, ValueID{2}, ValueID{3}})),
+            (std::vector<ChunkOffset>{0, 2, 4, 5}));
+  EXPECT_GT(index.estimate_memory_usage(), 0u);
+}
+
+TEST_F(StorageBitmapIndexTest, RequiresSingleLowCardinalityDictionarySegment) {
+  EXPECT_THROW((BitmapIndex{{_value_segment}}), std::logic_error);
+  EXPECT_THROW((BitmapIndex{{_dictionary_segment, _dictionary_segment}}), std::logic_error);
+
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  for (auto value = 0; value <= static_cast<int32_t>(BitmapIndex::MAX_DISTINCT_VALUES); ++value) {
+    value_segment->append(value);
+  }
+  const auto dictionary_segment = make_shared_by_data_type<BaseSegment, DictionarySegment>("int", value_segment);
+  EXPECT_THROW((BitmapIndex{{dictionary_segment}}), std::logic_error);
+}
+
+}  // namespace opossum
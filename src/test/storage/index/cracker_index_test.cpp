@@ -0,0 +1,66 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base_index_test.hpp"
+#include "gtest/gtest.h"
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/index/cracker_index.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageCrackerIndexTest : public BaseIndexTest {};
+
+TEST_F(StorageCrackerIndexTest, LooksUpNumbers) {
+  // each lookup of check_lookups cracks the column further
+  std::mt19937 generator{17};
+  std::uniform_int_distribution<int32_t> distribution{-500, 500};
+  std::vector<int32_t> values(2000);
+  for (auto& value : values) value = distribution(generator);
+  std::vector<int32_t> search_values(30);
+  for (auto& value : search_values) value = distribution(generator);
+  search_values.push_back(-1000);
+  search_values.push_back(values[7]);
+  check_lookups<CrackerIndex>(values, search_values);
+
+  check_lookups<CrackerIndex, double>({2.5, -1.0, 0.0, 2.5, 1e10, -3.25}, {0.0, 2.5, -7.0, 3.0, 1e11});
+}
+
+TEST_F(StorageCrackerIndexTest, LooksUpStrings) {
+  check_lookups<CrackerIndex, std::string>({"hotel", "delta", "frank", "delta", "apple", "", "frank", "delta"},
+                                           {"delta", "", "echo", "a", "zulu", "frank"});
+}
+
+TEST_F(StorageCrackerIndexTest, RecordsPivots) {
+  auto segment = std::make_shared<ValueSegment<int32_t>>();
+  for (auto value = int32_t{99}; value >= 0; --value) segment->append(value);
+  const auto index = CrackerIndex{{segment}};
+  EXPECT_EQ(index.type(), SegmentIndexType::Cracking);
+  EXPECT_EQ(index.pivot_count(), 0u);
+
+  // a range is cracked at its lower and upper bound, repeating it only reads the cracked piece
+  EXPECT_EQ(index.lookup(ScanType::OpBetween, {10}, 19).size(), 10u);
+  EXPECT_EQ(index.pivot_count(), 2u);
+  EXPECT_EQ(index.lookup(ScanType::OpBetween, {10}, 19).size(), 10u);
+  EXPECT_EQ(index.pivot_count(), 2u);
+  EXPECT_EQ(index.lookup(ScanType::OpGreaterThanEquals, {10}).size(), 90u);
+  EXPECT_EQ(index.pivot_count(), 2u);
+  EXPECT_EQ(index.lookup(ScanType::OpLessThan, {15}).size(), 15u);
+  EXPECT_EQ(index.pivot_count(), 3u);
+  EXPECT_GT(index.estimate_memory_usage(), 100 * sizeof(int32_t));
+}
+
+TEST_F(StorageCrackerIndexTest, RequiresSingleValueSegment) {
+  auto segment = std::make_shared<ValueSegment<int32_t>>();
+  segment->append(1);
+  const auto dictionary_segment = make_shared_by_data_type<BaseSegment, DictionarySegment>("int", segment);
+  EXPECT_THROW((CrackerIndex{{dictionary_segment}}), std::logic_error);
+  EXPECT_THROW((CrackerIndex{{segment, segment}}), std::logic_error);
+}
+
+}  // namespace opossum
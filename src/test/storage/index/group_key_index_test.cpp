@@ -0,0 +1,39 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_index_test.hpp"
+#include "gtest/gtest.h"
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/index/group_key_index.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageGroupKeyIndexTest : public BaseIndexTest {};
+
+TEST_F(StorageGroupKeyIndexTest, LooksUpValues) {
+  const auto index = GroupKeyIndex{{_dictionary_segment}};
+  EXPECT_EQ(index.type(), SegmentIndexType::GroupKey);
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {"delta"})), (std::vector<ChunkOffset>{1, 3, 6}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {"echo"})), (std::vector<ChunkOffset>{}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThan, {"frank"})), (std::vector<ChunkOffset>{1, 3, 4, 6}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThanEquals, {"a"})), (std::vector<ChunkOffset>{}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThan, {"frank"})), (std::vector<ChunkOffset>{0}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThanEquals, {"echo"})), (std::vector<ChunkOffset>{0, 2, 5}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpBetween, {"b"}, "g")), (std::vector<ChunkOffset>{1, 2, 3, 5, 6}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpBetween, {"g"}, "b")), (std::vector<ChunkOffset>{}));
+
+  // four dictionary entries plus the end of the postings, and one posting per row
+  EXPECT_EQ(index.estimate_memory_usage(), (5 + 7) * sizeof(ChunkOffset));
+}
+
+TEST_F(StorageGroupKeyIndexTest, RequiresSingleDictionarySegment) {
+  EXPECT_THROW((GroupKeyIndex{{_value_segment}}), std::logic_error);
+  EXPECT_THROW((GroupKeyIndex{{_dictionary_segment, _dictionary_segment}}), std::logic_error);
+}
+
+}  // namespace opossum
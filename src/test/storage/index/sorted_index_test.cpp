@@ -0,0 +1,67 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_index_test.hpp"
+#include "gtest/gtest.h"
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/index/sorted_index.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageSortedIndexTest : public BaseIndexTest {
+ protected:
+  void SetUp() override {
+    auto int_segment = std::make_shared<ValueSegment<int>>();
+    auto string_segment = std::make_shared<ValueSegment<std::string>>();
+    const auto values = std::vector<std::pair<int, std::string>>{{5, "b"}, {3, "a"}, {5, "a"}, {1, "c"},
+                                                                 {3, "c"}, {5, "b"}, {8, "a"}};
+    for (const auto& [int_value, string_value] : values) {
+      int_segment->append(int_value);
+      string_segment->append(string_value);
+    }
+    _int_segment = int_segment;
+    _string_segment = make_shared_by_data_type<BaseSegment, DictionarySegment>("string", string_segment);
+  }
+
+  std::shared_ptr<const BaseSegment> _int_segment;
+  std::shared_ptr<const BaseSegment> _string_segment;
+};
+
+TEST_F(StorageSortedIndexTest, LooksUpSingleColumn) {
+  const auto index = SortedIndex{{_int_segment}};
+  EXPECT_EQ(index.type(), SegmentIndexType::Sorted);
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {5})), (std::vector<ChunkOffset>{0, 2, 5}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {4})), (std::vector<ChunkOffset>{}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThan, {5})), (std::vector<ChunkOffset>{1, 3, 4}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThanEquals, {3})), (std::vector<ChunkOffset>{1, 3, 4}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThan, {5})), (std::vector<ChunkOffset>{6}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThanEquals, {5})), (std::vector<ChunkOffset>{0, 2, 5, 6}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpBetween, {2}, 5)), (std::vector<ChunkOffset>{0, 1, 2, 4, 5}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpBetween, {5}, 2)), (std::vector<ChunkOffset>{}));
+  EXPECT_EQ(index.estimate_memory_usage(), 7 * sizeof(ChunkOffset) + 7 * sizeof(int32_t));
+
+  EXPECT_THROW(index.lookup(ScanType::OpNotEquals, {5}), std::logic_error);
+  EXPECT_THROW(index.lookup(ScanType::OpEquals, {5, 3}), std::logic_error);
+  EXPECT_THROW(index.lookup(ScanType::OpBetween, {5}), std::logic_error);
+}
+
+TEST_F(StorageSortedIndexTest, LooksUpMultipleColumns) {
+  const auto index = SortedIndex{{_int_segment, _string_segment}};
+  EXPECT_TRUE(index.is_index_for({_int_segment}));
+  EXPECT_TRUE(index.is_index_for({_int_segment, _string_segment}));
+  EXPECT_FALSE(index.is_index_for({_string_segment}));
+
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {5, "b"})), (std::vector<ChunkOffset>{0, 5}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpEquals, {5})), (std::vector<ChunkOffset>{0, 2, 5}));
+  // a = 5 AND b > 'a', a = 3 AND b < 'c'
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpGreaterThan, {5, "a"})), (std::vector<ChunkOffset>{0, 5}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpLessThan, {3, "c"})), (std::vector<ChunkOffset>{1}));
+  EXPECT_EQ(offsets(index.lookup(ScanType::OpBetween, {5, "a"}, "b")), (std::vector<ChunkOffset>{0, 2, 5}));
+}
+
+}  // namespace opossum
@@ -0,0 +1,92 @@
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/position_bitmap.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StoragePositionBitmapTest : public BaseTest {
+ protected:
+  static std::vector<ChunkOffset> offsets(const PositionBitmap& bitmap, const size_t rank_begin = 0,
+                                          const size_t rank_end = std::numeric_limits<size_t>::max()) {
+    auto result = std::vector<ChunkOffset>{};
+    bitmap.for_each([&](const ChunkOffset chunk_offset) { result.push_back(chunk_offset); }, rank_begin, rank_end);
+    return result;
+  }
+};
+
+TEST_F(StoragePositionBitmapTest, AppendsAndFindsOffsets) {
+  auto bitmap = PositionBitmap{};
+  EXPECT_TRUE(bitmap.empty());
+
+  for (const auto chunk_offset : {3u, 17u, 70'000u, 70'001u}) {
+    bitmap.append(chunk_offset);
+  }
+
+  EXPECT_EQ(bitmap.size(), 4u);
+  EXPECT_TRUE(bitmap.contains(17));
+  EXPECT_TRUE(bitmap.contains(70'001));
+  EXPECT_FALSE(bitmap.contains(4));
+  EXPECT_FALSE(bitmap.contains(65'553));
+  EXPECT_EQ(bitmap.select(0), 3u);
+  EXPECT_EQ(bitmap.select(2), 70'000u);
+  EXPECT_THROW(bitmap.select(4), std::logic_error);
+  EXPECT_EQ(offsets(bitmap), std::vector<ChunkOffset>({3, 17, 70'000, 70'001}));
+  EXPECT_EQ(offsets(bitmap, 1, 3), std::vector<ChunkOffset>({17, 70'000}));
+}
+
+TEST_F(StoragePositionBitmapTest, SwitchesToBitmapContainersForDenseOffsets) {
+  // every other row, the first container exceeds the array limit
+  auto bitmap = PositionBitmap{};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 20'000; chunk_offset += 2) {
+    bitmap.append(chunk_offset);
+  }
+
+  EXPECT_EQ(bitmap.size(), 10'000u);
+  EXPECT_TRUE(bitmap.contains(19'998));
+  EXPECT_FALSE(bitmap.contains(19'999));
+  EXPECT_EQ(bitmap.select(5'000), 10'000u);
+  EXPECT_EQ(offsets(bitmap, 4'999, 5'002), std::vector<ChunkOffset>({9'998, 10'000, 10'002}));
+
+  // a bitmap container takes 8 KiB for up to 2^16 rows, far less than a RowID per qualifying row
+  EXPECT_LT(bitmap.estimate_memory_usage(), 10'000 * sizeof(RowID) / 4);
+}
+
+TEST_F(StoragePositionBitmapTest, IntersectsAndUnites) {
+  auto even = PositionBitmap{};
+  auto multiples_of_three = PositionBitmap{};
+  auto sparse = PositionBitmap{};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 100'000; ++chunk_offset) {
+    if (chunk_offset % 2 == 0) even.append(chunk_offset);
+    if (chunk_offset % 3 == 0) multiples_of_three.append(chunk_offset);
+  }
+  for (const auto chunk_offset : {1u, 6u, 9u, 99'998u}) {
+    sparse.append(chunk_offset);
+  }
+
+  // bitmap and bitmap containers
+  const auto multiples_of_six = even.intersect(multiples_of_three);
+  EXPECT_EQ(multiples_of_six.size(), 16'667u);
+  EXPECT_TRUE(multiples_of_six.contains(99'996));
+  EXPECT_FALSE(multiples_of_six.contains(99'998));
+
+  // array and bitmap containers
+  EXPECT_EQ(offsets(sparse.intersect(even)), std::vector<ChunkOffset>({6, 99'998}));
+  EXPECT_EQ(sparse.unite(even).size(), 50'002u);
+
+  // array and array containers
+  auto other_sparse = PositionBitmap{};
+  for (const auto chunk_offset : {6u, 7u, 99'999u}) {
+    other_sparse.append(chunk_offset);
+  }
+  EXPECT_EQ(offsets(sparse.intersect(other_sparse)), std::vector<ChunkOffset>({6}));
+  EXPECT_EQ(offsets(sparse.unite(other_sparse)), std::vector<ChunkOffset>({1, 6, 7, 9, 99'998, 99'999}));
+  EXPECT_TRUE(sparse.intersect(PositionBitmap{}).empty());
+}
+
+}  // namespace opossum
@@ -6,20 +6,23 @@
 #include <utility>
 #include <vector>
 
+#include "../base_test.hpp"
 #include "gtest/gtest.h"
 
 #include "operators/abstract_operator.hpp"
 #include "operators/get_table.hpp"
 #include "operators/print.hpp"
 #include "operators/table_scan.hpp"
+#include "storage/position_bitmap.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/segment_accessor.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
 
 namespace opossum {
 
-class ReferenceSegmentTest : public ::testing::Test {
+class ReferenceSegmentTest : public BaseTest {
   virtual void SetUp() {
     _test_table = std::make_shared<opossum::Table>(opossum::Table(3));
     _test_table->add_column("a", "int");
@@ -92,4 +95,137 @@ TEST_F(ReferenceSegmentTest, RetrievesValuesFromChunks) {
   EXPECT_EQ(reference_segment[2], column_2[1]);
 }
 
-} // namespace opossum
+TEST_F(ReferenceSegmentTest, MaterializesAndGathersValues) {
+  // chunk 0 of _test_table_dict holds 0 to 8, chunk 1 10 to 18 (both dictionary-encoded), chunk 2 20 to 24
+  auto pos_list = std::make_shared<PosList>(std::initializer_list<RowID>(
+      {RowID{ChunkID{2}, 1}, RowID{ChunkID{0}, 4}, RowID{ChunkID{0}, 0}, RowID{ChunkID{1}, 3}}));
+  const auto pos_list_segment = ReferenceSegment(_test_table_dict, ColumnID{0}, pos_list);
+  auto values = std::vector<int>(4);
+  materialize_values(pos_list_segment, ChunkOffsetRange{0, 4}, values.data());
+  EXPECT_EQ(values, std::vector<int>({22, 8, 0, 16}));
+  values.resize(2);
+  gather_values(pos_list_segment, {3, 1}, values.data());
+  EXPECT_EQ(values, std::vector<int>({16, 8}));
+
+  const auto range_segment = ReferenceSegment(_test_table_dict, ColumnID{1}, ChunkRowRange{ChunkID{1}, {2, 5}});
+  materialize_values(range_segment, ChunkOffsetRange{1, 3}, values.data());
+  EXPECT_EQ(values, std::vector<int>({116, 118}));
+  gather_values(range_segment, {2, 0}, values.data());
+  EXPECT_EQ(values, std::vector<int>({118, 114}));
+
+  auto bitmap = std::make_shared<PositionBitmap>();
+  for (const auto chunk_offset : {0u, 2u}) bitmap->append(chunk_offset);
+  const auto bitmap_segment = ReferenceSegment(_test_table_dict, ColumnID{0}, ChunkRowBitmap{ChunkID{2}, bitmap});
+  materialize_values(bitmap_segment, ChunkOffsetRange{0, 2}, values.data());
+  EXPECT_EQ(values, std::vector<int>({20, 24}));
+  gather_values(bitmap_segment, {1, 0}, values.data());
+  EXPECT_EQ(values, std::vector<int>({24, 20}));
+  // ascending offsets are looked up in a single pass over the bitmap
+  values.resize(3);
+  gather_values(bitmap_segment, {0, 1, 1}, values.data());
+  EXPECT_EQ(values, std::vector<int>({20, 24, 24}));
+  EXPECT_EQ(bitmap_segment[1], AllTypeVariant{24});
+  EXPECT_THROW(bitmap_segment[2], std::logic_error);
+
+  // the requested type has to be that of the referenced column
+  auto floats = std::vector<float>(4);
+  EXPECT_THROW(materialize_values(pos_list_segment, ChunkOffsetRange{0, 4}, floats.data()), std::logic_error);
+}
+
+TEST_F(ReferenceSegmentTest, GroupsPositionsByReferencedChunk) {
+  const auto referenced_chunks = [&](const std::shared_ptr<const PosList>& pos_list) {
+    auto reference_segment = ReferenceSegment(_test_table_dict, ColumnID{0}, pos_list);
+    auto offsets_per_chunk = std::vector<std::pair<ChunkID, std::vector<ChunkOffset>>>{};
+    reference_segment.for_each_referenced_chunk(
+        ChunkOffsetRange{0, static_cast<ChunkOffset>(pos_list->size())}, nullptr,
+        [&](const ChunkID chunk_id, const ChunkOffsetRange&, const std::vector<ChunkOffset>* offset_filter) {
+          offsets_per_chunk.emplace_back(chunk_id, *offset_filter);
+        });
+    return offsets_per_chunk;
+  };
+
+  // positions in chunk 1 only, passed on in their original order
+  auto single_chunk_pos_list = std::make_shared<PosList>(
+      std::initializer_list<RowID>({RowID{ChunkID{1}, 1}, RowID{ChunkID{1}, 0}, RowID{ChunkID{1}, 4}}));
+  single_chunk_pos_list->guarantee_single_chunk();
+  EXPECT_EQ(referenced_chunks(single_chunk_pos_list),
+            (std::vector<std::pair<ChunkID, std::vector<ChunkOffset>>>{{ChunkID{1}, {1, 0, 4}}}));
+
+  auto sorted_pos_list = std::make_shared<PosList>(std::initializer_list<RowID>(
+      {RowID{ChunkID{0}, 4}, RowID{ChunkID{1}, 0}, RowID{ChunkID{1}, 1}, RowID{ChunkID{2}, 2}}));
+  sorted_pos_list->guarantee_sorted();
+  EXPECT_EQ(referenced_chunks(sorted_pos_list), (std::vector<std::pair<ChunkID, std::vector<ChunkOffset>>>{
+                                                    {ChunkID{0}, {4}}, {ChunkID{1}, {0, 1}}, {ChunkID{2}, {2}}}));
+
+  // without guarantees, the positions are regrouped
+  auto unsorted_pos_list = std::make_shared<PosList>(std::initializer_list<RowID>(
+      {RowID{ChunkID{2}, 2}, RowID{ChunkID{0}, 4}, RowID{ChunkID{2}, 0}, RowID{ChunkID{0}, 1}}));
+  EXPECT_EQ(referenced_chunks(unsorted_pos_list),
+            (std::vector<std::pair<ChunkID, std::vector<ChunkOffset>>>{{ChunkID{0}, {4, 1}}, {ChunkID{2}, {2, 0}}}));
+}
+
+TEST_F(ReferenceSegmentTest, TableScanGuaranteesSortedPositions) {
+  auto get_table = std::make_shared<GetTable>("test_table_dict");
+  get_table->execute();
+  auto scan_1 = std::make_shared<TableScan>(get_table, ColumnID{0}, ScanType::OpGreaterThan, 4);
+  scan_1->execute();
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < scan_1->get_output()->chunk_count(); ++chunk_id) {
+    const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(
+        scan_1->get_output()->get_chunk(chunk_id).get_segment(ColumnID{0}));
+    EXPECT_TRUE(reference_segment->pos_list()->references_single_chunk());
+    EXPECT_TRUE(reference_segment->pos_list()->is_sorted());
+  }
+
+  // scans on the result keep the guarantees
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{1}, ScanType::OpLessThan, 120);
+  scan_2->execute();
+  EXPECT_EQ(scan_2->get_output()->row_count(), 7u);
+  const auto reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(
+      scan_2->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  EXPECT_TRUE(reference_segment->pos_list()->references_single_chunk());
+  EXPECT_TRUE(reference_segment->pos_list()->is_sorted());
+}
+
+TEST_F(ReferenceSegmentTest, ReferencesRangeOfRows) {
+  // rows 1 and 2 of chunk 0: 1234, 12345
+  auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, ChunkRowRange{ChunkID{0}, ChunkOffsetRange{1, 3}});
+  ASSERT_TRUE(reference_segment.referenced_rows());
+  EXPECT_EQ(reference_segment.referenced_chunk_id(), ChunkID{0});
+  EXPECT_EQ(reference_segment.size(), 2u);
+  EXPECT_EQ(reference_segment[0], AllTypeVariant{1234});
+  EXPECT_EQ(reference_segment[1], AllTypeVariant{12345});
+  EXPECT_THROW(reference_segment[2], std::logic_error);
+
+  // the range is passed on as a range of the referenced chunk
+  auto call_count = 0;
+  reference_segment.for_each_referenced_chunk(
+      ChunkOffsetRange{1, 2}, nullptr,
+      [&](const ChunkID chunk_id, const ChunkOffsetRange& row_range, const std::vector<ChunkOffset>* offset_filter) {
+        ++call_count;
+        EXPECT_EQ(chunk_id, ChunkID{0});
+        EXPECT_EQ(row_range.begin, 2u);
+        EXPECT_EQ(row_range.end, 3u);
+        EXPECT_EQ(offset_filter, nullptr);
+      });
+  EXPECT_EQ(call_count, 1);
+
+  const auto offsets = std::vector<ChunkOffset>{1, 0};
+  reference_segment.for_each_referenced_chunk(
+      ChunkOffsetRange{}, &offsets,
+      [&](const ChunkID chunk_id, const ChunkOffsetRange&, const std::vector<ChunkOffset>* offset_filter) {
+        ++call_count;
+        EXPECT_EQ(chunk_id, ChunkID{0});
+        ASSERT_NE(offset_filter, nullptr);
+        EXPECT_EQ(*offset_filter, std::vector<ChunkOffset>({2, 1}));
+      });
+  EXPECT_EQ(call_count, 2);
+
+  // the positions are only listed on request
+  const auto pos_list = reference_segment.pos_list();
+  EXPECT_EQ(*pos_list, PosList({RowID{ChunkID{0}, 1}, RowID{ChunkID{0}, 2}}));
+  EXPECT_TRUE(pos_list->references_single_chunk());
+  EXPECT_TRUE(pos_list->is_sorted());
+}
+
+}  // namespace opossum
@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include "../lib/resolve_type.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
 #include "../lib/storage/table.hpp"
 
 namespace opossum {
@@ -71,4 +72,22 @@ TEST_F(StorageTableTest, GetColumnIdByName) {
 
 TEST_F(StorageTableTest, GetChunkSize) { EXPECT_EQ(t.max_chunk_size(), 2u); }
 
+TEST_F(StorageTableTest, CompressChunkWithSharedDictionary) {
+  t.add_column("col_3", "int");
+  t.append({4, "Hello,", 3});
+  t.append({6, "world", 4});
+
+  t.compress_chunk(ChunkID{0}, {ColumnID{0}, ColumnID{2}});
+  const auto& chunk = t.get_chunk(ChunkID{0});
+  const auto segment_1 = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(chunk.get_segment(ColumnID{0}));
+  const auto segment_3 = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(chunk.get_segment(ColumnID{2}));
+  ASSERT_TRUE(segment_1 && segment_3);
+  EXPECT_EQ(segment_1->dictionary(), segment_3->dictionary());
+  EXPECT_EQ(*segment_1->dictionary(), std::vector<int32_t>({3, 4, 6}));
+  EXPECT_EQ((*chunk.get_segment(ColumnID{2}))[1], AllTypeVariant{4});
+
+  t.append({1, "!", 2});
+  EXPECT_THROW(t.compress_chunk(ChunkID{1}, {ColumnID{0}, ColumnID{1}}), std::logic_error);
+}
+
 }  // namespace opossum
@@ -47,6 +47,23 @@ TEST_F(StorageValueSegmentTest, AddValueOfDifferentType) {
   EXPECT_THROW(double_value_segment.append("Hi"), std::exception);
 }
 
+TEST_F(StorageValueSegmentTest, MaterializesAndGathersValues) {
+  for (auto value = 0; value < 100; ++value) int_value_segment.append(value * 10);
+
+  auto values = std::vector<int>(3);
+  int_value_segment.materialize(ChunkOffsetRange{40, 43}, values.data());
+  EXPECT_EQ(values, std::vector<int>({400, 410, 420}));
+
+  // more offsets than the prefetch distance
+  auto offsets = std::vector<ChunkOffset>{};
+  for (auto offset = ChunkOffset{99}; offset > 0; offset -= 3) offsets.push_back(offset);
+  values.resize(offsets.size());
+  int_value_segment.gather(offsets, values.data());
+  for (auto index = size_t{0}; index < offsets.size(); ++index) {
+    EXPECT_EQ(values[index], static_cast<int>(offsets[index]) * 10);
+  }
+}
+
 // TEST_F(StorageValueSegmentTest, MemoryUsage) {
 //   int_value_segment.append(1);
 //   EXPECT_EQ(int_value_segment.estimate_memory_usage(), size_t{4});
@@ -0,0 +1,69 @@
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "utils/like_matcher.hpp"
+
+namespace opossum {
+
+class LikeMatcherTest : public BaseTest {
+ protected:
+  bool match(const std::string& value, const std::string& pattern, const bool case_insensitive = false) {
+    return LikeMatcher{pattern, case_insensitive}.matches(value);
+  }
+};
+
+TEST_F(LikeMatcherTest, Exact) {
+  EXPECT_TRUE(match("hello", "hello"));
+  EXPECT_FALSE(match("hello", "hell"));
+  EXPECT_FALSE(match("Hello", "hello"));
+  EXPECT_TRUE(match("Hello", "hELLo", true));
+  EXPECT_TRUE(match("", ""));
+}
+
+TEST_F(LikeMatcherTest, Prefix) {
+  EXPECT_TRUE(match("hello world", "hello%"));
+  EXPECT_TRUE(match("hello", "hello%"));
+  EXPECT_FALSE(match("hell", "hello%"));
+  EXPECT_FALSE(match("HELLO world", "hello%"));
+  EXPECT_TRUE(match("HELLO world", "hello%", true));
+  EXPECT_TRUE(match("", "%"));
+  EXPECT_TRUE(match("anything", "%%"));
+}
+
+TEST_F(LikeMatcherTest, Suffix) {
+  EXPECT_TRUE(match("hello world", "%world"));
+  EXPECT_FALSE(match("hello world!", "%world"));
+  EXPECT_TRUE(match("hello WORLD", "%world", true));
+}
+
+TEST_F(LikeMatcherTest, Contains) {
+  EXPECT_TRUE(match("hello world", "%lo w%"));
+  EXPECT_TRUE(match("hello world", "%hello world%"));
+  EXPECT_TRUE(match("aaab", "%aab%"));
+  EXPECT_FALSE(match("hello world", "%low%"));
+  EXPECT_FALSE(match("lo", "%lo w%"));
+  EXPECT_TRUE(match("HeLLo World", "%LO W%", true));
+  EXPECT_FALSE(match("HeLLo World", "%LO W%"));
+}
+
+TEST_F(LikeMatcherTest, General) {
+  EXPECT_TRUE(match("hello", "h_llo"));
+  EXPECT_FALSE(match("hllo", "h_llo"));
+  EXPECT_TRUE(match("hello world", "h%o%d"));
+  EXPECT_TRUE(match("hello world", "%o_w%"));
+  EXPECT_FALSE(match("hello world", "h%x%d"));
+  EXPECT_TRUE(match("abcabcabd", "%abc%abd"));
+  EXPECT_TRUE(match("ABC", "a_c", true));
+}
+
+TEST_F(LikeMatcherTest, Prefixes) {
+  EXPECT_EQ(LikeMatcher("abc%", false).prefix(), std::optional<std::string>{"abc"});
+  EXPECT_EQ(LikeMatcher("%", false).prefix(), std::optional<std::string>{""});
+  EXPECT_FALSE(LikeMatcher("abc%", true).prefix());
+  EXPECT_FALSE(LikeMatcher("%abc", false).prefix());
+  EXPECT_FALSE(LikeMatcher("a_c%", false).prefix());
+}
+
+}  // namespace opossum